@@ -46,6 +46,7 @@
 #include "config.h"
 #endif
 
+#include <math.h>
 #include <stdlib.h>
 #include <string.h>
 
@@ -53,6 +54,7 @@
 #include <gst/base/gstbasetransform.h>
 #include <gst/audio/audio.h>
 
+#include "gst/propertymeta.h"
 #include "gst/tempo.h"
 
 #include "plugin.h"
@@ -72,11 +74,14 @@ static GParamSpec *properties[N_PROPERTIES] = { NULL, };
 
 #define PROP(name) properties[PROP_##name]
 
+/* the smallest step of 16 bit audio */
+#define SILENCE_LEVEL (1.0 / 32768.0)
+
 static GstStaticPadTemplate sink_template = GST_STATIC_PAD_TEMPLATE ("sink",
     GST_PAD_SINK,
     GST_PAD_ALWAYS,
     GST_STATIC_CAPS ("audio/x-raw, "
-        "format = (string) " GST_AUDIO_NE (S16) ", "
+        "format = (string) " GST_AUDIO_NE (F32) ", "
         "layout = (string) interleaved, "
         "rate = (int) [ 1, MAX ], " "channels = (int) 1")
     );
@@ -85,7 +90,7 @@ static GstStaticPadTemplate src_template = GST_STATIC_PAD_TEMPLATE ("src",
     GST_PAD_SRC,
     GST_PAD_ALWAYS,
     GST_STATIC_CAPS ("audio/x-raw, "
-        "format = (string) " GST_AUDIO_NE (S16) ", "
+        "format = (string) " GST_AUDIO_NE (F32) ", "
         "layout = (string) interleaved, "
         "rate = (int) [ 1, MAX ], " "channels = (int) 1")
     );
@@ -112,6 +117,7 @@ gstbt_audio_delay_start (GstBaseTransform * base)
   GstBtAudioDelay *self = GSTBT_AUDIO_DELAY (base);
 
   gstbt_delay_start (self->delay, self->samplerate);
+  self->silent_samples = self->delay->max_delaytime;
   return TRUE;
 }
 
@@ -123,21 +129,22 @@ gstbt_audio_delay_transform_ip (GstBaseTransform * base, GstBuffer * outbuf)
   GstMapInfo info;
   GstClockTime timestamp;
   gdouble feedback, dry, wet;
-  gint16 *data;
-  gdouble val_dry, val_fx;
-  glong val, sum_fx = 0;
-  guint i, num_samples, rb_in, rb_out;
+  gfloat *data;
+  gdouble val_dry, val_fx, val;
+  guint i, num_samples, rb_in, rb_out, num_fx = 0;
+  guint silent_samples = self->silent_samples;
 
   if (!gst_buffer_map (outbuf, &info, GST_MAP_READ | GST_MAP_WRITE)) {
     GST_WARNING_OBJECT (base, "unable to map buffer for read & write");
     return GST_FLOW_ERROR;
   }
-  data = (gint16 *) info.data;
-  num_samples = info.size / sizeof (gint16);
+  data = (gfloat *) info.data;
+  num_samples = info.size / sizeof (gfloat);
 
   /* flush ring_buffer on DISCONT */
   if (GST_BUFFER_FLAG_IS_SET (outbuf, GST_BUFFER_FLAG_DISCONT)) {
     gstbt_delay_flush (delay);
+    silent_samples = delay->max_delaytime;
   }
 
   timestamp = gst_segment_to_stream_time (&base->segment, GST_FORMAT_TIME,
@@ -150,31 +157,59 @@ gstbt_audio_delay_transform_ip (GstBaseTransform * base, GstBuffer * outbuf)
   dry = 1.0 - wet;
   GSTBT_DELAY_BEFORE (delay, rb_in, rb_out);
 
+  /* values below SILENCE_LEVEL are dropped from the feedback, so that the
+   * echos die out (and don't turn into denormals) */
   if (G_UNLIKELY (GST_BUFFER_FLAG_IS_SET (outbuf, GST_BUFFER_FLAG_GAP) ||
           gst_base_transform_is_passthrough (base))) {
     /* input is silence */
+    if (silent_samples >= delay->max_delaytime) {
+      /* the ring-buffer is silent too, the tail is over */
+      memset (data, 0, info.size);
+      gst_buffer_unmap (outbuf, &info);
+      GST_BUFFER_FLAG_SET (outbuf, GST_BUFFER_FLAG_GAP);
+      return GST_FLOW_OK;
+    }
     for (i = 0; i < num_samples; i++) {
       GSTBT_DELAY_READ (delay, rb_out, val_fx);
-      val = (glong) (val_fx * feedback);
-      GSTBT_DELAY_WRITE (delay, rb_in, CLAMP (val, G_MININT16, G_MAXINT16));
-      val = (glong) (wet * val_fx);
-      sum_fx += abs (val);
-      *data++ = (gint16) CLAMP (val, G_MININT16, G_MAXINT16);
+      val = val_fx * feedback;
+      if (fabs (val) < SILENCE_LEVEL) {
+        val = 0.0;
+        silent_samples++;
+      } else {
+        silent_samples = 0;
+      }
+      GSTBT_DELAY_WRITE (delay, rb_in, val);
+      val = wet * val_fx;
+      if (fabs (val) >= SILENCE_LEVEL)
+        num_fx++;
+      *data++ = (gfloat) val;
     }
   } else {
     for (i = 0; i < num_samples; i++) {
       GSTBT_DELAY_READ (delay, rb_out, val_fx);
       val_dry = (gdouble) * data;
-      val = (glong) (val_fx * feedback + val_dry);
-      GSTBT_DELAY_WRITE (delay, rb_in, CLAMP (val, G_MININT16, G_MAXINT16));
-      val = (glong) (wet * val_fx + dry * val_dry);
-      sum_fx += abs (val);
-      *data++ = (gint16) CLAMP (val, G_MININT16, G_MAXINT16);
+      val = val_fx * feedback + val_dry;
+      if (fabs (val) < SILENCE_LEVEL) {
+        val = 0.0;
+        silent_samples++;
+      } else {
+        silent_samples = 0;
+      }
+      GSTBT_DELAY_WRITE (delay, rb_in, val);
+      val = wet * val_fx + dry * val_dry;
+      if (fabs (val) >= SILENCE_LEVEL)
+        num_fx++;
+      *data++ = (gfloat) val;
     }
   }
   GSTBT_DELAY_AFTER (delay, rb_in, rb_out);
+  self->silent_samples = MIN (silent_samples, delay->max_delaytime);
 
-  if (GST_BUFFER_FLAG_IS_SET (outbuf, GST_BUFFER_FLAG_GAP) && sum_fx) {
+  /* only report silence if the echos have died out, so that the buffers
+   * still pending in the ring-buffer are not skipped */
+  if (!num_fx && self->silent_samples >= delay->max_delaytime) {
+    GST_BUFFER_FLAG_SET (outbuf, GST_BUFFER_FLAG_GAP);
+  } else {
     GST_BUFFER_FLAG_UNSET (outbuf, GST_BUFFER_FLAG_GAP);
   }
 
@@ -342,6 +377,8 @@ gstbt_audio_delay_class_init (GstBtAudioDelayClass * klass)
       "file://" DATADIR "" G_DIR_SEPARATOR_S "gtk-doc" G_DIR_SEPARATOR_S "html"
       G_DIR_SEPARATOR_S "" PACKAGE "-gst" G_DIR_SEPARATOR_S
       "GstBtAudioDelay.html");
+  gst_element_class_add_metadata (element_class,
+      GSTBT_ELEMENT_METADATA_GAP_AWARE, "true");
 
   // register own properties
   PROP (DRYWET) = g_param_spec_uint ("drywet", "Dry-Wet",
@@ -50,6 +50,8 @@ struct _GstBtAudioDelay {
 
   gint samplerate;
   GstBtDelay *delay;
+  /* number of silent samples written to the ring-buffer in a row */
+  guint silent_samples;
 
   /* tempo handling */
   gulong beats_per_minute;
@@ -224,12 +224,11 @@ gstbt_e_beats_process (GstBtAudioSynth * base, GstBuffer * data,
       env_t, env_n);
 
   if (src->volume && (env_t || env_n)) {
-    gint16 *d1 = (gint16 *) info->data;
+    gfloat *d1 = (gfloat *) info->data;
     guint ct = ((GstBtAudioSynth *) src)->generate_samples_per_buffer;
-    gint16 *d2 = g_new0 (gint16, ct);
-    gint16 *d3 = g_new0 (gint16, ct);
+    gfloat *d2 = g_new0 (gfloat, ct);
+    gfloat *d3 = g_new0 (gfloat, ct);
     guint i;
-    glong mix;
     gdouble v = (1.0 / 3.0) * src->volume;
 
     /* Tonal oscs */
@@ -241,7 +240,7 @@ gstbt_e_beats_process (GstBtAudioSynth * base, GstBuffer * data,
         gstbt_filter_svf_process (src->filter, ct, d1);
       }
     } else {
-      memset (d1, 0, ct * sizeof (gint16));
+      memset (d1, 0, ct * sizeof (gfloat));
     }
     /* Noise osc */
     if (env_n) {
@@ -252,8 +251,7 @@ gstbt_e_beats_process (GstBtAudioSynth * base, GstBuffer * data,
     }
     /* Mix */
     for (i = 0; i < ct; i++) {
-      mix = (glong) (v * ((glong) d1[i] + (glong) d3[i]));
-      d1[i] = (gint16) CLAMP (mix, G_MININT16, G_MAXINT16);
+      d1[i] = (gfloat) (v * (d1[i] + d3[i]));
     }
     if (src->flt_routing == GSTBT_E_BEATS_FILTER_ROUTING_T_N) {
       gstbt_filter_svf_process (src->filter, ct, d1);
@@ -105,7 +105,7 @@ gstbt_sim_syn_process (GstBtAudioSynth * base, GstBuffer * data,
   if ((src->note != GSTBT_NOTE_OFF)
       && gstbt_envelope_is_running ((GstBtEnvelope *) src->volenv,
           src->osc->offset)) {
-    gint16 *d = (gint16 *) info->data;
+    gfloat *d = (gfloat *) info->data;
     guint ct = ((GstBtAudioSynth *) src)->generate_samples_per_buffer;
 
     gstbt_osc_synth_process (src->osc, ct, d);
@@ -77,7 +77,7 @@ gstbt_wave_replay_process (GstBtAudioSynth * base, GstBuffer * data,
   GstBtWaveReplay *src = ((GstBtWaveReplay *) base);
 
   if (src->osc->process) {
-    gint16 *d = (gint16 *) info->data;
+    gfloat *d = (gfloat *) info->data;
     guint ct = ((GstBtAudioSynth *) src)->generate_samples_per_buffer;
     guint64 off = gst_util_uint64_scale_round (GST_BUFFER_TIMESTAMP (data),
         base->info.rate, GST_SECOND);
@@ -91,7 +91,7 @@ gstbt_wave_tab_syn_process (GstBtAudioSynth * base, GstBuffer * data,
 
   if (src->osc->process && src->note != GSTBT_NOTE_OFF &&
       gstbt_envelope_is_running ((GstBtEnvelope *) src->volenv, src->offset)) {
-    gint16 *d = (gint16 *) info->data;
+    gfloat *d = (gfloat *) info->data;
     guint ct = ((GstBtAudioSynth *) src)->generate_samples_per_buffer;
     gint ch = ((GstBtAudioSynth *) src)->info.channels;
     guint sz = src->cycle_size;
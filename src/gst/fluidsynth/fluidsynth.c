@@ -449,7 +449,7 @@ gstbt_fluid_synth_process (GstBtAudioSynth * base, GstBuffer * data,
     }
   }
 
-  fluid_synth_write_s16 (src->fluid,
+  fluid_synth_write_float (src->fluid,
       ((GstBtAudioSynth *) src)->generate_samples_per_buffer,
       info->data, 0, 2, info->data, 1, 2);
 
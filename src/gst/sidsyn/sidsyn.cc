@@ -378,18 +378,22 @@ gstbt_sid_syn_reset (GstBtAudioSynth * base)
   }
 }
 
-// TODO(ensonic): silence detection (gate off + release time is over)
 static gboolean
 gstbt_sid_syn_process (GstBtAudioSynth * base, GstBuffer * data,
     GstMapInfo *info)
 {
   GstBtSidSyn *src = ((GstBtSidSyn *) base);
-  gint16 *out = (gint16 *)info->data;
+  /* the emulator renders 16 bit samples into the 2nd half of the buffer, we
+   * convert them to float in place (front to back) at the end */
+  gfloat *fout = (gfloat *)info->data;
+  gint16 *sout = (gint16 *)&info->data[info->size / 2];
+  gint16 *out = sout;
   gint i, n, m, samples;
   gdouble scale = (gdouble)src->clockrate / (gdouble)base->info.rate;
   gint step = NUM_STEPS * (base->subtick_count - 1);
   gint step_mod = base->subticks_per_beat;
   gint fx_ticks_remain = 0;
+  gint16 nonzero = 0;
 
   for (i = 0; i < NUM_VOICES; i++) {
     GstBtSidSynV *v = src->voices[i];
@@ -438,7 +442,13 @@ gstbt_sid_syn_process (GstBtAudioSynth * base, GstBuffer * data,
       samples = n;
     }
   }
-  return TRUE;
+  for (i = 0; i < (gint) base->generate_samples_per_buffer; i++) {
+    nonzero |= sout[i];
+    fout[i] = (gfloat) sout[i] * (1.0f / 32768.0f);
+  }
+  /* all gates are off and the release is over, once the external filter has
+   * settled the emulator renders pure zeros */
+  return (nonzero != 0);
 }
 
 //-- child proxy interface
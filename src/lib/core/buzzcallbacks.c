@@ -23,9 +23,8 @@
 #include "bml/bml.h"
 
 /*
- * we could use some static hashtables to cache the returned structs
- * if bt_buzz_callbacks_get() is called with a song different from what we have
- * set there, we flush the hash tables
+ * each song gets its own callback bundle, so that the structs we return are
+ * not shared between songs that are loaded at the same time
  */
 
 // structs
@@ -46,13 +45,21 @@ typedef struct
   int LoopEnd;
 } BuzzWaveLevel;
 
+typedef struct
+{
+  CHostCallbacks callbacks;
+  // 200 is WAVE_MAX
+  BuzzWaveInfo wave_info[200];
+  BuzzWaveLevel wave_level[200];
+  BuzzWaveLevel nearest_wave_level[200];
+} BtBuzzCallbacks;
+
 // callbacks
 
 static void const *
 GetWave (CHostCallbacks * self, int const i)
 {
-  // 200 is WAVE_MAX
-  static BuzzWaveInfo res[200] = { {0,}, };
+  BuzzWaveInfo *res = ((BtBuzzCallbacks *) self)->wave_info;
   BtSong *song = BT_SONG (self->user_data);
   BtWavetable *wavetable;
   BtWave *wave;
@@ -100,8 +107,7 @@ GetWave (CHostCallbacks * self, int const i)
 static void const *
 GetWaveLevel (CHostCallbacks * self, int const i, int const level)
 {
-  // 200 is WAVE_MAX
-  static BuzzWaveLevel res[200] = { {0,}, };
+  BuzzWaveLevel *res = ((BtBuzzCallbacks *) self)->wave_level;
   BtSong *song = BT_SONG (self->user_data);
   BtWavetable *wavetable;
   BtWave *wave;
@@ -145,8 +151,7 @@ GetWaveLevel (CHostCallbacks * self, int const i, int const level)
 static void const *
 GetNearestWaveLevel (CHostCallbacks * self, int const i, int const note)
 {
-  // 200 is WAVE_MAX
-  static BuzzWaveLevel res[200] = { {0,}, };
+  BuzzWaveLevel *res = ((BtBuzzCallbacks *) self)->nearest_wave_level;
   BtSong *song = BT_SONG (self->user_data);
   BtWavetable *wavetable;
   BtWave *wave;
@@ -206,7 +211,7 @@ GetNearestWaveLevel (CHostCallbacks * self, int const i, int const note)
 
 // callback bundle
 
-static CHostCallbacks callbacks = {
+static const CHostCallbacks callbacks = {
   /* user-data */
   NULL,
   /* callbacks */
@@ -219,13 +224,22 @@ static CHostCallbacks callbacks = {
  * bt_buzz_callbacks_get:
  * @song: the song for the callback context
  *
- * Store the song in the callback structure and return it.
+ * Get the callback structure for the song. It is created on first use and
+ * freed together with the song.
  *
  * Returns: the callbacks
  */
 gpointer
 bt_buzz_callbacks_get (BtSong * song)
 {
-  callbacks.user_data = (gpointer) song;
-  return &callbacks;
+  GQuark quark = g_quark_from_static_string ("bt-buzz-callbacks");
+  BtBuzzCallbacks *cb = g_object_get_qdata ((GObject *) song, quark);
+
+  if (!cb) {
+    cb = g_new0 (BtBuzzCallbacks, 1);
+    cb->callbacks = callbacks;
+    cb->callbacks.user_data = (gpointer) song;
+    g_object_set_qdata_full ((GObject *) song, quark, cb, g_free);
+  }
+  return &cb->callbacks;
 }
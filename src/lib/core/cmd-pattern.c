@@ -113,8 +113,8 @@ G_DEFINE_TYPE_WITH_CODE (BtCmdPattern, bt_cmd_pattern, G_TYPE_OBJECT,
 GType
 bt_pattern_cmd_get_type (void)
 {
-  static GType type = 0;
-  if (G_UNLIKELY (type == 0)) {
+  static gsize type = 0;
+  if (g_once_init_enter (&type)) {
     static const GEnumValue values[] = {
       {BT_PATTERN_CMD_NORMAL, "BT_PATTERN_CMD_NORMAL", "normal"},
       {BT_PATTERN_CMD_MUTE, "BT_PATTERN_CMD_MUTE", "mute"},
@@ -123,7 +123,8 @@ bt_pattern_cmd_get_type (void)
       {BT_PATTERN_CMD_BREAK, "BT_PATTERN_CMD_BREAK", "break"},
       {0, NULL, NULL},
     };
-    type = g_enum_register_static ("BtPatternCmd", values);
+    g_once_init_leave (&type,
+        g_enum_register_static ("BtPatternCmd", values));
   }
   return type;
 }
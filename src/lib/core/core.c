@@ -196,7 +196,7 @@ bt_init_post (void)
   // see http://www.mail-archive.com/linux-audio-dev@music.columbia.edu/msg19520.html
   //   [linux-audio-dev] Channels and best practice
   // _MM_FLUSH_ZERO_ON = FZ
-  // TODO(ensonic): wikipedia says we must do this for each thread:
+  // this is per thread, the song does it for the streaming threads too:
   // https://en.wikipedia.org/wiki/Denormal_number#Disabling_denormal_floats_at_the_code_level
   _mm_setcsr (_mm_getcsr () | 0x8040);  // set DAZ and FZ bits
 #endif
@@ -228,7 +228,7 @@ bt_init_get_option_group (void)
     {"bt-version", 0, 0, G_OPTION_ARG_NONE, NULL,
         N_("Print the buzztrax core version"), NULL},
     {"bt-core-experiment", 0, 0,
-        G_OPTION_ARG_STRING_ARRAY, NULL, N_("Experiments"), "{audiomixer}"},
+        G_OPTION_ARG_STRING_ARRAY, NULL, N_("Experiments"), "{audiomixer,compiledsong}"},
     {NULL}
   };
   options[0].arg_data = &arg_version;
@@ -89,10 +89,57 @@ BtCmdPattern *bt_machine_get_pattern_by_id(const BtMachine * const self, const g
 
 gpointer bt_wavetable_get_callbacks(BtWavetable * self);
 
+GHashTable *bt_pattern_get_value_groups(const BtPattern * const self);
+
+gboolean bt_song_is_parallel(const BtSong * const self);
+
+GstElement *bt_sink_bin_make_recorder(BtSinkBinRecordFormat format, const gchar * file_name, const GstCaps * caps);
+void bt_sink_bin_configure_encoder(GstElement * encoder);
+gchar *bt_sink_bin_get_format_cache_stamp(void);
+
+gboolean bt_sequence_is_compiled(const BtSequence * const self);
+gboolean bt_sequence_get_scheduled_value(const BtSequence * const self, const BtMachine * const machine, const BtParameterGroup * const param_group, const gulong param, gulong tick, GValue * const value);
+
+//-- cpu load accounting -------------------------------------------------------
+
+#define BT_PERF_DATA_HISTORY 64
+
+/*
+ * BtPerfData:
+ *
+ * Ring-buffer of the recent per buffer processing times of a #BtMachine or a
+ * #BtWire. The ring-buffer is written from the streaming thread and read from
+ * the application, the data is for monitoring only.
+ */
+typedef struct
+{
+  GstClockTime time[BT_PERF_DATA_HISTORY];
+  GstClockTime duration[BT_PERF_DATA_HISTORY];
+  guint pos;
+  /* the thread and its cpu time when the processing of the buffer started */
+  GThread *thread;
+  GstClockTime start;
+  /* thread cpu time spent in other accounted parts since 'start' */
+  GstClockTime accounted;
+} BtPerfData;
+
+void bt_perf_data_init(BtPerfData * self);
+void bt_perf_data_start(BtPerfData * self);
+void bt_perf_data_stop(BtPerfData * self, GstClockTime duration);
+void bt_perf_data_restart(BtPerfData * self, GstClockTime duration);
+guint bt_perf_data_get_load(const BtPerfData * self);
+
+//-- wire ----------------------------------------------------------------------
+
+gboolean bt_wire_update_queue(BtWire * const self);
+
 //-- debug helper --------------------------------------------------------------
 
 GList *bt_machine_get_element_list(const BtMachine * const self);
 void bt_machine_dbg_print_parts(const BtMachine * const self);
+guint64 bt_machine_get_skipped_buffers(const BtMachine * const self);
+
+gulong bt_sequence_dbg_get_index_visits(void);
 
 GList *bt_wire_get_element_list(const BtWire *self);
 void bt_wire_dbg_print_parts(const BtWire *self);
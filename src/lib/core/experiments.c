@@ -43,6 +43,8 @@ bt_experiments_init (gchar ** flags)
     // When updating these, also update core.c:bt_init_get_option_group()
     if (!strcmp (flag, "audiomixer")) {
       active_experiments |= BT_EXPERIMENT_AUDIO_MIXER;
+    } else if (!strcmp (flag, "compiledsong")) {
+      active_experiments |= BT_EXPERIMENT_COMPILED_SONG;
     } else {
       GST_WARNING ("unknown experiment: '%s'", flags[i]);
     }
@@ -21,11 +21,14 @@
 /**
  * BtExperimentFlags:
  * @BT_EXPERIMENT_AUDIO_MIXER: try audiomixer instead of adder
+ * @BT_EXPERIMENT_COMPILED_SONG: precompile the sequence into per machine event
+ *   schedules for playback (see #BtSequence:compiled)
  *
  * Code experiemnts.
  */
 typedef enum {
   BT_EXPERIMENT_AUDIO_MIXER = 1 << 0,
+  BT_EXPERIMENT_COMPILED_SONG = 1 << 1,
 } BtExperimentFlags;
 
 void bt_experiments_init(gchar **flags);
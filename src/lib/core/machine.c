@@ -71,10 +71,6 @@
  *   - export the enum ?
  *   - one function that takes flags, or vararg of enum values
  */
-/* TODO(ensonic): cache the GstControlSource objects?
- * - we look them up a lot, its a linear search in a list, locking and ref/unref
- * - one for each param and again each voice
- */
 /* TODO(ensonic): undo/redo needs to handle controlbindings */
 
 #define BT_CORE
@@ -87,6 +83,7 @@
 #include <gst/base/gstbasesink.h>
 #include <gst/base/gstbasetransform.h>
 #include "gst/childbin.h"
+#include "gst/propertymeta.h"
 #include "gst/tempo.h"
 
 // do sanity check for pattern lifecycle
@@ -127,7 +124,8 @@ enum
   MACHINE_OUTPUT_POST_LEVEL,
   MACHINE_PATTERNS,
   MACHINE_STATE,
-  MACHINE_PRETTY_NAME
+  MACHINE_PRETTY_NAME,
+  MACHINE_CPU_LOAD
 };
 
 // adder, capsfiter, level, volume are gap-aware
@@ -186,9 +184,11 @@ struct _BtMachinePrivate
   /* the current state of the machine */
   BtMachineState state;
 
-  /* parameter groups */
+  /* parameter groups, these also hold the control bindings per param */
   BtParameterGroup *prefs_param_group;
   BtParameterGroup *global_param_group, **voice_param_groups;
+  /* the control binding for the 'state' */
+  GstControlBinding *state_cb;
 
   /* event patterns */
   GList *patterns; // each entry points to BtCmdPattern
@@ -209,6 +209,22 @@ struct _BtMachinePrivate
 
   /* src/sink ghost-pad counters for the machine */
   gint src_pad_counter, sink_pad_counter;
+
+  /* timing stats of the mixer (adder or audiomixer), the intervals are not
+   * counted across flushes */
+  guint64 mixer_buffers, mixer_intervals;
+  GstClockTime mixer_last_push, mixer_total_interval, mixer_max_interval;
+
+  /* the machine element has flagged its last output as silent (GAP) */
+  gboolean machine_idle;
+  guint64 skipped_buffers;
+
+  /* processing time of the machine element */
+  BtPerfData perf;
+
+  /* recorder for the machine output and the spreader pad feeding it */
+  GstElement *stem;
+  GstPad *stem_pad;
 };
 
 typedef enum
@@ -277,6 +293,9 @@ static gchar *sink_pn[] = {
     "sink"  /* tee */
 };
 
+// machines are also created from worker threads (e.g. bt-cmd batch
+// rendering), the lock guards the lazy init of these
+static GMutex factories_lock;
 static GstElementFactory *factories[PART_COUNT];
 // for tee and adder
 static GstPadTemplate *src_pt;
@@ -303,8 +322,8 @@ G_DEFINE_ABSTRACT_TYPE_WITH_CODE(BtMachine, bt_machine, GST_TYPE_BIN,
 
 GType bt_machine_state_get_type(void)
 {
-  static GType type = 0;
-  if (G_UNLIKELY(type == 0))
+  static gsize type = 0;
+  if (g_once_init_enter(&type))
   {
     static const GEnumValue values[] = {
         {BT_MACHINE_STATE_NORMAL, "BT_MACHINE_STATE_NORMAL", "normal"},
@@ -313,7 +332,8 @@ GType bt_machine_state_get_type(void)
         {BT_MACHINE_STATE_BYPASS, "BT_MACHINE_STATE_BYPASS", "bypass"},
         {0, NULL, NULL},
     };
-    type = g_enum_register_static("BtMachineState", values);
+    g_once_init_leave(&type,
+                      g_enum_register_static("BtMachineState", values));
   }
   return type;
 }
@@ -359,13 +379,190 @@ bt_machine_on_tempo_changed(BtSongInfo *const song_info,
   g_object_get(song_info, "tick-duration", &tick_duration, NULL);
   bt_child_proxy_get(self->priv->song, "sequence::length", &seq_length, NULL);
   bt_machine_update_segment_duration(self, tick_duration * seq_length);
+}
+
+#if GST_CHECK_VERSION(1, 18, 0)
+static void
+bt_machine_on_mixer_tempo_changed(BtSongInfo *const song_info,
+                                  const GParamSpec *const arg, gconstpointer const user_data)
+{
+  BtMachine *self = BT_MACHINE(user_data);
+  GValue duration = G_VALUE_INIT;
+  gulong bpm, tpb;
+
+  // one buffer per tick, the fraction avoids rounding the tick to samples
+  g_object_get(song_info, "bpm", &bpm, "tpb", &tpb, NULL);
+  GST_DEBUG_OBJECT(self, "mixer buffer duration: 60/%lu s", bpm * tpb);
+
+  g_value_init(&duration, GST_TYPE_FRACTION);
+  gst_value_set_fraction(&duration, 60, (gint)(bpm * tpb));
+  g_object_set_property(G_OBJECT(self->priv->machines[PART_ADDER]),
+                        "output-buffer-duration-fraction", &duration);
+  g_value_unset(&duration);
+}
+#endif
+
+/*
+ * bt_machine_log_mixer_stats:
+ * @self: the machine
+ *
+ * Log the timing stats of the mixer since the last call and reset them. Called
+ * at the end of each playback, this allows to compare adder and audiomixer on
+ * the same song.
+ */
+static void
+bt_machine_log_mixer_stats(const BtMachine *const self)
+{
+  BtMachinePrivate *const priv = self->priv;
+
+  if (priv->mixer_intervals)
+  {
+    GST_INFO_OBJECT(self, "mixer %s: %" G_GUINT64_FORMAT " buffers, interval "
+                          "avg %" GST_TIME_FORMAT " max %" GST_TIME_FORMAT,
+                    GST_OBJECT_NAME(priv->machines[PART_ADDER]),
+                    priv->mixer_buffers,
+                    GST_TIME_ARGS(priv->mixer_total_interval /
+                                  priv->mixer_intervals),
+                    GST_TIME_ARGS(priv->mixer_max_interval));
+  }
+  priv->mixer_buffers = priv->mixer_intervals = 0;
+  priv->mixer_total_interval = priv->mixer_max_interval = 0;
+  priv->mixer_last_push = GST_CLOCK_TIME_NONE;
+}
+
+static GstPadProbeReturn
+bt_machine_on_mixer_data(GstPad *pad, GstPadProbeInfo *info,
+                         gpointer user_data)
+{
+  const BtMachine *const self = BT_MACHINE(user_data);
+  BtMachinePrivate *const priv = self->priv;
 
-  if (bt_experiments_check_active(BT_EXPERIMENT_AUDIO_MIXER))
+  if (info->type & GST_PAD_PROBE_TYPE_BUFFER)
+  {
+    const GstClockTime now = gst_util_get_timestamp();
+
+    if (GST_CLOCK_TIME_IS_VALID(priv->mixer_last_push))
+    {
+      const GstClockTime interval = now - priv->mixer_last_push;
+
+      priv->mixer_total_interval += interval;
+      priv->mixer_max_interval = MAX(priv->mixer_max_interval, interval);
+      priv->mixer_intervals++;
+    }
+    priv->mixer_last_push = now;
+    priv->mixer_buffers++;
+  }
+  else if (GST_EVENT_TYPE(GST_PAD_PROBE_INFO_EVENT(info)) ==
+           GST_EVENT_FLUSH_STOP)
+  {
+    // don't count the time spent seeking
+    priv->mixer_last_push = GST_CLOCK_TIME_NONE;
+  }
+  else if (GST_EVENT_TYPE(GST_PAD_PROBE_INFO_EVENT(info)) == GST_EVENT_EOS)
   {
-    g_object_set(self->priv->machines[PART_ADDER],
-                 "output-buffer-duration", tick_duration, NULL);
+    bt_machine_log_mixer_stats(self);
   }
+  return GST_PAD_PROBE_OK;
+}
+
+/*
+ * The GAP contract: a machine element flags its output buffer as GAP once it
+ * is silent *and* its tail (reverb, echos, release) is over. Processors that
+ * see such an idle element receive GAP input can be skipped entirely until
+ * the input carries audio again. Other elements may send GAP buffers while
+ * their tail is still audible, hence elements opt in through the
+ * GSTBT_ELEMENT_METADATA_GAP_AWARE metadata.
+ */
+#if GST_CHECK_VERSION(1, 14, 0)
+static GstPadProbeReturn
+bt_machine_on_machine_output(GstPad *pad, GstPadProbeInfo *info,
+                             gpointer user_data)
+{
+  BtMachinePrivate *const priv = BT_MACHINE(user_data)->priv;
+
+  priv->machine_idle = GST_BUFFER_FLAG_IS_SET(GST_PAD_PROBE_INFO_BUFFER(info),
+                                              GST_BUFFER_FLAG_GAP);
+  return GST_PAD_PROBE_OK;
+}
+#endif
+
+static GstPadProbeReturn
+bt_machine_on_perf_start(GstPad *pad, GstPadProbeInfo *info,
+                         gpointer user_data)
+{
+  bt_perf_data_start(&BT_MACHINE(user_data)->priv->perf);
+  return GST_PAD_PROBE_OK;
+}
+
+static GstPadProbeReturn
+bt_machine_on_perf_stop(GstPad *pad, GstPadProbeInfo *info,
+                        gpointer user_data)
+{
+  bt_perf_data_stop(&BT_MACHINE(user_data)->priv->perf,
+                    GST_BUFFER_DURATION(GST_PAD_PROBE_INFO_BUFFER(info)));
+  return GST_PAD_PROBE_OK;
+}
+
+static GstPadProbeReturn
+bt_machine_on_perf_restart(GstPad *pad, GstPadProbeInfo *info,
+                           gpointer user_data)
+{
+  bt_perf_data_restart(&BT_MACHINE(user_data)->priv->perf,
+                       GST_BUFFER_DURATION(GST_PAD_PROBE_INFO_BUFFER(info)));
+  return GST_PAD_PROBE_OK;
+}
+
+#if GST_CHECK_VERSION(1, 14, 0)
+static gboolean
+bt_machine_is_gap_aware(const BtMachine *const self)
+{
+  GstElementFactory *factory =
+      gst_element_get_factory(self->priv->machines[PART_MACHINE]);
+  const gchar *gap_aware;
+
+  if (!factory)
+    return FALSE;
+  gap_aware = gst_element_factory_get_metadata(factory,
+                                               GSTBT_ELEMENT_METADATA_GAP_AWARE);
+  return gap_aware && !strcmp(gap_aware, "true");
+}
+
+static gboolean
+bt_machine_has_same_caps(GstPad *sink_pad, GstPad *src_pad)
+{
+  GstCaps *sink_caps = gst_pad_get_current_caps(sink_pad);
+  GstCaps *src_caps = gst_pad_get_current_caps(src_pad);
+  gboolean res = FALSE;
+
+  if (sink_caps && src_caps)
+    res = gst_caps_is_equal(sink_caps, src_caps);
+  if (sink_caps)
+    gst_caps_unref(sink_caps);
+  if (src_caps)
+    gst_caps_unref(src_caps);
+  return res;
+}
+
+static GstPadProbeReturn
+bt_machine_on_machine_input(GstPad *pad, GstPadProbeInfo *info,
+                            gpointer user_data)
+{
+  BtMachinePrivate *const priv = BT_MACHINE(user_data)->priv;
+  GstBuffer *buf = GST_PAD_PROBE_INFO_BUFFER(info);
+  GstPad *src_pad = priv->src_pads[PART_MACHINE];
+
+  if (!priv->machine_idle || !GST_BUFFER_FLAG_IS_SET(buf, GST_BUFFER_FLAG_GAP))
+    return GST_PAD_PROBE_OK;
+  // we can only forward the buffer if the element does not change the format
+  if (!bt_machine_has_same_caps(pad, src_pad))
+    return GST_PAD_PROBE_OK;
+
+  // skip the element, the silent input buffer is the silent output buffer
+  priv->skipped_buffers++;
+  GST_PAD_PROBE_INFO_FLOW_RETURN(info) = gst_pad_push(src_pad, buf);
+  return GST_PAD_PROBE_HANDLED;
 }
+#endif
 
 //-- helper methods
 
@@ -855,16 +1052,19 @@ bt_machine_make_internal_element(const BtMachine *const self,
   }
   else
   {
+    g_mutex_lock(&factories_lock);
     if (!factories[part])
     {
       // we never unref them, instead we keep them until the end
-      if (!(factories[part] = gst_element_factory_find(factory_name)))
-      {
-        GST_WARNING_OBJECT(self, "failed to lookup factory %s", factory_name);
-        goto Error;
-      }
+      factories[part] = gst_element_factory_find(factory_name);
     }
     f = factories[part];
+    g_mutex_unlock(&factories_lock);
+    if (!f)
+    {
+      GST_WARNING_OBJECT(self, "failed to lookup factory %s", factory_name);
+      goto Error;
+    }
   }
 
   // create internal element
@@ -1162,6 +1362,36 @@ bt_machine_init_core_machine(BtMachine *const self)
            self->priv->plugin_name,
            G_OBJECT_LOG_REF_COUNT(self->priv->machines[PART_MACHINE]));
 
+  if (BT_IS_SOURCE_MACHINE(self) && self->priv->src_pads[PART_MACHINE])
+  {
+    // sources have no input, we account the time between the buffers
+    gst_pad_add_probe(self->priv->src_pads[PART_MACHINE],
+                      GST_PAD_PROBE_TYPE_BUFFER, bt_machine_on_perf_restart,
+                      (gpointer)self, NULL);
+  }
+  if (BT_IS_PROCESSOR_MACHINE(self) && self->priv->src_pads[PART_MACHINE] &&
+      self->priv->sink_pads[PART_MACHINE])
+  {
+    gst_pad_add_probe(self->priv->sink_pads[PART_MACHINE],
+                      GST_PAD_PROBE_TYPE_BUFFER, bt_machine_on_perf_start,
+                      (gpointer)self, NULL);
+    gst_pad_add_probe(self->priv->src_pads[PART_MACHINE],
+                      GST_PAD_PROBE_TYPE_BUFFER, bt_machine_on_perf_stop,
+                      (gpointer)self, NULL);
+#if GST_CHECK_VERSION(1, 14, 0)
+    // track the idle state of the element and skip it on silent input
+    if (bt_machine_is_gap_aware(self))
+    {
+      gst_pad_add_probe(self->priv->src_pads[PART_MACHINE],
+                        GST_PAD_PROBE_TYPE_BUFFER, bt_machine_on_machine_output,
+                        (gpointer)self, NULL);
+      gst_pad_add_probe(self->priv->sink_pads[PART_MACHINE],
+                        GST_PAD_PROBE_TYPE_BUFFER, bt_machine_on_machine_input,
+                        (gpointer)self, NULL);
+    }
+#endif
+  }
+
   res = TRUE;
 Error:
   return res;
@@ -1346,6 +1576,7 @@ bt_machine_init_ctrl_params(BtMachine *const self)
   cb = (GstControlBinding *)bt_cmd_pattern_control_source_new(parent, "mute",
                                                               sequence, song_info, self);
   gst_object_add_control_binding(parent, cb);
+  self->priv->state_cb = gst_object_ref(cb);
 
   g_object_unref(song_info);
   g_object_unref(sequence);
@@ -1764,49 +1995,33 @@ bt_machine_activate_adder(BtMachine *const self)
     }
 
     // create the mixer element
+#if GST_CHECK_VERSION(1, 18, 0)
     if (bt_experiments_check_active(BT_EXPERIMENT_AUDIO_MIXER))
     {
-      GstClockTime tick_duration;
+      BtSongInfo *song_info;
 
-#if GST_CHECK_VERSION(1, 6, 0)
-      GST_FIXME("Using audiomixer, not stable yet");
-#else
-      GST_WARNING("Using audiomixer requires at least gstreamer 1.6.0");
-#endif
-      // Try the new audiomixer
-      /* TODO: request-pad creation requeres audiomixer > 1.6.0
-       * fixed: c1fa51953c7985bf59e45a96da796b08fa02fff4
-       */
-      /* TODO: looping is still broken in audiomixer
-       * https://bugzilla.gnome.org/show_bug.cgi?id=757563
-       */
-      /* TODO: backwards playback is still broken in audiomixer
+      /* The aggregator forwards segment seeks, so looping works. The
+       * sink pads convert the inputs to the negotiated output format, which
+       * replaces the caps property of adder.
+       * TODO: backwards playback is still unsupported in audioaggregator
        */
       if (!(bt_machine_make_internal_element(self, PART_ADDER, "audiomixer",
                                              "audiomixer")))
         goto Error;
-      bt_child_proxy_get(self->priv->song, "song-info::tick-duration",
-                         &tick_duration, NULL);
-      g_object_set(machines[PART_ADDER],
-                   "output-buffer-duration", tick_duration,
-                   // TODO: latency=1 is a workaround to avoid overqueueing
-                   "latency", G_GUINT64_CONSTANT(1), NULL);
-      // before moving audiomixer from gst-plugin-ad the caps property was
-      // dropped in
-      // https://gitlab.freedesktop.org/gstreamer/gst-plugins-bad/-/commit/536cb125773f36ecc46815e72ffa7ae2bba783d7
-      // We'd need to use a dedicated capsfilter (we could plug that always and for adder set the caps twice?
-      // g_object_set (machines[PART_???], "caps", bt_default_caps, NULL);
-
-      // this breanch causes the pad-links to fail:
-      /*
-         10 0x00007ffff7bb6a7d in gst_pad_link_full () at /usr/lib/x86_64-linux-gnu/libgstreamer-1.0.so.0
-         #11 0x00007ffff7f87d6b in link_wire_end
-         (self=self@entry=0x555555dbc920, wire=wire@entry=0x555555f2c410 [GstElement|ebeats_master], peer=0x555555efea20 [GstPad|sink_0], peer@entry=0x0 [GstPad], dir=dir@entry=GST_PAD_SRC) at src/lib/core/setup.c:580
-         #12 0x00007ffff7f87f28 in link_wire (wire=0x555555f2c410 [GstElement|ebeats_master], self=0x555555dbc920)
-         at src/lib/core/setup.c:608
-       */
+      // keep one output buffer per tick, also when the tempo changes
+      g_object_get(self->priv->song, "song-info", &song_info, NULL);
+      bt_machine_on_mixer_tempo_changed(song_info, NULL, (gpointer)self);
+      g_signal_connect_object(song_info, "notify::tick-duration",
+                              G_CALLBACK(bt_machine_on_mixer_tempo_changed), (gpointer)self, 0);
+      g_object_unref(song_info);
     }
     else
+#else
+    if (bt_experiments_check_active(BT_EXPERIMENT_AUDIO_MIXER))
+    {
+      GST_WARNING("Using audiomixer requires at least gstreamer 1.18.0");
+    }
+#endif
     {
       // Use adder
       if (!(bt_machine_make_internal_element(self, PART_ADDER, "adder",
@@ -1814,6 +2029,10 @@ bt_machine_activate_adder(BtMachine *const self)
         goto Error;
       g_object_set(machines[PART_ADDER], "caps", bt_default_caps, NULL);
     }
+    gst_pad_add_probe(src_pads[PART_ADDER],
+                      GST_PAD_PROBE_TYPE_BUFFER | GST_PAD_PROBE_TYPE_EVENT_FLUSH |
+                          GST_PAD_PROBE_TYPE_EVENT_DOWNSTREAM,
+                      bt_machine_on_mixer_data, (gpointer)self, NULL);
 
     if (!BT_IS_SINK_MACHINE(self))
     {
@@ -2020,6 +2239,119 @@ bt_machine_has_active_spreader(const BtMachine *const self)
   return (self->priv->machines[PART_SPREADER] != NULL);
 }
 
+/**
+ * bt_machine_enable_stem:
+ * @self: the machine to record
+ * @format: the format to record in
+ * @file_name: the file to record to
+ *
+ * Record the output of the machine to a separate file while the song plays.
+ * The recorder is fed from the spreader of the machine, after the output gain.
+ * It thus runs in the same pass as the master mix, is sample aligned with it
+ * and only costs the encoding. The stem is converted to the sample rate and
+ * channels of the mix. Call this while the song is stopped.
+ *
+ * Returns: %TRUE for success
+ *
+ * Since: 0.12
+ */
+gboolean
+bt_machine_enable_stem(BtMachine *const self, BtSinkBinRecordFormat format,
+                       const gchar *const file_name)
+{
+  gboolean res = FALSE;
+  GstElement *stem;
+  GstPad *sink_pad;
+  GstCaps *caps;
+  BtSettings *settings;
+  guint sample_rate, channels;
+
+  g_return_val_if_fail(BT_IS_MACHINE(self), FALSE);
+  g_return_val_if_fail(!BT_IS_SINK_MACHINE(self), FALSE);
+  g_return_val_if_fail(BT_IS_STRING(file_name), FALSE);
+
+  bt_machine_disable_stem(self);
+
+  if (!bt_machine_activate_spreader(self))
+    return FALSE;
+
+  // use the format of the mix, so that the files line up
+  settings = bt_settings_make();
+  g_object_get(settings, "sample-rate", &sample_rate, "channels", &channels,
+               NULL);
+  g_object_unref(settings);
+  caps = gst_caps_new_simple("audio/x-raw",
+                             "rate", G_TYPE_INT, (gint)sample_rate,
+                             "channels", G_TYPE_INT, (gint)channels, NULL);
+  stem = bt_sink_bin_make_recorder(format, file_name, caps);
+  gst_caps_unref(caps);
+  if (!stem)
+  {
+    GST_WARNING_OBJECT(self, "failed to create the stem recorder");
+    return FALSE;
+  }
+  gst_bin_add(GST_BIN(self), stem);
+
+  if (!(self->priv->stem_pad =
+            gst_element_get_request_pad(self->priv->machines[PART_SPREADER],
+                                        "src_%u")))
+  {
+    GST_WARNING_OBJECT(self, "failed to request pad 'src_%%u' for the stem");
+    goto Error;
+  }
+  sink_pad = gst_element_get_static_pad(stem, "sink");
+  if (GST_PAD_LINK_FAILED(gst_pad_link(self->priv->stem_pad, sink_pad)))
+  {
+    GST_WARNING_OBJECT(self, "failed to link the stem recorder");
+    gst_object_unref(sink_pad);
+    goto Error;
+  }
+  gst_object_unref(sink_pad);
+  gst_element_sync_state_with_parent(stem);
+
+  self->priv->stem = stem;
+  GST_INFO_OBJECT(self, "recording stem to %s", file_name);
+  res = TRUE;
+Error:
+  if (!res)
+  {
+    if (self->priv->stem_pad)
+    {
+      gst_element_release_request_pad(self->priv->machines[PART_SPREADER],
+                                      self->priv->stem_pad);
+      gst_object_unref(self->priv->stem_pad);
+      self->priv->stem_pad = NULL;
+    }
+    gst_bin_remove(GST_BIN(self), stem);
+  }
+  return res;
+}
+
+/**
+ * bt_machine_disable_stem:
+ * @self: the machine
+ *
+ * Stop recording the output of the machine, see bt_machine_enable_stem().
+ *
+ * Since: 0.12
+ */
+void
+bt_machine_disable_stem(BtMachine *const self)
+{
+  g_return_if_fail(BT_IS_MACHINE(self));
+
+  if (!self->priv->stem)
+    return;
+
+  gst_element_set_state(self->priv->stem, GST_STATE_NULL);
+  gst_element_release_request_pad(self->priv->machines[PART_SPREADER],
+                                  self->priv->stem_pad);
+  gst_object_unref(self->priv->stem_pad);
+  self->priv->stem_pad = NULL;
+  gst_bin_remove(GST_BIN(self), self->priv->stem);
+  self->priv->stem = NULL;
+}
+
 //-- pattern handling
 
 // DEBUG
@@ -2396,14 +2728,11 @@ void bt_machine_update_default_state_value(BtMachine *self)
 {
   g_return_if_fail(BT_IS_MACHINE(self));
 
-  const BtMachinePart part =
-      BT_IS_SINK_MACHINE(self) ? PART_INPUT_GAIN : PART_OUTPUT_GAIN;
-  GstObject *param_parent = (GstObject *)self->priv->machines[part];
   GstControlBinding *cb;
 
   GST_WARNING_OBJECT(self, "set new default for 'state'");
 
-  if ((cb = gst_object_get_control_binding(param_parent, "mute")))
+  if ((cb = self->priv->state_cb))
   {
     GValue def_value = {
         0,
@@ -2443,7 +2772,7 @@ void bt_machine_update_default_param_value(BtMachine *self,
 
   GST_WARNING_OBJECT(self, "set new default for '%s'", property_name);
 
-  if ((cb = gst_object_get_control_binding(param_parent, property_name)))
+  if ((cb = bt_parameter_group_get_param_control_binding(pg, param)))
   {
     bt_parameter_group_set_param_default(pg, param);
     /* TODO(ensonic): it should actualy postpone the enable to the next
@@ -2455,7 +2784,6 @@ void bt_machine_update_default_param_value(BtMachine *self,
      * see gst_object_set_control_binding_disabled() on button_press
      */
     gst_control_binding_set_disabled(cb, FALSE);
-    gst_object_unref(cb);
   }
   else
   {
@@ -2976,6 +3304,13 @@ bt_machine_get_wire_by_dst_machine(const BtMachine *const self,
 
 //-- debug helper
 
+// number of silent buffers that bypassed the idle machine element
+guint64
+bt_machine_get_skipped_buffers(const BtMachine *const self)
+{
+  return self->priv->skipped_buffers;
+}
+
 // used in bt_song_write_to_highlevel_dot_file
 GList *
 bt_machine_get_element_list(const BtMachine *const self)
@@ -3554,24 +3889,28 @@ bt_machine_request_new_pad(GstElement *element, GstPadTemplate *templ,
   BtMachine *const self = BT_MACHINE(element);
   gchar *name;
   GstPad *pad, *target;
+  GstPadTemplate *pt;
 
   // check direction
   if (GST_PAD_TEMPLATE_DIRECTION(templ) == GST_PAD_SRC)
   {
+    g_mutex_lock(&factories_lock);
     if (!src_pt)
     {
       src_pt =
           bt_gst_element_factory_get_pad_template(factories[PART_SPREADER],
                                                   "src_%u");
-      if (!src_pt)
-      {
-        GST_WARNING_OBJECT(element, "failed to pad_template 'src_%%u'");
-        return NULL;
-      }
+    }
+    pt = src_pt;
+    g_mutex_unlock(&factories_lock);
+    if (!pt)
+    {
+      GST_WARNING_OBJECT(element, "failed to pad_template 'src_%%u'");
+      return NULL;
     }
 
     if (!(target = gst_element_request_pad(self->priv->machines[PART_SPREADER],
-                                           src_pt, NULL, NULL)))
+                                           pt, NULL, NULL)))
     {
       GST_WARNING_OBJECT(element, "failed to request pad 'src_%%u'");
       return NULL;
@@ -3581,20 +3920,23 @@ bt_machine_request_new_pad(GstElement *element, GstPadTemplate *templ,
   }
   else
   {
+    g_mutex_lock(&factories_lock);
     if (!sink_pt)
     {
       sink_pt =
           bt_gst_element_factory_get_pad_template(factories[PART_ADDER],
                                                   "sink_%u");
-      if (!sink_pt)
-      {
-        GST_WARNING_OBJECT(element, "failed to pad_template 'sink_%%u'");
-        return NULL;
-      }
+    }
+    pt = sink_pt;
+    g_mutex_unlock(&factories_lock);
+    if (!pt)
+    {
+      GST_WARNING_OBJECT(element, "failed to pad_template 'sink_%%u'");
+      return NULL;
     }
 
     if (!(target = gst_element_request_pad(self->priv->machines[PART_ADDER],
-                                           sink_pt, NULL, NULL)))
+                                           pt, NULL, NULL)))
     {
       GST_WARNING_OBJECT(element, "failed to request pad 'sink_%%u'");
       return NULL;
@@ -3838,6 +4180,9 @@ bt_machine_get_property(GObject *const object, const guint property_id,
     }
     break;
   }
+  case MACHINE_CPU_LOAD:
+    g_value_set_uint(value, bt_perf_data_get_load(&self->priv->perf));
+    break;
   default:
     G_OBJECT_WARN_INVALID_PROPERTY_ID(object, property_id, pspec);
     break;
@@ -3932,7 +4277,16 @@ bt_machine_dispose(GObject *const object)
   // shut down interaction control setup
   g_hash_table_destroy(self->priv->control_data);
 
+  if (self->priv->skipped_buffers)
+  {
+    GST_INFO_OBJECT(self, "skipped %" G_GUINT64_FORMAT " silent buffers",
+                    self->priv->skipped_buffers);
+  }
+  bt_machine_log_mixer_stats(self);
+
   // unref the pads
+  if (self->priv->stem_pad)
+    gst_object_unref(self->priv->stem_pad);
   for (i = 0; i < PART_COUNT; i++)
   {
     if (self->priv->src_pads[i])
@@ -3965,6 +4319,8 @@ bt_machine_dispose(GObject *const object)
       node->data = NULL;
     }
   }
+  if (self->priv->state_cb)
+    gst_object_unref(self->priv->state_cb);
   // unref param groups
   g_object_try_unref(self->priv->prefs_param_group);
   g_object_try_unref(self->priv->global_param_group);
@@ -4014,6 +4370,27 @@ bt_machine_finalize(GObject *const object)
   GST_DEBUG("  done");
 }
 
+static GstStateChangeReturn
+bt_machine_change_element_state(GstElement *element, GstStateChange transition)
+{
+  const BtMachine *const self = BT_MACHINE(element);
+  GstStateChangeReturn res;
+
+  res = GST_ELEMENT_CLASS(bt_machine_parent_class)->change_state(element,
+                                                                  transition);
+
+  switch (transition)
+  {
+  case GST_STATE_CHANGE_PAUSED_TO_READY:
+    // the streaming threads are stopped now
+    bt_machine_log_mixer_stats(self);
+    break;
+  default:
+    break;
+  }
+  return res;
+}
+
 static gboolean bt_machine_is_cloneable_default(const BtMachine *const self)
 {
   return TRUE;
@@ -4042,6 +4419,8 @@ bt_machine_init(BtMachine *self)
   self->priv->control_data =
       g_hash_table_new_full(NULL, NULL, NULL,
                             (GDestroyNotify)free_control_data);
+  self->priv->mixer_last_push = GST_CLOCK_TIME_NONE;
+  bt_perf_data_init(&self->priv->perf);
 
   GST_DEBUG("!!!! self=%p", self);
 }
@@ -4077,6 +4456,7 @@ bt_machine_class_init(BtMachineClass *const klass)
 
   gstelement_class->request_new_pad = bt_machine_request_new_pad;
   gstelement_class->release_pad = bt_machine_release_pad;
+  gstelement_class->change_state = bt_machine_change_element_state;
 
   machine_class->is_cloneable = bt_machine_is_cloneable_default;
   /**
@@ -4211,4 +4591,20 @@ bt_machine_class_init(BtMachineClass *const klass)
                                   g_param_spec_string("pretty-name", "pretty-name prop",
                                                       "pretty-printed name for display purposes", NULL,
                                                       G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+
+  /**
+   * BtMachine:cpu-load:
+   *
+   * The time the machine spent processing the recent buffers in percent of
+   * the buffer durations. Values above 100 mean that the machine can't keep
+   * up with realtime playback. Sources also account the parts following them
+   * in their thread that are not accounted by other machines or wires.
+   *
+   * Since: 0.12
+   */
+  g_object_class_install_property(gobject_class, MACHINE_CPU_LOAD,
+                                  g_param_spec_uint("cpu-load", "cpu-load prop",
+                                                    "cpu load of the machine in percent of realtime",
+                                                    0, G_MAXUINT, 0,
+                                                    G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
 }
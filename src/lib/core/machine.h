@@ -22,6 +22,7 @@
 #include <glib-object.h>
 
 #include "ic/ic.h"
+#include "sink-bin.h"
 
 #define BT_TYPE_MACHINE            (bt_machine_get_type ())
 #define BT_MACHINE(obj)            (G_TYPE_CHECK_INSTANCE_CAST ((obj), BT_TYPE_MACHINE, BtMachine))
@@ -115,6 +116,9 @@ gboolean bt_machine_has_active_adder(const BtMachine * const self);
 gboolean bt_machine_activate_spreader(BtMachine * const self);
 gboolean bt_machine_has_active_spreader(const BtMachine * const self);
 
+gboolean bt_machine_enable_stem(BtMachine * const self, BtSinkBinRecordFormat format, const gchar * const file_name);
+void bt_machine_disable_stem(BtMachine * const self);
+
 #include "parameter-group.h"
 #include "pattern.h"
 #include "pattern-control-source.h"
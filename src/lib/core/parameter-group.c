@@ -66,6 +66,11 @@ struct _BtParameterGroupPrivate
   GParamSpec **params;
   GValue *no_val;
   GstControlBinding **cb;
+
+  /* lookup tables, built once the group is constructed: param name ->
+   * index + 1 and the indexes of the first trigger and the wave param */
+  GHashTable *param_index;
+  glong trigger_param, wave_param;
 };
 
 //-- the class
@@ -281,18 +286,11 @@ glong
 bt_parameter_group_get_param_index (const BtParameterGroup * const self,
     const gchar * const name)
 {
-  const gulong params = self->priv->num_params;
-  gulong i;
-
   g_return_val_if_fail (BT_IS_PARAMETER_GROUP (self), -1);
   g_return_val_if_fail (BT_IS_STRING (name), -1);
 
-  for (i = 0; i < params; i++) {
-    if (!strcmp (PARAM_NAME (i), name)) {
-      return (glong) i;
-    }
-  }
-  return -1;
+  return GPOINTER_TO_INT (g_hash_table_lookup (self->priv->param_index,
+          name)) - 1;
 }
 
 
@@ -334,6 +332,30 @@ bt_parameter_group_get_param_parent (const BtParameterGroup * const self,
   return self->priv->parents[index];
 }
 
+/**
+ * bt_parameter_group_get_param_control_binding:
+ * @self: the parameter group to search for the param
+ * @index: the offset in the list of params
+ *
+ * Retrieves the control binding that the sequence uses to control the param.
+ * The bindings are created once together with the group, this does not search
+ * the bindings of the param parent.
+ *
+ * Returns: (transfer none): the #GstControlBinding or %NULL if the param is not
+ * controllable
+ *
+ * Since: 0.12
+ */
+GstControlBinding *
+bt_parameter_group_get_param_control_binding (const BtParameterGroup *
+    const self, const gulong index)
+{
+  g_return_val_if_fail (BT_IS_PARAMETER_GROUP (self), NULL);
+  g_return_val_if_fail (index < self->priv->num_params, NULL);
+
+  return self->priv->cb[index];
+}
+
 
 #define _DETAILS(t,T,p)                                                        \
 	case G_TYPE_ ## T: {                                                         \
@@ -496,16 +518,9 @@ bt_parameter_group_get_param_no_value (const BtParameterGroup * const self,
 glong
 bt_parameter_group_get_trigger_param_index (const BtParameterGroup * const self)
 {
-  const gulong num_params = self->priv->num_params;
-  GParamSpec **params = self->priv->params;
-  glong i;
   g_return_val_if_fail (BT_IS_PARAMETER_GROUP (self), -1);
 
-  for (i = 0; i < num_params; i++) {
-    if (!(params[i]->flags & G_PARAM_READABLE))
-      return i;
-  }
-  return -1;
+  return self->priv->trigger_param;
 }
 
 /**
@@ -520,16 +535,9 @@ bt_parameter_group_get_trigger_param_index (const BtParameterGroup * const self)
 glong
 bt_parameter_group_get_wave_param_index (const BtParameterGroup * const self)
 {
-  const gulong num_params = self->priv->num_params;
-  GParamSpec **params = self->priv->params;
-  glong i;
   g_return_val_if_fail (BT_IS_PARAMETER_GROUP (self), -1);
 
-  for (i = 0; i < num_params; i++) {
-    if (params[i]->value_type == GSTBT_TYPE_WAVE_INDEX)
-      return i;
-  }
-  return -1;
+  return self->priv->wave_param;
 }
 
 /**
@@ -705,6 +713,20 @@ bt_parameter_group_constructed (GObject * object)
   self->priv->no_val = (GValue *) g_new0 (GValue, num_params);
   self->priv->cb = (GstControlBinding **) g_new0 (gpointer, num_params);
 
+  // build the lookup tables, the names are owned by the param specs
+  for (i = 0; i < num_params; i++) {
+    param = params[i];
+    if (!g_hash_table_contains (self->priv->param_index, param->name)) {
+      g_hash_table_insert (self->priv->param_index, (gpointer) param->name,
+          GINT_TO_POINTER (i + 1));
+    }
+    if (self->priv->trigger_param == -1 && !(param->flags & G_PARAM_READABLE))
+      self->priv->trigger_param = i;
+    if (self->priv->wave_param == -1 &&
+        param->value_type == GSTBT_TYPE_WAVE_INDEX)
+      self->priv->wave_param = i;
+  }
+
   g_object_get (self->priv->song, "sequence", &sequence, "song-info",
       &song_info, NULL);
 
@@ -861,6 +883,7 @@ bt_parameter_group_finalize (GObject * const object)
   g_free (self->priv->params);
   g_free (self->priv->no_val);
   g_free (self->priv->cb);
+  g_hash_table_destroy (self->priv->param_index);
 
   G_OBJECT_CLASS (bt_parameter_group_parent_class)->finalize (object);
 }
@@ -872,6 +895,8 @@ bt_parameter_group_init (BtParameterGroup * self)
 {
   GST_DEBUG ("!!!! self=%p", self);
   self->priv = bt_parameter_group_get_instance_private(self);
+  self->priv->param_index = g_hash_table_new (g_str_hash, g_str_equal);
+  self->priv->trigger_param = self->priv->wave_param = -1;
 }
 
 static void
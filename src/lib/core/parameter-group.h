@@ -64,6 +64,7 @@ glong bt_parameter_group_get_param_index(const BtParameterGroup * const self, co
 
 GParamSpec *bt_parameter_group_get_param_spec(const BtParameterGroup * const self, const gulong index);
 GObject *bt_parameter_group_get_param_parent(const BtParameterGroup * const self, const gulong index);
+GstControlBinding *bt_parameter_group_get_param_control_binding(const BtParameterGroup * const self, const gulong index);
 void bt_parameter_group_get_param_details(const BtParameterGroup * const self, const gulong index, GParamSpec **pspec, GValue **min_val, GValue **max_val);
 GType bt_parameter_group_get_param_type(const BtParameterGroup * const self, const gulong index);
 const gchar *bt_parameter_group_get_param_name(const BtParameterGroup * const self, const gulong index);
@@ -29,6 +29,12 @@
  * sequence will be initialized from #BtPatternControlSource:default-value. For
  * trigger parameter this usualy is the no-value. For other parameters it is the
  * last value one has set in the ui or via interaction controller.
+ *
+ * Elements that apply parameter changes per sample (e.g. volume) request value
+ * arrays. These are filled sample accurate, the value changes exactly at the
+ * sample that corresponds to the tick, even if the buffer does not start on a
+ * tick. Setting #BtPatternControlSource:ramp-time to a non zero value linearly
+ * ramps numeric parameters to the new value to avoid zipper noise.
  */
 /* TODO(ensonic): create a variant for trigger parameters?
  * - these don't search in the sequence and they have different default_values
@@ -50,7 +56,8 @@ enum
   PATTERN_CONTROL_SOURCE_SONG_INFO,
   PATTERN_CONTROL_SOURCE_MACHINE,
   PATTERN_CONTROL_SOURCE_PARAMETER_GROUP,
-  PATTERN_CONTROL_SOURCE_DEFAULT_VALUE
+  PATTERN_CONTROL_SOURCE_DEFAULT_VALUE,
+  PATTERN_CONTROL_SOURCE_RAMP_TIME
 };
 
 struct _BtPatternControlSourcePrivate
@@ -69,6 +76,16 @@ struct _BtPatternControlSourcePrivate
   glong param_index;
   GValue def_value;
   gboolean is_trigger;
+  /* storage for the values from the compiled schedule */
+  GValue cur_value;
+
+  /* value ramp for the array api, values are stored as doubles */
+  GstClockTime ramp_time, ramp_start;
+  gdouble ramp_from, ramp_to;
+  gboolean has_ramp_value, ramp_to_default;
+  /* timestamp right after the last filled array, to detect seeks, callers
+   * truncate the interval, so we allow for some rounding error */
+  GstClockTime next_timestamp, next_tolerance;
 
   GstClockTime tick_duration;
 };
@@ -129,11 +146,17 @@ bt_pattern_control_source_get_value (GstControlBinding * self_,
       param_index, tick, (ts == timestamp), timestamp, ts);
 
   // Don't check patterns on a subtick
-  if (ts == timestamp) {
-    glong i = -1, l, length;
+  if (ts == timestamp && bt_sequence_is_compiled (sequence)) {
+    // the sequence has flattened the patterns already
+    if (bt_sequence_get_scheduled_value (sequence, machine, pg, param_index,
+            tick, &self->priv->cur_value)) {
+      res = &self->priv->cur_value;
+    }
+  } else if (ts == timestamp) {
+    glong i = -1;
+    gulong l, length;
     BtCmdPattern *pattern;
     BtValueGroup *vg;
-    GValue *cur;
 
     g_object_get (sequence, "length", &length, NULL);
     if (tick >= length) {
@@ -150,13 +173,10 @@ bt_pattern_control_source_get_value (GstControlBinding * self_,
     while ((i = bt_sequence_get_track_by_machine (sequence, machine, i + 1))
         != -1) {
       // check what pattern plays at tick or upwards
-      for (l = tick, pattern = NULL; l >= 0; l--) {
-        if ((pattern = bt_sequence_get_pattern (sequence, l, i)))
-          break;
-      }
+      pattern = bt_sequence_get_playing_pattern (sequence, tick, i, &l);
       // check if valid pattern
-      if (BT_IS_PATTERN (pattern)) {
-        gulong len, pos = (glong) tick - l;
+      if (pattern && BT_IS_PATTERN (pattern)) {
+        gulong len, pos = tick - l;
         // get length of pattern
         g_object_get (pattern, "length", &len, NULL);
         if (pos < len) {
@@ -164,13 +184,12 @@ bt_pattern_control_source_get_value (GstControlBinding * self_,
           vg = bt_pattern_get_group_by_parameter_group (
               (BtPattern *) pattern, pg);
           // get value at tick if set
-          if ((cur = bt_value_group_get_event_data (vg, pos, param_index))
-              && BT_IS_GVALUE (cur)) {
-            res = cur;
+          if (bt_value_group_get_event_value (vg, pos, param_index,
+                  &self->priv->cur_value)) {
+            res = &self->priv->cur_value;
           }
         }
       }
-      g_object_try_unref (pattern);
     }
   } else {
     GST_LOG_OBJECT (self->priv->machine, "skipping subtick");
@@ -196,48 +215,204 @@ bt_pattern_control_source_get_value (GstControlBinding * self_,
   return NULL;
 }
 
-// we need to fill an array as the volume element is applying sample based changes
+/* bt_pattern_control_source_get_ramp_value:
+ *
+ * Evaluate the value ramp at the given timestamp.
+ *
+ * Returns: the value as a double
+ */
+static inline gdouble
+bt_pattern_control_source_get_ramp_value (const BtPatternControlSource * self,
+    GstClockTime timestamp)
+{
+  const BtPatternControlSourcePrivate *p = self->priv;
+
+  if (!p->ramp_time || timestamp < p->ramp_start ||
+      timestamp >= p->ramp_start + p->ramp_time) {
+    return p->ramp_to;
+  }
+  return p->ramp_from + (p->ramp_to - p->ramp_from) *
+      ((gdouble) (timestamp - p->ramp_start) / (gdouble) p->ramp_time);
+}
+
+/* bt_pattern_control_source_set_ramp_target:
+ *
+ * Start a new ramp at @timestamp towards @value. The ramp continues from the
+ * value the previous ramp has at @timestamp.
+ *
+ * Returns: %FALSE if the type is not supported or @value is unset
+ */
 static gboolean
-bt_pattern_control_source_get_value_array (GstControlBinding * self_,
-    GstClockTime timestamp, GstClockTime interval, guint n_values,
-    gpointer values_)
+bt_pattern_control_source_set_ramp_target (BtPatternControlSource * self,
+    const GValue * value, GstClockTime timestamp)
 {
-  BtPatternControlSource *self = (BtPatternControlSource *) self_;
-  gint i;
-  GValue *value;
-  return_val_if_disposed (FALSE);
+  BtPatternControlSourcePrivate *p = self->priv;
+  gdouble target;
 
-  if (!(value = bt_pattern_control_source_get_value (self_, timestamp))) {
+  if (!G_IS_VALUE (value))
     return FALSE;
+
+  switch (p->base) {
+    case G_TYPE_BOOLEAN:
+      target = g_value_get_boolean (value) ? 1.0 : 0.0;
+      break;
+    case G_TYPE_FLOAT:
+      target = g_value_get_float (value);
+      break;
+    case G_TYPE_DOUBLE:
+      target = g_value_get_double (value);
+      break;
+    default:
+      return FALSE;
   }
-  switch (self->priv->base) {
+  // booleans and triggers jump to the new value
+  if (p->has_ramp_value && p->base != G_TYPE_BOOLEAN && !p->is_trigger) {
+    p->ramp_from = bt_pattern_control_source_get_ramp_value (self, timestamp);
+  } else {
+    p->ramp_from = target;
+  }
+  p->ramp_to = target;
+  p->ramp_start = timestamp;
+  p->has_ramp_value = TRUE;
+  p->ramp_to_default = (value == &p->def_value);
+  return TRUE;
+}
+
+/* bt_pattern_control_source_fill_values:
+ *
+ * Fill the array entries [@i,@n) from the current value ramp. Only the part of
+ * the span that is still ramping is evaluated per sample, the rest is a plain
+ * fill the compiler can vectorize.
+ *
+ * Returns: %FALSE if the type is not supported and nothing was written
+ */
+static gboolean
+bt_pattern_control_source_fill_values (const BtPatternControlSource * self,
+    gpointer values_, guint i, const guint n, GstClockTime timestamp,
+    const GstClockTime interval)
+{
+  const BtPatternControlSourcePrivate *p = self->priv;
+  const GstClockTime ramp_end = p->ramp_start + p->ramp_time;
+  GstClockTime ts = timestamp + i * interval;
+  guint r = i;
+
+  if (p->ramp_time && ts >= p->ramp_start && ts < ramp_end) {
+    r = interval ? MIN (n, i + (guint) ((ramp_end - ts + interval - 1) /
+            interval)) : n;
+  }
+
+  switch (p->base) {
     case G_TYPE_BOOLEAN:{
-      gboolean val = g_value_get_boolean (value);
       gboolean *values = (gboolean *) values_;
-      GST_INFO ("filling array with boolean: %d", val);
-      for (i = 0; i < n_values; i++)
-        *values++ = val;
+      const gboolean val = (p->ramp_to != 0.0);
+      for (; i < n; i++)
+        values[i] = val;
       break;
     }
     case G_TYPE_FLOAT:{
-      gfloat val = g_value_get_float (value);
       gfloat *values = (gfloat *) values_;
-      GST_INFO ("filling array with floats: %f", val);
-      for (i = 0; i < n_values; i++)
-        *values++ = val;
+      const gfloat val = (gfloat) p->ramp_to;
+      for (; i < r; i++, ts += interval)
+        values[i] = (gfloat) bt_pattern_control_source_get_ramp_value (self, ts);
+      for (; i < n; i++)
+        values[i] = val;
       break;
     }
     case G_TYPE_DOUBLE:{
-      gdouble val = g_value_get_double (value);
       gdouble *values = (gdouble *) values_;
-      GST_INFO ("filling array with doubles: %lf", val);
-      for (i = 0; i < n_values; i++)
-        *values++ = val;
+      const gdouble val = p->ramp_to;
+      for (; i < r; i++, ts += interval)
+        values[i] = bt_pattern_control_source_get_ramp_value (self, ts);
+      for (; i < n; i++)
+        values[i] = val;
       break;
     }
+    default:
+      return FALSE;
+  }
+  return TRUE;
+}
+
+// we need to fill an array as the volume element is applying sample based changes
+static gboolean
+bt_pattern_control_source_get_value_array (GstControlBinding * self_,
+    GstClockTime timestamp, GstClockTime interval, guint n_values,
+    gpointer values_)
+{
+  BtPatternControlSource *self = (BtPatternControlSource *) self_;
+  BtSongInfo *song_info = self->priv->song_info;
+  BtPatternControlSourcePrivate *p = self->priv;
+  GstClockTime bound;
+  GValue *value;
+  gulong tick;
+  guint i = 0, k;
+  gboolean discont = FALSE;
+  return_val_if_disposed (FALSE);
+
+  switch (self->priv->base) {
+    case G_TYPE_BOOLEAN:
+    case G_TYPE_FLOAT:
+    case G_TYPE_DOUBLE:
+      break;
     default:
       GST_WARNING ("implement me for type %s", g_type_name (self->priv->base));
+      return FALSE;
+  }
+
+  /* a seek, loop wrap or other discontinuity must not ramp across the gap,
+   * finish the ramp and hold the value it was heading for */
+  if (p->has_ramp_value &&
+      (timestamp + p->next_tolerance < p->next_timestamp ||
+          timestamp > p->next_timestamp + p->next_tolerance)) {
+    GST_DEBUG ("discontinuity: %" GST_TIME_FORMAT " != %" GST_TIME_FORMAT,
+        GST_TIME_ARGS (timestamp), GST_TIME_ARGS (p->next_timestamp));
+    p->ramp_from = p->ramp_to;
+    p->ramp_start = timestamp;
+    discont = TRUE;
+  }
+  p->next_timestamp = timestamp + n_values * interval;
+  // one interval plus the truncation error of less than 1ns per sample
+  p->next_tolerance = interval + n_values;
+
+  // find the first tick at or after the timestamp
+  tick = bt_song_info_time_to_tick (song_info, timestamp);
+  if ((bound = bt_song_info_tick_to_time (song_info, tick)) < timestamp) {
+    bound = bt_song_info_tick_to_time (song_info, ++tick);
+  }
+  while (i < n_values) {
+    // index of the first sample at or after the tick
+    if (bound <= timestamp) {
+      k = 0;
+    } else if (!interval) {
+      k = n_values;
+    } else {
+      k = (guint) MIN ((guint64) n_values,
+          (bound - timestamp + interval - 1) / interval);
+    }
+    if (k > i) {
+      if (!self->priv->has_ramp_value) {
+        // we start in the middle of a tick, begin with the default
+        if (!bt_pattern_control_source_set_ramp_target (self,
+                &self->priv->def_value, timestamp)) {
+          return FALSE;
+        }
+      }
+      GST_LOG ("filling array [%u,%u) with %lf", i, k, self->priv->ramp_to);
+      if (!bt_pattern_control_source_fill_values (self, values_, i, k,
+              timestamp, interval)) {
+        return FALSE;
+      }
+      i = k;
+    }
+    if (i == n_values)
       break;
+    if ((value = bt_pattern_control_source_get_value (self_, bound))) {
+      bt_pattern_control_source_set_ramp_target (self, value, bound);
+      // a value right at a discontinuity applies at once
+      if (discont && bound <= timestamp)
+        p->ramp_from = p->ramp_to;
+    }
+    bound = bt_song_info_tick_to_time (song_info, ++tick);
   }
   return TRUE;
 }
@@ -323,6 +498,7 @@ bt_pattern_control_source_constructor (GType type, guint n_construct_params,
         g_param_value_set_default (pspec, &self->priv->def_value);
       }
     }
+    g_value_init (&self->priv->cur_value, type);
   }
   return (GObject *) self;
 }
@@ -347,6 +523,9 @@ bt_pattern_control_source_get_property (GObject * const object,
     case PATTERN_CONTROL_SOURCE_PARAMETER_GROUP:
       g_value_set_object (value, self->priv->param_group);
       break;
+    case PATTERN_CONTROL_SOURCE_RAMP_TIME:
+      g_value_set_uint64 (value, self->priv->ramp_time);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, property_id, pspec);
       break;
@@ -393,9 +572,19 @@ bt_pattern_control_source_set_property (GObject * const object,
       GST_INFO ("%s -> %s", g_strdup_value_contents (new_value),
           g_strdup_value_contents (&self->priv->def_value));
       g_value_copy (new_value, &self->priv->def_value);
+      // retarget a ramp that is heading for the old default
+      if (self->priv->has_ramp_value && self->priv->ramp_to_default) {
+        bt_pattern_control_source_set_ramp_target (self,
+            &self->priv->def_value, self->priv->next_timestamp);
+      }
       GST_DEBUG ("set the def_value for the controlsource");
       break;
     }
+    case PATTERN_CONTROL_SOURCE_RAMP_TIME:
+      self->priv->ramp_time = g_value_get_uint64 (value);
+      GST_DEBUG ("set the ramp-time for the controlsource: %" GST_TIME_FORMAT,
+          GST_TIME_ARGS (self->priv->ramp_time));
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, property_id, pspec);
       break;
@@ -432,6 +621,9 @@ bt_pattern_control_source_finalize (GObject * const object)
   if (G_IS_VALUE (&self->priv->def_value)) {
     g_value_unset (&self->priv->def_value);
   }
+  if (G_IS_VALUE (&self->priv->cur_value)) {
+    g_value_unset (&self->priv->cur_value);
+  }
 
   G_OBJECT_CLASS (bt_pattern_control_source_parent_class)->finalize (object);
 }
@@ -496,4 +688,10 @@ bt_pattern_control_source_class_init (BtPatternControlSourceClass * const klass)
       g_param_spec_pointer ("default-value", "default value prop",
           "pointer to value to use if no other found",
           G_PARAM_WRITABLE | G_PARAM_STATIC_STRINGS));
+
+  g_object_class_install_property (gobject_class,
+      PATTERN_CONTROL_SOURCE_RAMP_TIME,
+      g_param_spec_uint64 ("ramp-time", "ramp time prop",
+          "duration of the ramp to a new value in value arrays, 0 to jump",
+          0, G_MAXUINT64, 0, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 }
@@ -737,6 +737,21 @@ bt_pattern_get_group_by_parameter_group (const BtPattern * const self,
   return g_hash_table_lookup (self->priv->param_to_value_groups, param_group);
 }
 
+/*
+ * bt_pattern_get_value_groups:
+ * @self: the pattern
+ *
+ * Get the map of all #BtParameterGroups to their #BtValueGroup in this pattern.
+ * Used to walk all the groups without knowing the voices and wires.
+ *
+ * Returns: (transfer none): the hashtable owned by the pattern.
+ */
+GHashTable *
+bt_pattern_get_value_groups (const BtPattern * const self)
+{
+  return self->priv->param_to_value_groups;
+}
+
 /**
  * bt_pattern_insert_row:
  * @self: the pattern
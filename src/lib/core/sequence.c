@@ -31,24 +31,16 @@
  * The sequence is not aware of timing related information; for this take a look
  * at #BtSongInfo.
  */
-/* TODO(ensonic): introduce a BtTrack object
- * - the sequence will have a array of tracks
- * - each track has a machine and a array with patterns
- * - this makes it easier to e.g. pass old track data to track-removed
- * - also insert/delete can be done per track
- * - need to be careful to make getting the pattern not slow
- * - this would also make it easier to have BtTrackGroups
- *   - essentially an array of BtTracks per machine (in the order of appearance
- *     in the sequence)
- *   - this would make it more easy to determine the effective pattern cells for
- *     the controller
- *   - when reordering tracks, the per machine lists would need to be updated as
- *     well
- *
- * Sequence -+- Track 1 -+- TrackGroup 1
+/* The sequence has an array of tracks. Each track has a machine and a column
+ * with the patterns of the track, so that inserting or deleting on a track only
+ * moves its own column and reordering tracks only swaps pointers. The tracks
+ * that belong to a machine are grouped in a map from the machine to the track
+ * indexes (in the order of appearance in the sequence):
+ *
+ * Sequence -+- Track 1 -+- Machine 1
  *           +- Track 2 -´
- *           +- Track 3 --- TrackGroup 2
- *           +- Track 4 -+- TrackGroup 3
+ *           +- Track 3 --- Machine 2
+ *           +- Track 4 -+- Machine 3
  *           `- Track 5 -´
  */
 
@@ -59,6 +51,14 @@
 
 //-- forward declarations
 static void bt_sequence_limit_play_pos_internal (const BtSequence * const self);
+static void bt_sequence_on_pattern_param_changed (const BtPattern * pattern,
+    BtParameterGroup * param_group, const gulong tick, const gulong param,
+    gpointer user_data);
+static void bt_sequence_on_pattern_group_changed (const BtPattern * pattern,
+    BtParameterGroup * param_group, const gboolean intermediate,
+    gpointer user_data);
+static void bt_sequence_on_pattern_layout_changed (const BtPattern * pattern,
+    GParamSpec * const arg, gpointer user_data);
 
 //-- signal ids
 
@@ -84,9 +84,34 @@ enum
   SEQUENCE_LOOP_END,
   SEQUENCE_PROPERTIES,
   SEQUENCE_TOC,
-  SEQUENCE_LEN_PATTERNS
+  SEQUENCE_LEN_PATTERNS,
+  SEQUENCE_COMPILED
 };
 
+/* a track of the sequence */
+typedef struct
+{
+  /* the machine that is the heading of the track */
+  BtMachine *machine;
+  /* <len_patterns> BtCmdPattern pointers */
+  BtCmdPattern **patterns;
+  /* the ticks that have a pattern, sorted ascending. This is an interval index
+   * to quickly find the pattern that is playing on a track at a given tick
+   * (see bt_sequence_get_playing_pattern())
+   */
+  GArray *pattern_ticks;
+} BtSequenceTrack;
+
+/* an entry in the compiled event schedule of a machine */
+typedef struct
+{
+  gulong tick;
+  BtParameterGroup *param_group;
+  gulong param;
+  gulong track;
+  GValue value;
+} BtSequenceEvent;
+
 struct _BtSequencePrivate
 {
   /* used to validate if dispose has run */
@@ -112,12 +137,24 @@ struct _BtSequencePrivate
    */
   glong loop_start, loop_end;
 
-  /* <tracks> machine entries that are the heading of the sequence */
-  BtMachine **machines;
+  /* <tracks> track entries, the machines are the heading of the sequence */
+  BtSequenceTrack **track_data;
   /* <length> label entries that are the description of the time axis */
   gchar **labels;
-  /* <length>*<tracks> BtCmdPattern pointers */
-  BtCmdPattern **patterns;
+  /* the ticks that have a label, sorted ascending, to build the toc without
+   * scanning the time axis */
+  GArray *label_ticks;
+
+  /* machine -> GArray of gulong with the track indexes (ascending) that use the
+   * machine */
+  GHashTable *machine_tracks;
+
+  /* compiled playback mode: machine -> GArray of BtSequenceEvent sorted by
+   * tick, parameter group and parameter. The lock protects the schedules
+   * against the streaming threads that read from them. */
+  gboolean compiled;
+  GHashTable *schedules;
+  GMutex schedule_lock;
 
   /* playback range variables */
   gulong play_start, play_end;
@@ -139,6 +176,10 @@ struct _BtSequencePrivate
 
 static guint signals[LAST_SIGNAL] = { 0, };
 
+/* number of index entries that edits looked at, see
+ * bt_sequence_dbg_get_index_visits() */
+static gulong index_visits = 0;
+
 //-- the class
 
 static void bt_sequence_persistence_interface_init (gpointer const g_iface,
@@ -156,7 +197,9 @@ G_DEFINE_TYPE_WITH_CODE (BtSequence, bt_sequence, G_TYPE_OBJECT,
  * bt_sequence_get_toc:
  * @self: the sequence
  *
- * Get the toc containing a cue sheet of the labels. The toc is build as needed.
+ * Get the toc containing a cue sheet of the labels. The toc is build as needed
+ * from the label index, thus the cost depends on the number of labels and not
+ * on the length of the sequence.
  *
  * Returns: the toc, unref when done.
  */
@@ -167,8 +210,9 @@ bt_sequence_get_toc (const BtSequence * const self)
     GstTocEntry *entry, *subentry, *prev_entry = NULL;
     GstTagList *tags;
     GstClockTime duration, tick_duration, start = G_GUINT64_CONSTANT (0), stop;
+    const GArray *const ticks = self->priv->label_ticks;
     gchar *id;
-    gulong i;
+    guint j;
 
     self->priv->toc = gst_toc_new (GST_TOC_SCOPE_GLOBAL);
 
@@ -180,25 +224,28 @@ bt_sequence_get_toc (const BtSequence * const self)
     gst_toc_entry_set_start_stop_times (entry, 0, duration);
     gst_toc_append_entry (self->priv->toc, entry);
 
-    for (i = 0; i < self->priv->length; i++) {
+    for (j = 0; j < ticks->len; j++) {
+      const gulong i = g_array_index (ticks, gulong, j);
       const gchar *const label = self->priv->labels[i];
-      if (label) {
-        id = g_strdup_printf ("%08lx", i);
-        subentry = gst_toc_entry_new (GST_TOC_ENTRY_TYPE_TRACK, id);
-        g_free (id);
-        tags = gst_tag_list_new_empty ();
-        gst_tag_list_add (tags, GST_TAG_MERGE_APPEND, GST_TAG_TITLE, label,
-            NULL);
-        gst_toc_entry_set_tags (subentry, tags);
-        gst_toc_entry_append_sub_entry (entry, subentry);
-
-        stop = tick_duration * i;
-        if (prev_entry) {
-          gst_toc_entry_set_start_stop_times (prev_entry, start, stop);
-        }
-        prev_entry = subentry;
-        start = stop;
+
+      index_visits++;
+      if (i >= self->priv->length)
+        break;
+      id = g_strdup_printf ("%08lx", i);
+      subentry = gst_toc_entry_new (GST_TOC_ENTRY_TYPE_TRACK, id);
+      g_free (id);
+      tags = gst_tag_list_new_empty ();
+      gst_tag_list_add (tags, GST_TAG_MERGE_APPEND, GST_TAG_TITLE, label,
+          NULL);
+      gst_toc_entry_set_tags (subentry, tags);
+      gst_toc_entry_append_sub_entry (entry, subentry);
+
+      stop = tick_duration * i;
+      if (prev_entry) {
+        gst_toc_entry_set_start_stop_times (prev_entry, start, stop);
       }
+      prev_entry = subentry;
+      start = stop;
     }
     if (prev_entry) {
       gst_toc_entry_set_start_stop_times (prev_entry, start, duration);
@@ -258,7 +305,7 @@ bt_sequence_test_pattern (const BtSequence * const self, const gulong time,
      g_return_val_if_fail(time<self->priv->length,FALSE);
      g_return_val_if_fail(track<self->priv->tracks,FALSE);
    */
-  return (self->priv->patterns[time * self->priv->tracks + track] != NULL);
+  return (self->priv->track_data[track]->patterns[time] != NULL);
 }
 
 static void
@@ -282,6 +329,15 @@ bt_sequence_use_pattern (const BtSequence * const self,
   if (count == 0) {
     // take one shared ref
     g_object_ref (pattern);
+    // keep the compiled schedule up to date
+    g_signal_connect (pattern, "param-changed",
+        G_CALLBACK (bt_sequence_on_pattern_param_changed), (gpointer) self);
+    g_signal_connect (pattern, "group-changed",
+        G_CALLBACK (bt_sequence_on_pattern_group_changed), (gpointer) self);
+    g_signal_connect (pattern, "notify::length",
+        G_CALLBACK (bt_sequence_on_pattern_layout_changed), (gpointer) self);
+    g_signal_connect (pattern, "notify::voices",
+        G_CALLBACK (bt_sequence_on_pattern_layout_changed), (gpointer) self);
 
     GST_DEBUG ("first use of pattern %p", pattern);
     g_signal_emit ((gpointer) self, signals[PATTERN_ADDED_EVENT], 0, pattern);
@@ -305,6 +361,7 @@ bt_sequence_unuse_pattern (const BtSequence * const self,
   // check if this is the last usage
   if (count == 1) {
     g_signal_emit ((gpointer) self, signals[PATTERN_REMOVED_EVENT], 0, pattern);
+    g_signal_handlers_disconnect_by_data (pattern, (gpointer) self);
     // release the shared ref
     g_object_unref (pattern);
   }
@@ -324,7 +381,7 @@ bt_sequence_get_pattern_unchecked (const BtSequence * const self,
     const gulong time, const gulong track)
 {
   //GST_DEBUG("get pattern at time %d, track %d",time, track);
-  return self->priv->patterns[time * self->priv->tracks + track];
+  return self->priv->track_data[track]->patterns[time];
 }
 
 static BtMachine *
@@ -332,8 +389,577 @@ bt_sequence_get_machine_unchecked (const BtSequence * const self,
     const gulong track)
 {
   //GST_DEBUG("getting machine : %" G_OBJECT_REF_COUNT_FMT,
-  //    G_OBJECT_LOG_REF_COUNT(self->priv->machines[track]));
-  return self->priv->machines[track];
+  //    G_OBJECT_LOG_REF_COUNT(self->priv->track_data[track]->machine));
+  return self->priv->track_data[track]->machine;
+}
+
+/*
+ * bt_sequence_index_lower_bound:
+ * @ticks: the sorted tick index of a track
+ * @time: the time position to search for
+ *
+ * Binary search for the first entry in @ticks that is >= @time.
+ *
+ * Returns: the array position, @ticks->len if all entries are smaller
+ */
+static guint
+bt_sequence_index_lower_bound (const GArray * const ticks, const gulong time)
+{
+  guint lo = 0, hi = ticks->len, mid;
+
+  while (lo < hi) {
+    mid = lo + ((hi - lo) >> 1);
+    index_visits++;
+    if (g_array_index (ticks, gulong, mid) < time)
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
+  return lo;
+}
+
+/*
+ * bt_sequence_index_set:
+ * @ticks: the sorted tick index
+ * @time: the time position
+ * @used: whether the entry at @time is now set
+ *
+ * Add or remove @time from the tick index.
+ */
+static void
+bt_sequence_index_set (GArray * const ticks, const gulong time,
+    const gboolean used)
+{
+  const guint pos = bt_sequence_index_lower_bound (ticks, time);
+  const gboolean found = (pos < ticks->len) &&
+      (g_array_index (ticks, gulong, pos) == time);
+
+  if (used && !found) {
+    g_array_insert_val (ticks, pos, time);
+  } else if (!used && found) {
+    g_array_remove_index (ticks, pos);
+  }
+}
+
+/*
+ * bt_sequence_index_update:
+ * @self: the sequence
+ * @time: the time position
+ * @track: the track index
+ * @used: whether the cell now has a pattern
+ *
+ * Add or remove @time from the tick index of the given @track.
+ */
+static void
+bt_sequence_index_update (const BtSequence * const self, const gulong time,
+    const gulong track, const gboolean used)
+{
+  bt_sequence_index_set (self->priv->track_data[track]->pattern_ticks, time,
+      used);
+}
+
+/*
+ * bt_sequence_index_remove_range:
+ * @ticks: the sorted tick index of a track
+ * @start: first time position to remove
+ * @end: time position after the last one to remove
+ *
+ * Drop all entries in the range [@start, @end) from the index.
+ */
+static void
+bt_sequence_index_remove_range (GArray * const ticks, const gulong start,
+    const gulong end)
+{
+  const guint b = bt_sequence_index_lower_bound (ticks, start);
+  const guint e = bt_sequence_index_lower_bound (ticks, end);
+
+  if (e > b) {
+    g_array_remove_range (ticks, b, e - b);
+  }
+}
+
+/*
+ * bt_sequence_index_shift_range:
+ * @ticks: the sorted tick index of a track
+ * @start: first time position to shift
+ * @end: time position after the last one to shift
+ * @delta: the number of ticks to shift the entries by
+ *
+ * Move all entries in the range [@start, @end) by @delta. The caller must
+ * ensure that the entries stay sorted.
+ */
+static void
+bt_sequence_index_shift_range (GArray * const ticks, const gulong start,
+    const gulong end, const glong delta)
+{
+  guint i = bt_sequence_index_lower_bound (ticks, start);
+
+  for (; i < ticks->len; i++) {
+    gulong *const tick = &g_array_index (ticks, gulong, i);
+    index_visits++;
+    if (*tick >= end)
+      break;
+    *tick += delta;
+  }
+}
+
+/*
+ * bt_sequence_track_new:
+ * @length: the number of timeline entries
+ *
+ * Create an empty track.
+ *
+ * Returns: the new track
+ */
+static BtSequenceTrack *
+bt_sequence_track_new (const gulong length)
+{
+  BtSequenceTrack *const track = g_new0 (BtSequenceTrack, 1);
+
+  track->patterns = g_new0 (BtCmdPattern *, length);
+  track->pattern_ticks = g_array_new (FALSE, FALSE, sizeof (gulong));
+  return track;
+}
+
+/*
+ * bt_sequence_track_unuse_range:
+ * @self: the sequence
+ * @track: the track
+ * @start: first time position to release
+ * @end: time position after the last one to release
+ *
+ * Release the patterns in the range [@start, @end) of the @track. This only
+ * visits the cells that have a pattern (using the tick index), so that the cost
+ * does not depend on the size of the range. The tick index is not changed.
+ */
+static void
+bt_sequence_track_unuse_range (const BtSequence * const self,
+    BtSequenceTrack * const track, const gulong start, const gulong end)
+{
+  const GArray *const ticks = track->pattern_ticks;
+  guint i = bt_sequence_index_lower_bound (ticks, start);
+
+  for (; i < ticks->len; i++) {
+    const gulong tick = g_array_index (ticks, gulong, i);
+
+    index_visits++;
+    if (tick >= end)
+      break;
+    bt_sequence_unuse_pattern (self, track->patterns[tick]);
+    track->patterns[tick] = NULL;
+  }
+}
+
+/*
+ * bt_sequence_track_clear:
+ * @self: the sequence
+ * @track: the track
+ *
+ * Release the machine and all patterns of the @track.
+ */
+static void
+bt_sequence_track_clear (const BtSequence * const self,
+    BtSequenceTrack * const track)
+{
+  bt_sequence_track_unuse_range (self, track, 0, self->priv->len_patterns);
+  g_array_set_size (track->pattern_ticks, 0);
+  if (track->machine) {
+    GST_INFO_OBJECT (track->machine,
+        "release machine %" G_OBJECT_REF_COUNT_FMT,
+        G_OBJECT_LOG_REF_COUNT (track->machine));
+    g_object_unref (track->machine);
+    track->machine = NULL;
+  }
+}
+
+/*
+ * bt_sequence_track_free:
+ * @self: the sequence
+ * @track: the track
+ *
+ * Release the content of the @track and free it.
+ */
+static void
+bt_sequence_track_free (const BtSequence * const self,
+    BtSequenceTrack * const track)
+{
+  bt_sequence_track_clear (self, track);
+  g_array_free (track->pattern_ticks, TRUE);
+  g_free (track->patterns);
+  g_free (track);
+}
+
+/*
+ * bt_sequence_track_resize:
+ * @self: the sequence
+ * @track: the track
+ * @old_length: the old number of timeline entries
+ * @new_length: the new number of timeline entries
+ *
+ * Resize the pattern column of the @track. Releases the patterns that are cut
+ * off and keeps the others.
+ *
+ * Returns: %FALSE if the column could not be extended, the track is unchanged
+ * in that case
+ */
+static gboolean
+bt_sequence_track_resize (const BtSequence * const self,
+    BtSequenceTrack * const track, const gulong old_length,
+    const gulong new_length)
+{
+  BtCmdPattern **patterns;
+
+  if (new_length > old_length) {
+    // on failure the old buffer is still owned by the track
+    if (!(patterns =
+            g_try_renew (BtCmdPattern *, track->patterns, new_length)))
+      return FALSE;
+    memset (&patterns[old_length], 0,
+        (new_length - old_length) * sizeof (gpointer));
+    track->patterns = patterns;
+    return TRUE;
+  }
+  if (new_length < old_length) {
+    bt_sequence_track_unuse_range (self, track, new_length, old_length);
+    bt_sequence_index_remove_range (track->pattern_ticks, new_length,
+        old_length);
+  }
+  if (!new_length) {
+    g_free (track->patterns);
+    track->patterns = NULL;
+    return TRUE;
+  }
+  // if shrinking fails, the old buffer is still large enough
+  if ((patterns = g_try_renew (BtCmdPattern *, track->patterns, new_length)))
+    track->patterns = patterns;
+  return TRUE;
+}
+
+/*
+ * bt_sequence_update_machine_tracks:
+ * @self: the sequence
+ *
+ * Rebuild the machine to track-list map. Needs to be called whenever the
+ * machines in the track header change.
+ */
+static void
+bt_sequence_update_machine_tracks (const BtSequence * const self)
+{
+  const gulong tracks = self->priv->tracks;
+  BtSequenceTrack **const track_data = self->priv->track_data;
+  GHashTable *machine_tracks = self->priv->machine_tracks;
+  GArray *track_list;
+  BtMachine *machine;
+  gulong i;
+
+  g_hash_table_remove_all (machine_tracks);
+  for (i = 0; i < tracks; i++) {
+    if (!(machine = track_data[i]->machine))
+      continue;
+    if (!(track_list = g_hash_table_lookup (machine_tracks, machine))) {
+      track_list = g_array_new (FALSE, FALSE, sizeof (gulong));
+      g_hash_table_insert (machine_tracks, machine, track_list);
+    }
+    g_array_append_val (track_list, i);
+  }
+}
+
+/*
+ * bt_sequence_get_next_pattern_tick:
+ * @self: the sequence
+ * @time: the time position
+ * @track: the track index
+ *
+ * Get the next tick > @time on @track that holds a pattern.
+ *
+ * Returns: the tick or the length of the sequence if there is none
+ */
+static gulong
+bt_sequence_get_next_pattern_tick (const BtSequence * const self,
+    const gulong time, const gulong track)
+{
+  const GArray *const ticks =
+      self->priv->track_data[track]->pattern_ticks;
+  const guint pos = bt_sequence_index_lower_bound (ticks, time + 1);
+
+  if (pos < ticks->len)
+    return MIN (g_array_index (ticks, gulong, pos), self->priv->length);
+  return self->priv->length;
+}
+
+static gint
+bt_sequence_event_compare (gconstpointer a, gconstpointer b)
+{
+  const BtSequenceEvent *const ea = a;
+  const BtSequenceEvent *const eb = b;
+
+  if (ea->tick != eb->tick)
+    return (ea->tick < eb->tick) ? -1 : 1;
+  if (ea->param_group != eb->param_group)
+    return (ea->param_group < eb->param_group) ? -1 : 1;
+  if (ea->param != eb->param)
+    return (ea->param < eb->param) ? -1 : 1;
+  if (ea->track != eb->track)
+    return (ea->track < eb->track) ? -1 : 1;
+  return 0;
+}
+
+static void
+bt_sequence_event_clear (gpointer data)
+{
+  g_value_unset (&((BtSequenceEvent *) data)->value);
+}
+
+/*
+ * bt_sequence_schedule_lower_bound:
+ * @events: the event schedule of a machine
+ * @time: the time position to search for
+ *
+ * Binary search for the first event in @events that is at or after @time.
+ *
+ * Returns: the array position, @events->len if all events are earlier
+ */
+static guint
+bt_sequence_schedule_lower_bound (const GArray * const events,
+    const gulong time)
+{
+  guint lo = 0, hi = events->len, mid;
+
+  while (lo < hi) {
+    mid = lo + ((hi - lo) >> 1);
+    if (g_array_index (events, BtSequenceEvent, mid).tick < time)
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
+  return lo;
+}
+
+/*
+ * bt_sequence_schedule_collect:
+ * @self: the sequence
+ * @track: the track to collect events from
+ * @start: the first tick
+ * @end: the tick after the last one
+ * @events: the array to append the events to
+ *
+ * Flatten the values of the patterns that play on @track in the range
+ * [@start, @end) into @events.
+ */
+static void
+bt_sequence_schedule_collect (const BtSequence * const self,
+    const gulong track, const gulong start, const gulong end,
+    GArray * const events)
+{
+  const GArray *const ticks =
+      self->priv->track_data[track]->pattern_ticks;
+  guint ix = bt_sequence_index_lower_bound (ticks, start + 1);
+
+  // start with the pattern that is playing at start
+  if (ix > 0)
+    ix--;
+  for (; ix < ticks->len; ix++) {
+    const gulong s = g_array_index (ticks, gulong, ix);
+    gulong e, len, lo, hi, t, p, num_params;
+    BtCmdPattern *pattern;
+    GHashTableIter iter;
+    gpointer key, value;
+
+    if (s >= end)
+      break;
+    pattern = bt_sequence_get_pattern_unchecked (self, s, track);
+    if (!BT_IS_PATTERN (pattern))
+      continue;
+
+    g_object_get (pattern, "length", &len, NULL);
+    e = (ix + 1 < ticks->len) ? g_array_index (ticks, gulong, ix + 1) : end;
+    e = MIN (e, s + len);
+    lo = MAX (s, start);
+    hi = MIN (e, end);
+    if (lo >= hi)
+      continue;
+
+    g_hash_table_iter_init (&iter,
+        bt_pattern_get_value_groups ((BtPattern *) pattern));
+    while (g_hash_table_iter_next (&iter, &key, &value)) {
+      BtParameterGroup *const pg = (BtParameterGroup *) key;
+      BtValueGroup *const vg = (BtValueGroup *) value;
+
+      g_object_get (pg, "num-params", &num_params, NULL);
+      for (t = lo; t < hi; t++) {
+        for (p = 0; p < num_params; p++) {
+          BtSequenceEvent ev = { t, pg, p, track, G_VALUE_INIT };
+
+          if (bt_value_group_get_event_value (vg, t - s, p, &ev.value)) {
+            g_array_append_val (events, ev);
+          }
+        }
+      }
+    }
+  }
+}
+
+/*
+ * bt_sequence_schedule_update_span:
+ * @self: the sequence
+ * @machine: the machine to update the schedule for
+ * @start: the first tick
+ * @end: the tick after the last one
+ *
+ * Recompile the events of the @machine in the range [@start, @end). Values
+ * from later tracks take precedence.
+ */
+static void
+bt_sequence_schedule_update_span (const BtSequence * const self,
+    const BtMachine * const machine, const gulong start, gulong end)
+{
+  const GArray *const track_list =
+      g_hash_table_lookup (self->priv->machine_tracks, machine);
+  GArray *events, *schedule;
+  guint i, j, b, e;
+
+  end = MIN (end, self->priv->length);
+  if (!track_list || start >= end)
+    return;
+
+  events = g_array_new (FALSE, FALSE, sizeof (BtSequenceEvent));
+  for (i = 0; i < track_list->len; i++) {
+    bt_sequence_schedule_collect (self, g_array_index (track_list, gulong, i),
+        start, end, events);
+  }
+  g_array_sort (events, bt_sequence_event_compare);
+  // only keep the last track for each tick, group and param
+  for (i = j = 0; i < events->len; i++) {
+    BtSequenceEvent *const ev = &g_array_index (events, BtSequenceEvent, i);
+
+    if (i + 1 < events->len) {
+      BtSequenceEvent *const nx =
+          &g_array_index (events, BtSequenceEvent, i + 1);
+      if (ev->tick == nx->tick && ev->param_group == nx->param_group &&
+          ev->param == nx->param) {
+        g_value_unset (&ev->value);
+        continue;
+      }
+    }
+    if (i != j)
+      g_array_index (events, BtSequenceEvent, j) = *ev;
+    j++;
+  }
+  g_array_set_size (events, j);
+
+  g_mutex_lock ((GMutex *) & self->priv->schedule_lock);
+  if (!(schedule = g_hash_table_lookup (self->priv->schedules, machine))) {
+    schedule = g_array_new (FALSE, FALSE, sizeof (BtSequenceEvent));
+    g_array_set_clear_func (schedule, bt_sequence_event_clear);
+    g_hash_table_insert (self->priv->schedules, (gpointer) machine, schedule);
+  }
+  b = bt_sequence_schedule_lower_bound (schedule, start);
+  e = bt_sequence_schedule_lower_bound (schedule, end);
+  if (e > b)
+    g_array_remove_range (schedule, b, e - b);
+  // the values have been moved, no need to clear them
+  g_array_insert_vals (schedule, b, events->data, events->len);
+  g_mutex_unlock ((GMutex *) & self->priv->schedule_lock);
+
+  g_array_free (events, TRUE);
+}
+
+/*
+ * bt_sequence_schedule_update_machine:
+ * @self: the sequence
+ * @machine: the machine
+ *
+ * Recompile the complete schedule of the @machine.
+ */
+static void
+bt_sequence_schedule_update_machine (const BtSequence * const self,
+    const BtMachine * const machine)
+{
+  if (!self->priv->compiled)
+    return;
+
+  if (!g_hash_table_contains (self->priv->machine_tracks, machine)) {
+    g_mutex_lock ((GMutex *) & self->priv->schedule_lock);
+    g_hash_table_remove (self->priv->schedules, machine);
+    g_mutex_unlock ((GMutex *) & self->priv->schedule_lock);
+    return;
+  }
+  bt_sequence_schedule_update_span (self, machine, 0, G_MAXULONG);
+}
+
+/*
+ * bt_sequence_schedule_update_all:
+ * @self: the sequence
+ *
+ * Recompile the schedules of all machines.
+ */
+static void
+bt_sequence_schedule_update_all (const BtSequence * const self)
+{
+  GHashTableIter iter;
+  gpointer key;
+
+  if (!self->priv->compiled)
+    return;
+
+  g_mutex_lock ((GMutex *) & self->priv->schedule_lock);
+  g_hash_table_remove_all (self->priv->schedules);
+  g_mutex_unlock ((GMutex *) & self->priv->schedule_lock);
+
+  g_hash_table_iter_init (&iter, self->priv->machine_tracks);
+  while (g_hash_table_iter_next (&iter, &key, NULL)) {
+    bt_sequence_schedule_update_span (self, (BtMachine *) key, 0, G_MAXULONG);
+  }
+}
+
+/*
+ * bt_sequence_schedule_update_pattern:
+ * @self: the sequence
+ * @pattern: the pattern that changed
+ * @start: first changed tick within the pattern
+ * @end: tick after the last changed one within the pattern
+ *
+ * Recompile the spans of the schedule that are affected by a change in the
+ * range [@start, @end) of the @pattern.
+ */
+static void
+bt_sequence_schedule_update_pattern (const BtSequence * const self,
+    const BtPattern * const pattern, const gulong start, const gulong end)
+{
+  const GArray *track_list;
+  BtMachine *machine;
+  guint i, j;
+
+  if (!self->priv->compiled)
+    return;
+
+  g_object_get ((gpointer) pattern, "machine", &machine, NULL);
+  if ((track_list = g_hash_table_lookup (self->priv->machine_tracks, machine))) {
+    for (i = 0; i < track_list->len; i++) {
+      const gulong track = g_array_index (track_list, gulong, i);
+      const GArray *const ticks =
+          self->priv->track_data[track]->pattern_ticks;
+
+      for (j = 0; j < ticks->len; j++) {
+        const gulong s = g_array_index (ticks, gulong, j);
+        gulong next, lo, hi;
+
+        if (s >= self->priv->length)
+          break;
+        if (bt_sequence_get_pattern_unchecked (self, s, track) !=
+            (BtCmdPattern *) pattern)
+          continue;
+
+        next = (j + 1 < ticks->len) ?
+            g_array_index (ticks, gulong, j + 1) : self->priv->length;
+        lo = s + start;
+        hi = (end < next - s) ? s + end : next;
+        if (lo < hi)
+          bt_sequence_schedule_update_span (self, machine, lo, hi);
+      }
+    }
+  }
+  g_object_unref (machine);
 }
 
 /*
@@ -343,30 +969,25 @@ bt_sequence_get_machine_unchecked (const BtSequence * const self,
  * null/empty. Includes all available patterns, even those beyond the "end"
  * of the song.
  *
- * dbeswick: This function will be called whenever the sequence length is set,
- * as part of https://github.com/Buzztrax/buzztrax/pull/109.
- * It counts down from the max sequence length to try to find the last non-null
- * pattern. This takes a long time if you happen to actually want a sequence that
- * large, and tests were timing out, so I limited the max sequence size to 2**31.
- *
- * There are smarter ways to deal with this, but in the meantime I figure 2**31
- * should be enough for anyone?
+ * This function will be called whenever the sequence length is set, as part
+ * of https://github.com/Buzztrax/buzztrax/pull/109. It looks at the last entry
+ * of the tick index of each track, so it does not depend on the sequence
+ * length.
  *
  * Returns 0 if all rows are null or sequence length is zero.
  */
 static gulong
 bt_sequence_get_nonnull_length (const BtSequence * const self) {
-  if (self->priv->len_patterns == 0)
-    return 0;
-  
-  for (gulong i = self->priv->len_patterns; i-- > 0; ) {
-    for (gulong j = 0; j < self->priv->tracks; j++) {
-      if (bt_sequence_test_pattern(self, i, j)) {
-        return i+1;
-      }
+  gulong j, res = 0;
+
+  for (j = 0; j < self->priv->tracks; j++) {
+    const GArray *const ticks = self->priv->track_data[j]->pattern_ticks;
+
+    if (ticks->len) {
+      res = MAX (res, g_array_index (ticks, gulong, ticks->len - 1) + 1);
     }
   }
-  return 0;
+  return res;
 }
 
 /*
@@ -414,8 +1035,11 @@ bt_sequence_post_length_change (const BtSequence * const self,
  * @length: the length to which the data will be resized
  *
  * Resizes the pattern data grid to the new length. Keeps previous values.
+ *
+ * Returns: %FALSE if the memory for the new length could not be allocated, the
+ * sequence keeps its old length in that case
  */
-void
+gboolean
 bt_sequence_resize_data_length (const BtSequence * const self, const gulong length)
 {
   const gulong tracks = self->priv->tracks;
@@ -430,58 +1054,56 @@ bt_sequence_resize_data_length (const BtSequence * const self, const gulong leng
   const gulong new_length =
       MAX(length, bt_sequence_get_nonnull_length (self));
   
-  const gulong old_data_count = old_length * tracks;
-  const gulong new_data_count = new_length * tracks;
-  BtCmdPattern **const patterns = self->priv->patterns;
   gchar **const labels = self->priv->labels;
-
-  if (self->priv->labels && new_data_count == old_data_count)
-    return;
-
-  // there is a need to grow or shrink pattern/label space; allocate new space
-  if ((self->priv->patterns =
-          (BtCmdPattern **) g_try_new0 (gpointer, new_data_count))) {
-    if (patterns) {
-      const gulong count = MIN (old_data_count, new_data_count);
-      // copy old values over
-      memcpy (self->priv->patterns, patterns, count * sizeof (gpointer));
-      // free old data
-      if (old_length > new_length) {
-        gulong i, j, k;
-        k = new_data_count;
-        for (i = new_length; i < old_length; i++) {
-          for (j = 0; j < tracks; j++, k++) {
-            if (patterns[k])
-              bt_sequence_unuse_pattern (self, patterns[k]);
-          }
-        }
+  gchar **new_labels = NULL;
+  gulong j;
+
+  if (labels && new_length == old_length)
+    return TRUE;
+
+  // allocate new label space first, that way a failure leaves all as it was
+  if (new_length && !(new_labels = (gchar **) g_try_new0 (gpointer,
+              new_length))) {
+    GST_WARNING ("extending sequence labels from %lu to %lu failed",
+        old_length, new_length);
+    return FALSE;
+  }
+  // there is a need to grow or shrink pattern space
+  for (j = 0; j < tracks; j++) {
+    if (!bt_sequence_track_resize (self, self->priv->track_data[j], old_length,
+            new_length)) {
+      GST_WARNING
+          ("extending sequence length from %lu to %lu failed for track %lu",
+          old_length, new_length, j);
+      // only extending can fail, undo it for the tracks done so far
+      while (j > 0) {
+        j--;
+        bt_sequence_track_resize (self, self->priv->track_data[j], new_length,
+            old_length);
       }
-      g_free (patterns);
+      g_free (new_labels);
+      return FALSE;
     }
-  } else {
-    GST_INFO
-        ("extending sequence length from %lu to %lu failed : data_count=%lu = length=%lu * tracks=%lu",
-        old_length, new_length, new_data_count, new_length, self->priv->tracks);
   }
-  // allocate new space
-  if ((self->priv->labels = (gchar **) g_try_new0 (gpointer, new_length))) {
-    if (labels) {
-      const gulong count = MIN (old_length, new_length);
-      // copy old values over
-      memcpy (self->priv->labels, labels, count * sizeof (gpointer));
-      // free old data
-      if (old_length > new_length) {
-        for (gulong i = new_length; i < old_length; i++) {
-          g_free (labels[i]);
-        }
+  if (labels) {
+    const gulong count = MIN (old_length, new_length);
+    // copy old values over
+    if (new_labels)
+      memcpy (new_labels, labels, count * sizeof (gpointer));
+    // free old data
+    if (old_length > new_length) {
+      GArray *const ticks = self->priv->label_ticks;
+      guint i = bt_sequence_index_lower_bound (ticks, new_length);
+
+      for (; i < ticks->len; i++) {
+        g_free (labels[g_array_index (ticks, gulong, i)]);
       }
-      g_free (labels);
+      bt_sequence_index_remove_range (ticks, new_length, old_length);
     }
-    bt_sequence_release_toc (self);
-  } else {
-    GST_INFO ("extending sequence labels from %lu to %lu failed", old_length,
-        new_length);
+    g_free (labels);
   }
+  self->priv->labels = new_labels;
+  bt_sequence_release_toc (self);
 
   self->priv->len_patterns = new_length;
 
@@ -491,6 +1113,7 @@ bt_sequence_resize_data_length (const BtSequence * const self, const gulong leng
   bt_sequence_post_length_change (self, length);
   
   g_object_notify ((GObject *) self, "len-patterns");
+  return TRUE;
 }
 
 /*
@@ -505,75 +1128,25 @@ static void
 bt_sequence_resize_data_tracks (const BtSequence * const self,
     const gulong old_tracks)
 {
-  const gulong length = self->priv->length;
+  // resize the whole grid, not just the part up to the song end
+  const gulong length = self->priv->len_patterns;
   const gulong new_tracks = self->priv->tracks;
-  //gulong old_data_count=length*old_tracks;
-  const gulong new_data_count = length * new_tracks;
-  BtCmdPattern **const patterns = self->priv->patterns;
-  BtMachine **const machines = self->priv->machines;
-  const gulong count = MIN (old_tracks, self->priv->tracks);
-
-  GST_DEBUG ("resize tracks %lu -> %lu to new_data_count=%lu", old_tracks,
-      new_tracks, new_data_count);
-
-  // allocate new space
-  if ((self->priv->patterns =
-          (BtCmdPattern **) g_try_new0 (GValue, new_data_count))) {
-    if (patterns) {
-      gulong i;
-      BtCmdPattern **src, **dst;
-
-      // copy old values over
-      src = patterns;
-      dst = self->priv->patterns;
-      for (i = 0; i < length; i++) {
-        memcpy (dst, src, count * sizeof (gpointer));
-        src = &src[old_tracks];
-        dst = &dst[self->priv->tracks];
-      }
-      // free old data
-      if (old_tracks > new_tracks) {
-        gulong j, k;
-        for (i = 0; i < length; i++) {
-          k = i * old_tracks + new_tracks;
-          for (j = new_tracks; j < old_tracks; j++, k++) {
-            if (patterns[k])
-              bt_sequence_unuse_pattern (self, patterns[k]);
-          }
-        }
-      }
-      g_free (patterns);
-    }
-  } else {
-    GST_INFO
-        ("extending sequence tracks from %lu to %lu failed : data_count=%lu = length=%lu * tracks=%lu",
-        old_tracks, new_tracks, new_data_count, self->priv->length, new_tracks);
+  BtSequenceTrack **track_data = self->priv->track_data;
+  gulong i;
+
+  GST_DEBUG ("resize tracks %lu -> %lu", old_tracks, new_tracks);
+
+  // free old tracks
+  for (i = new_tracks; i < old_tracks; i++) {
+    bt_sequence_track_free (self, track_data[i]);
   }
-  // allocate new space
-  if (new_tracks) {
-    if ((self->priv->machines =
-            (BtMachine **) g_try_new0 (gpointer, new_tracks))) {
-      if (machines) {
-        // copy old values over
-        memcpy (self->priv->machines, machines, count * sizeof (gpointer));
-        // free old data
-        if (old_tracks > new_tracks) {
-          gulong i;
-          for (i = new_tracks; i < old_tracks; i++) {
-            GST_INFO_OBJECT (machines[i],
-                "release machine %" G_OBJECT_REF_COUNT_FMT " for track %lu",
-                G_OBJECT_LOG_REF_COUNT (machines[i]), i);
-            g_object_try_unref (machines[i]);
-          }
-        }
-        g_free (machines);
-      }
-    } else
-      self->priv->machines = NULL;
-  } else {
-    GST_INFO ("extending sequence machines from %lu to %lu failed", old_tracks,
-        new_tracks);
+  track_data = g_renew (BtSequenceTrack *, track_data, new_tracks);
+  // new tracks start empty
+  for (i = old_tracks; i < new_tracks; i++) {
+    track_data[i] = bt_sequence_track_new (length);
   }
+  self->priv->track_data = track_data;
+  bt_sequence_update_machine_tracks (self);
 }
 
 /*
@@ -599,6 +1172,46 @@ bt_sequence_limit_play_pos_internal (const BtSequence * const self)
 
 //-- event handler
 
+static void
+bt_sequence_on_pattern_param_changed (const BtPattern * pattern,
+    BtParameterGroup * param_group, const gulong tick, const gulong param,
+    gpointer user_data)
+{
+  bt_sequence_schedule_update_pattern (BT_SEQUENCE (user_data), pattern, tick,
+      tick + 1);
+}
+
+static void
+bt_sequence_on_pattern_group_changed (const BtPattern * pattern,
+    BtParameterGroup * param_group, const gboolean intermediate,
+    gpointer user_data)
+{
+  BtValueGroup *vg;
+  gulong beg, end;
+
+  // wait for the final notify of a batch update
+  if (intermediate)
+    return;
+  // only recompile the changed ticks if known
+  vg = bt_pattern_get_group_by_parameter_group ((BtPattern *) pattern,
+      param_group);
+  if (vg && bt_value_group_get_changed_region (vg, &beg, &end, NULL, NULL)) {
+    bt_sequence_schedule_update_pattern (BT_SEQUENCE (user_data), pattern, beg,
+        end + 1);
+  } else {
+    bt_sequence_schedule_update_pattern (BT_SEQUENCE (user_data), pattern, 0,
+        G_MAXULONG);
+  }
+}
+
+static void
+bt_sequence_on_pattern_layout_changed (const BtPattern * pattern,
+    GParamSpec * const arg, gpointer user_data)
+{
+  bt_sequence_schedule_update_pattern (BT_SEQUENCE (user_data), pattern, 0,
+      G_MAXULONG);
+}
+
 //-- helper methods
 
 //-- constructor methods
@@ -637,13 +1250,16 @@ glong
 bt_sequence_get_track_by_machine (const BtSequence * const self,
     const BtMachine * const machine, gulong track)
 {
-  const gulong tracks = self->priv->tracks;
-  BtMachine **machines = self->priv->machines;
+  const GArray *const track_list =
+      g_hash_table_lookup (self->priv->machine_tracks, machine);
+  guint pos;
 
-  for (; track < tracks; track++) {
-    if (machines[track] == machine) {
-      return (glong) track;
-    }
+  if (!track_list)
+    return -1;
+
+  pos = bt_sequence_index_lower_bound (track_list, track);
+  if (pos < track_list->len) {
+    return (glong) g_array_index (track_list, gulong, pos);
   }
   return -1;
 }
@@ -667,12 +1283,10 @@ bt_sequence_get_tick_by_pattern (const BtSequence * const self, gulong track,
     const BtCmdPattern * const pattern, gulong tick)
 {
   const gulong length = self->priv->length;
-  const gulong tracks = self->priv->tracks;
-  gulong pos = tick * tracks + track;
-  BtCmdPattern **patterns = self->priv->patterns;
+  BtCmdPattern **const patterns = self->priv->track_data[track]->patterns;
 
-  for (; tick < length; tick++, pos += tracks) {
-    if (patterns[pos] == pattern) {
+  for (; tick < length; tick++) {
+    if (patterns[tick] == pattern) {
       return (glong) tick;
     }
   }
@@ -728,7 +1342,7 @@ bt_sequence_add_track (const BtSequence * const self,
   g_return_val_if_fail (BT_IS_SEQUENCE (self), FALSE);
   g_return_val_if_fail (BT_IS_MACHINE (machine), FALSE);
 
-  BtMachine **machines;
+  BtSequenceTrack **track_data;
   gulong tracks = self->priv->tracks + 1;
   const gulong pos = (ix == -1) ? self->priv->tracks : ix;
 
@@ -740,25 +1354,17 @@ bt_sequence_add_track (const BtSequence * const self,
 
   // enlarge
   g_object_set ((gpointer) self, "tracks", tracks, NULL);
-  machines = self->priv->machines;
+  track_data = self->priv->track_data;
   if (pos != (tracks - 1)) {
     // shift tracks to the right
-    BtCmdPattern **src, **dst;
-    const gulong count = tracks - pos;
-    const gulong length = self->priv->length;
-    gulong i;
-
-    src = &self->priv->patterns[pos];
-    dst = &self->priv->patterns[pos + 1];
-    for (i = 0; i < length; i++) {
-      memmove (dst, src, count * sizeof (gpointer));
-      src[count - 1] = NULL;
-      src = &src[tracks];
-      dst = &dst[tracks];
-    }
-    memmove (&machines[pos + 1], &machines[pos], count * sizeof (gpointer));
+    BtSequenceTrack *const new_track = track_data[tracks - 1];
+
+    memmove (&track_data[pos + 1], &track_data[pos],
+        ((tracks - 1) - pos) * sizeof (gpointer));
+    track_data[pos] = new_track;
   }
-  machines[pos] = g_object_ref ((gpointer) machine);
+  track_data[pos]->machine = g_object_ref ((gpointer) machine);
+  bt_sequence_update_machine_tracks (self);
 
   g_signal_emit ((gpointer) self, signals[TRACK_ADDED_EVENT], 0, machine, pos);
 
@@ -781,44 +1387,31 @@ gboolean
 bt_sequence_remove_track_by_ix (const BtSequence * const self, const gulong ix)
 {
   const gulong tracks = self->priv->tracks;
-  const gulong length = self->priv->length;
-  BtMachine **machines = self->priv->machines;
-  BtCmdPattern **src, **dst;
+  BtSequenceTrack **track_data = self->priv->track_data;
+  BtSequenceTrack *old_track;
   BtMachine *machine;
-  gulong i;
 
   g_return_val_if_fail (BT_IS_SEQUENCE (self), FALSE);
   g_return_val_if_fail (ix < tracks, FALSE);
 
   const gulong count = (tracks - 1) - ix;
-  machine = machines[ix];
+  old_track = track_data[ix];
+  machine = old_track->machine;
   GST_INFO ("remove track %lu/%lu (shift %lu tracks)", ix, tracks, count);
 
   g_signal_emit ((gpointer) self, signals[TRACK_REMOVED_EVENT], 0, machine, ix);
 
-  src = &self->priv->patterns[ix + 1];
-  dst = &self->priv->patterns[ix];
-  for (i = 0; i < length; i++) {
-    // unref patterns
-    if (*dst) {
-      GST_INFO ("unref pattern: %" G_OBJECT_REF_COUNT_FMT " at timeline %lu",
-          G_OBJECT_LOG_REF_COUNT (*dst), i);
-      bt_sequence_unuse_pattern (self, *dst);
-    }
-    if (count) {
-      memmove (dst, src, count * sizeof (gpointer));
-    }
-    src[count - 1] = NULL;
-    src = &src[tracks];
-    dst = &dst[tracks];
-  }
+  // unref patterns, we keep the machine ref until the end
+  old_track->machine = NULL;
+  bt_sequence_track_clear (self, old_track);
   if (count) {
-    memmove (&machines[ix], &machines[ix + 1], count * sizeof (gpointer));
+    memmove (&track_data[ix], &track_data[ix + 1], count * sizeof (gpointer));
   }
-  machines[tracks - 1] = NULL;
+  track_data[tracks - 1] = old_track;
 
   // this will resize the arrays
   g_object_set ((gpointer) self, "tracks", (gulong) (tracks - 1), NULL);
+  bt_sequence_schedule_update_machine (self, machine);
 
   GST_INFO_OBJECT (machine, "release machine %" G_OBJECT_REF_COUNT_FMT,
       G_OBJECT_LOG_REF_COUNT (machine));
@@ -838,25 +1431,18 @@ bt_sequence_remove_track_by_ix (const BtSequence * const self, const gulong ix)
 gboolean
 bt_sequence_move_track_left (const BtSequence * const self, const gulong track)
 {
-  const gulong tracks = self->priv->tracks;
-  const gulong length = self->priv->length;
-  BtCmdPattern **patterns = self->priv->patterns;
-  BtMachine **machines = self->priv->machines;
-  BtCmdPattern *pattern;
-  BtMachine *machine;
-  gulong i, ix = track;
+  BtSequenceTrack **const track_data = self->priv->track_data;
+  BtSequenceTrack *moved;
 
   g_return_val_if_fail (track > 0, FALSE);
 
-  for (i = 0; i < length; i++) {
-    pattern = patterns[ix];
-    patterns[ix] = patterns[ix - 1];
-    patterns[ix - 1] = pattern;
-    ix += tracks;
-  }
-  machine = machines[track];
-  machines[track] = machines[track - 1];
-  machines[track - 1] = machine;
+  moved = track_data[track];
+  track_data[track] = track_data[track - 1];
+  track_data[track - 1] = moved;
+  bt_sequence_update_machine_tracks (self);
+  // the later track wins, this only matters for tracks of the same machine
+  if (moved->machine == track_data[track]->machine)
+    bt_sequence_schedule_update_machine (self, moved->machine);
 
   return TRUE;
 }
@@ -874,24 +1460,18 @@ gboolean
 bt_sequence_move_track_right (const BtSequence * const self, const gulong track)
 {
   const gulong tracks = self->priv->tracks;
-  const gulong length = self->priv->length;
-  BtCmdPattern **patterns = self->priv->patterns;
-  BtMachine **machines = self->priv->machines;
-  BtCmdPattern *pattern;
-  BtMachine *machine;
-  gulong i, ix = track;
+  BtSequenceTrack **const track_data = self->priv->track_data;
+  BtSequenceTrack *moved;
 
   g_return_val_if_fail (track < (tracks - 1), FALSE);
 
-  for (i = 0; i < length; i++) {
-    pattern = patterns[ix];
-    patterns[ix] = patterns[ix + 1];
-    patterns[ix + 1] = pattern;
-    ix += tracks;
-  }
-  machine = machines[track];
-  machines[track] = machines[track + 1];
-  machines[track + 1] = machine;
+  moved = track_data[track];
+  track_data[track] = track_data[track + 1];
+  track_data[track + 1] = moved;
+  bt_sequence_update_machine_tracks (self);
+  // the later track wins, this only matters for tracks of the same machine
+  if (moved->machine == track_data[track]->machine)
+    bt_sequence_schedule_update_machine (self, moved->machine);
 
   return TRUE;
 }
@@ -966,6 +1546,7 @@ bt_sequence_set_label (const BtSequence * const self, const gulong time,
 
   g_free (self->priv->labels[time]);
   self->priv->labels[time] = g_strdup (label);
+  bt_sequence_index_set (self->priv->label_ticks, time, (label != NULL));
   bt_sequence_release_toc (self);
 
   g_signal_emit ((gpointer) self, signals[SEQUENCE_ROWS_CHANGED_EVENT], 0, time,
@@ -996,6 +1577,46 @@ bt_sequence_get_pattern (const BtSequence * const self, const gulong time,
               track)));
 }
 
+/**
+ * bt_sequence_get_playing_pattern:
+ * @self: the #BtSequence that holds the patterns
+ * @time: the requested time position
+ * @track: the requested track index
+ * @start: (out) (optional): location for the time position the returned
+ * pattern has been started at
+ *
+ * Fetches the pattern that was most recently started on @track at or before
+ * the given @time. This is the pattern that plays at @time, if @time is within
+ * the length of the pattern. The lookup uses an index and does not depend on
+ * how far @time is into the song.
+ *
+ * Returns: (transfer none): the #BtCmdPattern or %NULL if no pattern was
+ * started on this track so far.
+ *
+ * Since: 0.12
+ */
+BtCmdPattern *
+bt_sequence_get_playing_pattern (const BtSequence * const self,
+    const gulong time, const gulong track, gulong * start)
+{
+  const GArray *ticks;
+  gulong tick;
+  guint pos;
+
+  g_return_val_if_fail (BT_IS_SEQUENCE (self), NULL);
+  g_return_val_if_fail (track < self->priv->tracks, NULL);
+
+  ticks = self->priv->track_data[track]->pattern_ticks;
+  // find the first entry after time and take the one before
+  if (!(pos = bt_sequence_index_lower_bound (ticks, time + 1)))
+    return NULL;
+
+  tick = g_array_index (ticks, gulong, pos - 1);
+  if (start)
+    *start = tick;
+  return bt_sequence_get_pattern_unchecked (self, tick, track);
+}
+
 /**
  * bt_sequence_set_pattern_quick:
  * @self: the #BtSequence that holds the patterns
@@ -1015,26 +1636,32 @@ bt_sequence_set_pattern_quick (const BtSequence * const self, const gulong time,
     const gulong track, const BtCmdPattern * const pattern)
 {
   gboolean changed = FALSE;
-  const gulong index = time * self->priv->tracks + track;
-  BtCmdPattern *old_pattern = self->priv->patterns[index];
+  BtSequenceTrack *const track_data = self->priv->track_data[track];
+  BtCmdPattern *old_pattern = track_data->patterns[time];
 
   GST_DEBUG ("set pattern from %p to %p for time %lu, track %lu",
-      self->priv->patterns[index], pattern, time, track);
+      old_pattern, pattern, time, track);
 
   // take out the old pattern
   if (old_pattern) {
     bt_sequence_unuse_pattern (self, old_pattern);
 
     changed = TRUE;
-    self->priv->patterns[index] = NULL;
+    track_data->patterns[time] = NULL;
   }
   if (pattern) {
     bt_sequence_use_pattern (self, (BtCmdPattern *) pattern);
     // enter the new pattern
-    self->priv->patterns[index] = g_object_ref ((gpointer) pattern);
-    //g_object_add_weak_pointer((gpointer)pattern,(gpointer *)(&self->priv->patterns[index]));
+    track_data->patterns[time] = g_object_ref ((gpointer) pattern);
     changed = TRUE;
   }
+  if (changed) {
+    bt_sequence_index_update (self, time, track, (pattern != NULL));
+    if (self->priv->compiled && track_data->machine) {
+      bt_sequence_schedule_update_span (self, track_data->machine, time,
+          bt_sequence_get_next_pattern_tick (self, time, track));
+    }
+  }
   g_signal_emit ((gpointer) self, signals[SEQUENCE_ROWS_CHANGED_EVENT], 0, time,
       time);
   GST_DEBUG ("done: %d", changed);
@@ -1057,7 +1684,7 @@ bt_sequence_set_pattern (const BtSequence * const self, const gulong time,
   g_return_if_fail (BT_IS_SEQUENCE (self));
   g_return_if_fail (time < self->priv->len_patterns);
   g_return_if_fail (track < self->priv->tracks);
-  g_return_if_fail (self->priv->machines[track]);
+  g_return_if_fail (self->priv->track_data[track]->machine);
 
 #ifndef G_DISABLE_ASSERT
   if (pattern) {
@@ -1065,7 +1692,7 @@ bt_sequence_set_pattern (const BtSequence * const self, const gulong time,
 
     g_return_if_fail (BT_IS_CMD_PATTERN (pattern));
     g_object_get ((gpointer) pattern, "machine", &machine, NULL);
-    if (self->priv->machines[track] != machine) {
+    if (self->priv->track_data[track]->machine != machine) {
       GST_WARNING ("adding a pattern to a track with different machine!");
       g_object_unref (machine);
       return;
@@ -1139,6 +1766,71 @@ bt_sequence_is_pattern_used (const BtSequence * const self,
   return (bt_sequence_get_number_of_pattern_uses (self, pattern) > 0);
 }
 
+/*
+ * insert_label_rows:
+ * @self: the sequence
+ * @time: the postion to insert at
+ * @rows: the number of rows to insert
+ *
+ * Insert empty @rows into the labels. The labels that are pushed out at the end
+ * are dropped.
+ */
+static void
+insert_label_rows (const BtSequence * const self, const gulong time,
+    const gulong rows)
+{
+  gchar **const labels = self->priv->labels;
+  GArray *const ticks = self->priv->label_ticks;
+  const gulong length = self->priv->length;
+  guint i = bt_sequence_index_lower_bound (ticks, length - rows);
+
+  // free the labels that are pushed out
+  for (; i < ticks->len; i++) {
+    index_visits++;
+    g_free (labels[g_array_index (ticks, gulong, i)]);
+  }
+  memmove (&labels[time + rows], &labels[time],
+      ((length - rows) - time) * sizeof (gpointer));
+  memset (&labels[time], 0, rows * sizeof (gpointer));
+  bt_sequence_index_remove_range (ticks, length - rows, length);
+  bt_sequence_index_shift_range (ticks, time, length - rows, (glong) rows);
+  bt_sequence_release_toc (self);
+}
+
+/*
+ * delete_label_rows:
+ * @self: the sequence
+ * @time: the postion to delete
+ * @rows: the number of rows to remove
+ *
+ * Delete @rows from the labels. The rows at the end become empty.
+ */
+static void
+delete_label_rows (const BtSequence * const self, const gulong time,
+    const gulong rows)
+{
+  gchar **const labels = self->priv->labels;
+  GArray *const ticks = self->priv->label_ticks;
+  const gulong length = self->priv->length;
+  guint i = bt_sequence_index_lower_bound (ticks, time);
+
+  // free the labels that are deleted
+  for (; i < ticks->len; i++) {
+    const gulong tick = g_array_index (ticks, gulong, i);
+
+    index_visits++;
+    if (tick >= time + rows)
+      break;
+    g_free (labels[tick]);
+  }
+  memmove (&labels[time], &labels[time + rows],
+      ((length - rows) - time) * sizeof (gpointer));
+  memset (&labels[length - rows], 0, rows * sizeof (gpointer));
+  bt_sequence_index_remove_range (ticks, time, time + rows);
+  bt_sequence_index_shift_range (ticks, time + rows, length, -(glong) rows);
+  bt_sequence_release_toc (self);
+}
+
 /*
  * insert_rows:
  * @self: the sequence
@@ -1152,40 +1844,35 @@ static void
 insert_rows (const BtSequence * const self, const gulong time,
     const gulong track, const gulong rows)
 {
-  BtSequencePrivate *p = self->priv;
-  const gulong tracks = p->tracks;
-  const gulong length = p->length;
-  BtCmdPattern **src = &p->patterns[track + tracks * (length - (1 + rows))];
-  BtCmdPattern **dst = &p->patterns[track + tracks * (length - 1)];
-  BtCmdPattern **clr = &src[tracks];
-  gulong i;
-
-  /* ins 3     0 1
-   * 0 a       a a
-   * 1 b       b b
-   * 2 c       c c
-   * 3 d       d d
-   * 4 e src   e .
-   * 5 f    \  - .
-   * 6 g     v - .
-   * 7 h dst . - e
+  BtSequenceTrack *const track_data = self->priv->track_data[track];
+  BtCmdPattern **const patterns = track_data->patterns;
+  const gulong length = self->priv->length;
+  const gulong end = MIN (time + rows, length);
+
+  /* ins 3
+   * 0 a       a
+   * 1 b       b
+   * 2 c       c
+   * 3 d       .
+   * 4 e  \    .
+   * 5 f   |   .
+   * 6 g   |   d
+   * 7 h   v   e
    */
 
   /* we're pushing out the last @rows rows */
-  for (i = 0; i < rows; i++) {
-    if (*clr) {
-      bt_sequence_unuse_pattern (self, *clr);
-      *clr = NULL;
-    }
-    clr += tracks;
-  }
-  /* copy patterns and move upwards */
-  for (i = (length - 1); i >= (time + rows); i--) {
-    *dst = *src;
-    *src = NULL;
-    src -= tracks;
-    dst -= tracks;
+  bt_sequence_track_unuse_range (self, track_data, length - rows, length);
+  /* move patterns upwards and clear the gap */
+  if (end < length) {
+    memmove (&patterns[end], &patterns[time],
+        (length - end) * sizeof (gpointer));
   }
+  memset (&patterns[time], 0, (end - time) * sizeof (gpointer));
+  /* do the same on the tick index */
+  bt_sequence_index_remove_range (track_data->pattern_ticks, length - rows,
+      length);
+  bt_sequence_index_shift_range (track_data->pattern_ticks, time,
+      length - rows, (glong) rows);
 }
 
 /**
@@ -1211,20 +1898,13 @@ bt_sequence_insert_rows (const BtSequence * const self, const gulong time,
 
   if (track > -1) {
     insert_rows (self, time, track, rows);
-  } else {
-    gulong j = 0;
-    gchar **const labels = self->priv->labels;
+    BtMachine *const machine = bt_sequence_get_machine_unchecked (self, track);
 
-    // shift label down
-    for (j = length - rows; j < length; j++) {
-      g_free (labels[j]);
+    if (self->priv->compiled && machine) {
+      bt_sequence_schedule_update_span (self, machine, time, length);
     }
-    memmove (&labels[time + rows], &labels[time],
-        ((length - rows) - time) * sizeof (gpointer));
-    for (j = 0; j < rows; j++) {
-      labels[time + j] = NULL;
-    }
-    bt_sequence_release_toc (self);
+  } else {
+    insert_label_rows (self, time, rows);
   }
   g_signal_emit ((gpointer) self, signals[SEQUENCE_ROWS_CHANGED_EVENT], 0, time,
       length);
@@ -1249,23 +1929,17 @@ bt_sequence_insert_full_rows (const BtSequence * const self, const gulong time,
   const gulong tracks = self->priv->tracks;
   const gulong length = self->priv->length;
   gulong j = 0;
-  gchar **labels;               // don't take the pointer yet, we realloc
 
   GST_DEBUG ("insert %lu full-rows at %lu / %lu", rows, time, length);
 
   g_object_set ((gpointer) self, "length", length + rows, NULL);
 
-  // shift label down
-  labels = self->priv->labels;
-  memmove (&labels[time + rows], &labels[time],
-      ((length - rows) - time) * sizeof (gpointer));
-  for (j = 0; j < rows; j++) {
-    labels[time + j] = NULL;
-  }
+  // shift label down, this pushes out the new empty rows at the end
+  insert_label_rows (self, time, rows);
   for (j = 0; j < tracks; j++) {
     insert_rows (self, time, j, rows);
   }
-  bt_sequence_release_toc (self);
+  bt_sequence_schedule_update_all (self);
   g_signal_emit ((gpointer) self, signals[SEQUENCE_ROWS_CHANGED_EVENT], 0, time,
       length + rows);
 }
@@ -1283,50 +1957,36 @@ static void
 delete_rows (const BtSequence * const self, const gulong time,
     const gulong track, const gulong rows)
 {
-  const gulong tracks = self->priv->tracks;
+  BtSequenceTrack *const track_data = self->priv->track_data[track];
+  BtCmdPattern **const patterns = track_data->patterns;
   const gulong length = self->priv->length;
-  BtCmdPattern **src = &self->priv->patterns[track + tracks * (time + rows)];
-  BtCmdPattern **dst = &self->priv->patterns[track + tracks * time];
-  gulong i;
-
-  /* del 3     0 1 2 3 4 5
-   * 0 a dst d d d d d d d
-   * 1 b     ^ b e e e e e
-   * 2 c    /  c c f f f r
-   * 3 d src   d d d g g g
-   * 4 e       e e e e h h
-   * 5 f       f f f f f .
-   * 6 g       g g g g g .
-   * 7 h       h h h h h .
-   */
-  // not sure why we need the final loop and can't use this scheme
-  /* del 3     0 1 2 3 4
-   * 0 a dst d d d d d d
-   * 1 b     ^ b e e e e
-   * 2 c    /  c c f f f
-   * 3 d src   . . . g g
-   * 4 e       e . . . h
-   * 5 f       f f . . .
-   * 6 g       g g g . .
-   * 7 h       h h h h .
+  const gulong end = MIN (time + rows, length);
+
+  /* del 3
+   * 0 a       a
+   * 1 b       b
+   * 2 c       c
+   * 3 d   ^   g
+   * 4 e   |   h
+   * 5 f   |   .
+   * 6 g  /    .
+   * 7 h       .
    */
 
   /* we're overwriting these */
-  for (i = 0; i < rows; i++) {
-    if (dst[i * tracks])
-      bt_sequence_unuse_pattern (self, dst[i * tracks]);
-  }
-  /* copy patterns and move downwards */
-  for (i = time; i < (length - rows); i++) {
-    *dst = *src;
-    //*src=NULL;
-    src += tracks;
-    dst += tracks;
-  }
-  for (i = 0; i < rows; i++) {
-    *dst = NULL;
-    dst += tracks;
+  bt_sequence_track_unuse_range (self, track_data, time, end);
+  /* move patterns downwards and clear the tail */
+  if (end < length) {
+    memmove (&patterns[time], &patterns[end],
+        (length - end) * sizeof (gpointer));
   }
+  memset (&patterns[length - (end - time)], 0,
+      (end - time) * sizeof (gpointer));
+  /* do the same on the tick index */
+  bt_sequence_index_remove_range (track_data->pattern_ticks, time,
+      time + rows);
+  bt_sequence_index_shift_range (track_data->pattern_ticks, time + rows,
+      length, -(glong) rows);
 }
 
 /**
@@ -1352,20 +2012,13 @@ bt_sequence_delete_rows (const BtSequence * const self, const gulong time,
 
   if (track > -1) {
     delete_rows (self, time, track, rows);
-  } else {
-    gulong j = 0;
-    gchar **const labels = self->priv->labels;
+    BtMachine *const machine = bt_sequence_get_machine_unchecked (self, track);
 
-    // shift label up
-    for (j = 0; j < rows; j++) {
-      g_free (labels[time + j]);
+    if (self->priv->compiled && machine) {
+      bt_sequence_schedule_update_span (self, machine, time, length);
     }
-    memmove (&labels[time], &labels[time + rows],
-        ((length - rows) - time) * sizeof (gpointer));
-    for (j = length - rows; j < length; j++) {
-      labels[j] = NULL;
-    }
-    bt_sequence_release_toc (self);
+  } else {
+    delete_label_rows (self, time, rows);
   }
   g_signal_emit ((gpointer) self, signals[SEQUENCE_ROWS_CHANGED_EVENT], 0, time,
       rows);
@@ -1390,19 +2043,11 @@ bt_sequence_delete_full_rows (const BtSequence * const self, const gulong time,
   const gulong tracks = self->priv->tracks;
   const gulong length = self->priv->length;
   gulong j = 0;
-  gchar **const labels = self->priv->labels;
 
   GST_DEBUG ("delete %lu full-rows at %lu / %lu", rows, time, length);
 
   // shift label up
-  for (j = 0; j < rows; j++) {
-    g_free (labels[time + j]);
-  }
-  memmove (&labels[time], &labels[time + rows],
-      ((length - rows) - time) * sizeof (gpointer));
-  for (j = length - rows; j < length; j++) {
-    labels[j] = NULL;
-  }
+  delete_label_rows (self, time, rows);
   for (j = 0; j < tracks; j++) {
     bt_sequence_delete_rows (self, time, j, rows);
   }
@@ -1415,6 +2060,77 @@ bt_sequence_delete_full_rows (const BtSequence * const self, const gulong time,
       length - rows);
 }
 
+/*
+ * bt_sequence_is_compiled:
+ * @self: the sequence
+ *
+ * Check if the sequence maintains a precompiled event schedule, see
+ * #BtSequence:compiled.
+ *
+ * Returns: %TRUE if bt_sequence_get_scheduled_value() can be used
+ */
+gboolean
+bt_sequence_is_compiled (const BtSequence * const self)
+{
+  return self->priv->compiled;
+}
+
+/*
+ * bt_sequence_get_scheduled_value:
+ * @self: the sequence
+ * @machine: the machine that owns the @param_group
+ * @param_group: the parameter group
+ * @param: the parameter index in the @param_group
+ * @tick: the time position
+ * @value: an initialized #GValue to copy the event value to
+ *
+ * Look up the value the sequence sets for a parameter at the given @tick from
+ * the compiled schedule. Ticks beyond the song length map to the start of the
+ * song like in idle mode. This can be called from the streaming threads.
+ *
+ * Returns: %TRUE if there is an event and the @value has been set
+ */
+gboolean
+bt_sequence_get_scheduled_value (const BtSequence * const self,
+    const BtMachine * const machine, const BtParameterGroup * const param_group,
+    const gulong param, gulong tick, GValue * const value)
+{
+  const GArray *schedule;
+  gboolean res = FALSE;
+  guint pos;
+
+  if (tick >= self->priv->length)
+    tick = 0;
+
+  g_mutex_lock ((GMutex *) & self->priv->schedule_lock);
+  if ((schedule = g_hash_table_lookup (self->priv->schedules, machine))) {
+    for (pos = bt_sequence_schedule_lower_bound (schedule, tick);
+        pos < schedule->len; pos++) {
+      const BtSequenceEvent *const ev =
+          &g_array_index (schedule, BtSequenceEvent, pos);
+
+      if (ev->tick != tick || ev->param_group > param_group)
+        break;
+      if (ev->param_group == param_group && ev->param == param) {
+        g_value_copy (&ev->value, value);
+        res = TRUE;
+        break;
+      }
+    }
+  }
+  g_mutex_unlock ((GMutex *) & self->priv->schedule_lock);
+  return res;
+}
+
+//-- debug helper
+
+// number of tick index entries looked at by the edits so far (all sequences)
+gulong
+bt_sequence_dbg_get_index_visits (void)
+{
+  return index_visits;
+}
+
 //-- io interface
 
 static xmlNodePtr
@@ -1424,8 +2140,7 @@ bt_sequence_persistence_save (const BtPersistence * const persistence,
   BtSequence *const self = BT_SEQUENCE (persistence);
   const gulong tracks = self->priv->tracks;
   const gulong length = self->priv->len_patterns;
-  BtCmdPattern **patterns = self->priv->patterns;
-  BtMachine **machines = self->priv->machines;
+  BtSequenceTrack **const track_data = self->priv->track_data;
   gchar **const labels = self->priv->labels;
   xmlNodePtr node = NULL;
   xmlNodePtr child_node, child_node2, child_node3;
@@ -1470,7 +2185,7 @@ bt_sequence_persistence_save (const BtPersistence * const persistence,
       for (j = 0; j < tracks; j++) {
         child_node2 =
             xmlNewChild (child_node, NULL, XML_CHAR_PTR ("track"), NULL);
-        machine = machines[j];
+        machine = track_data[j]->machine;
         g_object_get (machine, "id", &machine_id, NULL);
         xmlNewProp (child_node2, XML_CHAR_PTR ("index"),
             XML_CHAR_PTR (bt_str_format_ulong (j)));
@@ -1480,7 +2195,7 @@ bt_sequence_persistence_save (const BtPersistence * const persistence,
         // iterate over timelines
         for (i = 0; i < length; i++) {
           // get pattern
-          pattern = patterns[i * tracks + j];
+          pattern = track_data[j]->patterns[i];
           if (pattern) {
             g_object_get (pattern, "name", &pattern_name, NULL);
             child_node3 =
@@ -1530,6 +2245,8 @@ bt_sequence_persistence_load (const GType type,
   xmlChar *const loop_end_str = xmlGetProp (node, XML_CHAR_PTR ("loop-end"));
 
   const gulong length = length_str ? atol ((char *) length_str) : 0;
+  const gulong len_patterns =
+      len_patterns_str ? atol ((char *) len_patterns_str) : length;
   const gulong tracks = tracks_str ? atol ((char *) tracks_str) : 0;
   const gulong loop_start =
       loop_start_str ? atol ((char *) loop_start_str) : -1;
@@ -1538,8 +2255,16 @@ bt_sequence_persistence_load (const GType type,
       loop_str ? !strncasecmp ((char *) loop_str, "on\0", 3) : FALSE;
 
   // also sets self->priv->len_patterns
-  bt_sequence_resize_data_length (self,
-      len_patterns_str ? atol ((char *) len_patterns_str) : length);
+  if (!bt_sequence_resize_data_length (self, len_patterns)) {
+    GST_WARNING ("can't allocate a sequence of %lu rows", len_patterns);
+    xmlFree (length_str);
+    xmlFree (len_patterns_str);
+    xmlFree (tracks_str);
+    xmlFree (loop_str);
+    xmlFree (loop_start_str);
+    xmlFree (loop_end_str);
+    return NULL;
+  }
 
   // Can't set the "length" object property here, because pattern resizing logic will also
   // run. As track data is empty so far, the sequence will be truncated if any patterns
@@ -1550,6 +2275,7 @@ bt_sequence_persistence_load (const GType type,
   g_object_set (self, "tracks", tracks, "loop", loop, "loop-start", loop_start,
       "loop-end", loop_end, NULL);
   xmlFree (length_str);
+  xmlFree (len_patterns_str);
   xmlFree (tracks_str);
   xmlFree (loop_str);
   xmlFree (loop_start_str);
@@ -1593,7 +2319,7 @@ bt_sequence_persistence_load (const GType type,
               GST_INFO ("add track for machine %" G_OBJECT_REF_COUNT_FMT
                   " at position %lu", G_OBJECT_LOG_REF_COUNT (machine), index);
               if (index < tracks) {
-                self->priv->machines[index] = machine;
+                self->priv->track_data[index]->machine = machine;
                 g_signal_emit ((gpointer) self, signals[TRACK_ADDED_EVENT], 0,
                     machine, index);
                 GST_DEBUG ("loading track with index=%s for machine=\"%s\"",
@@ -1631,7 +2357,7 @@ bt_sequence_persistence_load (const GType type,
                     xmlFree (time_str);
                   }
                 }
-                // we keep the ref in self->priv->machines[index]
+                // we keep the ref in self->priv->track_data[index]
               } else {
                 GST_WARNING ("index beyond tracks: %lu>=%lu", index, tracks);
                 g_object_unref (machine);
@@ -1645,6 +2371,7 @@ bt_sequence_persistence_load (const GType type,
           }
         }
         g_object_unref (setup);
+        bt_sequence_update_machine_tracks (self);
       } else if (!strncmp ((gchar *) node->name, "properties\0", 11)) {
         bt_persistence_load_hashtable (self->priv->properties, node);
       }
@@ -1708,6 +2435,9 @@ bt_sequence_get_property (GObject * const object, const guint property_id,
     case SEQUENCE_LEN_PATTERNS:
       g_value_set_ulong (value, self->priv->len_patterns);
       break;
+    case SEQUENCE_COMPILED:
+      g_value_set_boolean (value, self->priv->compiled);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, property_id, pspec);
       break;
@@ -1735,9 +2465,12 @@ bt_sequence_set_property (GObject * const object, const guint property_id,
       self->priv->length = g_value_get_ulong (value);
       if (length != self->priv->length) {
         GST_DEBUG ("set the length for sequence: %lu", self->priv->length);
-        bt_sequence_resize_data_length (self, self->priv->length);
+        if (!bt_sequence_resize_data_length (self, self->priv->length)) {
+          self->priv->length = length;
+        }
       }
       bt_sequence_post_length_change (self, length);
+      bt_sequence_schedule_update_all (self);
       break;
     }
     case SEQUENCE_TRACKS:{
@@ -1814,6 +2547,21 @@ bt_sequence_set_property (GObject * const object, const guint property_id,
           -1) ? self->priv->loop_end : self->priv->length;
       bt_sequence_limit_play_pos_internal (self);
       break;
+    case SEQUENCE_COMPILED:{
+      const gboolean compiled = g_value_get_boolean (value);
+      if (compiled != self->priv->compiled) {
+        GST_DEBUG ("set compiled for sequence: %d", compiled);
+        self->priv->compiled = compiled;
+        if (compiled) {
+          bt_sequence_schedule_update_all (self);
+        } else {
+          g_mutex_lock ((GMutex *) & self->priv->schedule_lock);
+          g_hash_table_remove_all (self->priv->schedules);
+          g_mutex_unlock ((GMutex *) & self->priv->schedule_lock);
+        }
+      }
+      break;
+    }
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, property_id, pspec);
       break;
@@ -1826,36 +2574,27 @@ bt_sequence_dispose (GObject * const object)
   BtSequence *const self = BT_SEQUENCE (object);
   const gulong tracks = self->priv->tracks;
   const gulong length = self->priv->len_patterns;
-  BtCmdPattern **patterns = self->priv->patterns;
-  BtMachine **machines = self->priv->machines;
   gchar **const labels = self->priv->labels;
-  gulong i, j, k;
+  gulong i;
 
   return_if_disposed ();
   self->priv->dispose_has_run = TRUE;
 
   GST_DEBUG ("!!!! self=%p", self);
   g_object_try_weak_unref (self->priv->song);
-  // unref the machines
-  GST_DEBUG ("unref %lu machines", tracks);
+  // unref the machines and patterns
+  GST_DEBUG ("unref %lu tracks", tracks);
   for (i = 0; i < tracks; i++) {
-    GST_INFO ("releasing machine %" G_OBJECT_REF_COUNT_FMT,
-        G_OBJECT_LOG_REF_COUNT (machines[i]));
-    g_object_try_unref (machines[i]);
+    bt_sequence_track_clear (self, self->priv->track_data[i]);
   }
   // free the labels
   for (i = 0; i < length; i++) {
     g_free (labels[i]);
   }
-  // unref the patterns
-  for (k = i = 0; i < length; i++) {
-    for (j = 0; j < tracks; j++, k++) {
-      if (patterns[k])
-        bt_sequence_unuse_pattern (self, patterns[k]);
-    }
-  }
 
   bt_sequence_release_toc (self);
+  g_hash_table_remove_all (self->priv->machine_tracks);
+  g_hash_table_remove_all (self->priv->schedules);
 
   GST_DEBUG ("  chaining up");
   G_OBJECT_CLASS (bt_sequence_parent_class)->dispose (object);
@@ -1866,12 +2605,23 @@ static void
 bt_sequence_finalize (GObject * const object)
 {
   const BtSequence *const self = BT_SEQUENCE (object);
+  gulong i;
 
   GST_DEBUG ("!!!! self=%p", self);
 
-  g_free (self->priv->machines);
+  for (i = 0; i < self->priv->tracks; i++) {
+    BtSequenceTrack *const track = self->priv->track_data[i];
+
+    g_array_free (track->pattern_ticks, TRUE);
+    g_free (track->patterns);
+    g_free (track);
+  }
+  g_free (self->priv->track_data);
   g_free (self->priv->labels);
-  g_free (self->priv->patterns);
+  g_array_free (self->priv->label_ticks, TRUE);
+  g_hash_table_destroy (self->priv->machine_tracks);
+  g_hash_table_destroy (self->priv->schedules);
+  g_mutex_clear (&self->priv->schedule_lock);
   g_hash_table_destroy (self->priv->pattern_usage);
   g_hash_table_destroy (self->priv->properties);
 
@@ -1889,6 +2639,12 @@ bt_sequence_init (BtSequence * self)
   self->priv->loop_start = -1;
   self->priv->loop_end = -1;
   self->priv->pattern_usage = g_hash_table_new (NULL, NULL);
+  self->priv->label_ticks = g_array_new (FALSE, FALSE, sizeof (gulong));
+  self->priv->machine_tracks = g_hash_table_new_full (NULL, NULL, NULL,
+      (GDestroyNotify) g_array_unref);
+  self->priv->schedules = g_hash_table_new_full (NULL, NULL, NULL,
+      (GDestroyNotify) g_array_unref);
+  g_mutex_init (&self->priv->schedule_lock);
   self->priv->properties =
       g_hash_table_new_full (g_str_hash, g_str_equal, g_free, g_free);
 }
@@ -2055,4 +2811,19 @@ bt_sequence_class_init (BtSequenceClass * const klass)
       g_param_spec_pointer ("toc", "toc prop",
           "TOC containing the labels",
           G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+
+  /**
+   * BtSequence:compiled:
+   *
+   * When enabled the sequence flattens the pattern data of each machine into a
+   * sorted per tick event schedule. The controllers then look up values with a
+   * single binary search instead of walking all tracks and patterns. Edits to
+   * the sequence and the patterns are applied to the schedule incrementally.
+   *
+   * Since: 0.12
+   */
+  g_object_class_install_property (gobject_class, SEQUENCE_COMPILED,
+      g_param_spec_boolean ("compiled", "compiled prop",
+          "use a precompiled event schedule for playback",
+          FALSE, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 }
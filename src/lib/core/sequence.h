@@ -73,6 +73,7 @@ gboolean bt_sequence_move_track_right(const BtSequence * const self, const gulon
 gchar *bt_sequence_get_label(const BtSequence * const self, const gulong time);
 void bt_sequence_set_label(const BtSequence * const self, const gulong time, const gchar * const label);
 BtCmdPattern *bt_sequence_get_pattern(const BtSequence * const self, const gulong time, const gulong track);
+BtCmdPattern *bt_sequence_get_playing_pattern(const BtSequence * const self, const gulong time, const gulong track, gulong *start);
 gboolean bt_sequence_set_pattern_quick(const BtSequence * const self, const gulong time, const gulong track, const BtCmdPattern * const pattern);
 void bt_sequence_set_pattern(const BtSequence * const self, const gulong time, const gulong track, const BtCmdPattern * const pattern);
 
@@ -88,6 +89,6 @@ void bt_sequence_delete_full_rows(const BtSequence * const self, const gulong ti
 
 // This should only be needed by functions such as sequence data paste.
 // It should ideally not be exposed at all, but this will do for now.
-void bt_sequence_resize_data_length (const BtSequence * const self, const gulong length);
+gboolean bt_sequence_resize_data_length (const BtSequence * const self, const gulong length);
 
 #endif // BT_SEQUENCE_H
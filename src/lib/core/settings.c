@@ -75,6 +75,12 @@ enum
   BT_SETTINGS_SAMPLE_RATE,
   BT_SETTINGS_CHANNELS,
   BT_SETTINGS_LATENCY,
+  BT_SETTINGS_REALTIME_POLICY,
+  BT_SETTINGS_REALTIME_PRIORITY,
+  BT_SETTINGS_CPU_AFFINITY,
+  BT_SETTINGS_RECORD_QUALITY,
+  BT_SETTINGS_RECORD_BITRATE,
+  BT_SETTINGS_RECORD_THREADS,
   BT_SETTINGS_PLAYBACK_CONTROLLER_COHERENCE_UPNP_ACTIVE,
   BT_SETTINGS_PLAYBACK_CONTROLLER_COHERENCE_UPNP_PORT,
   BT_SETTINGS_PLAYBACK_CONTROLLER_JACK_TRANSPORT_MASTER,
@@ -178,7 +184,6 @@ read_boolean (GSettings * settings, const gchar * path, GValue * const value)
   g_value_set_boolean (value, prop);
 }
 
-#if 0
 static void
 read_int (GSettings * settings, const gchar * path, GValue * const value)
 {
@@ -186,7 +191,6 @@ read_int (GSettings * settings, const gchar * path, GValue * const value)
   GST_DEBUG ("application reads '%s' : '%i'", path, prop);
   g_value_set_int (value, prop);
 }
-#endif
 
 static void
 read_int_def (GSettings * settings, const gchar * path, GValue * const value,
@@ -657,6 +661,27 @@ bt_settings_get_property (GObject * const object, const guint property_id,
       read_uint_def (self->priv->org_buzztrax_audio, "latency", value,
           (GParamSpecUInt *) pspec);
       break;
+    case BT_SETTINGS_REALTIME_POLICY:
+      read_string_def (self->priv->org_buzztrax_audio, "realtime-policy", value,
+          (GParamSpecString *) pspec);
+      break;
+    case BT_SETTINGS_REALTIME_PRIORITY:
+      read_uint_def (self->priv->org_buzztrax_audio, "realtime-priority", value,
+          (GParamSpecUInt *) pspec);
+      break;
+    case BT_SETTINGS_CPU_AFFINITY:
+      read_string_def (self->priv->org_buzztrax_audio, "cpu-affinity", value,
+          (GParamSpecString *) pspec);
+      break;
+    case BT_SETTINGS_RECORD_QUALITY:
+      read_int (self->priv->org_buzztrax_audio, "record-quality", value);
+      break;
+    case BT_SETTINGS_RECORD_BITRATE:
+      read_uint (self->priv->org_buzztrax_audio, "record-bitrate", value);
+      break;
+    case BT_SETTINGS_RECORD_THREADS:
+      read_uint (self->priv->org_buzztrax_audio, "record-threads", value);
+      break;
       /* playback controller */
     case BT_SETTINGS_PLAYBACK_CONTROLLER_COHERENCE_UPNP_ACTIVE:
       read_boolean (self->priv->org_buzztrax_playback_controller,
@@ -784,6 +809,24 @@ bt_settings_set_property (GObject * const object, const guint property_id,
     case BT_SETTINGS_LATENCY:
       write_uint (self->priv->org_buzztrax_audio, "latency", value);
       break;
+    case BT_SETTINGS_REALTIME_POLICY:
+      write_string (self->priv->org_buzztrax_audio, "realtime-policy", value);
+      break;
+    case BT_SETTINGS_REALTIME_PRIORITY:
+      write_uint (self->priv->org_buzztrax_audio, "realtime-priority", value);
+      break;
+    case BT_SETTINGS_CPU_AFFINITY:
+      write_string (self->priv->org_buzztrax_audio, "cpu-affinity", value);
+      break;
+    case BT_SETTINGS_RECORD_QUALITY:
+      write_int (self->priv->org_buzztrax_audio, "record-quality", value);
+      break;
+    case BT_SETTINGS_RECORD_BITRATE:
+      write_uint (self->priv->org_buzztrax_audio, "record-bitrate", value);
+      break;
+    case BT_SETTINGS_RECORD_THREADS:
+      write_uint (self->priv->org_buzztrax_audio, "record-threads", value);
+      break;
       /* playback controller */
     case BT_SETTINGS_PLAYBACK_CONTROLLER_COHERENCE_UPNP_ACTIVE:
       write_boolean (self->priv->org_buzztrax_playback_controller,
@@ -966,6 +1009,38 @@ bt_settings_class_init (BtSettingsClass * const klass)
           "target audio latency in ms", 1, 200, 30,
           G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 
+  g_object_class_install_property (gobject_class, BT_SETTINGS_REALTIME_POLICY,
+      g_param_spec_string ("realtime-policy", "realtime-policy prop",
+          "scheduling policy for the audio threads: none, fifo or rr", "none",
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  g_object_class_install_property (gobject_class,
+      BT_SETTINGS_REALTIME_PRIORITY, g_param_spec_uint ("realtime-priority",
+          "realtime-priority prop",
+          "priority of the audio threads for realtime scheduling", 1, 99, 10,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  g_object_class_install_property (gobject_class, BT_SETTINGS_CPU_AFFINITY,
+      g_param_spec_string ("cpu-affinity", "cpu-affinity prop",
+          "cpus for the audio threads: empty for no change, 'spread' to pin "
+          "each thread to the next cpu or a list like '0,2-3'", "",
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  g_object_class_install_property (gobject_class, BT_SETTINGS_RECORD_QUALITY,
+      g_param_spec_int ("record-quality", "record-quality prop",
+          "encoder quality in percent, -1 for the encoder default", -1, 100,
+          -1, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  g_object_class_install_property (gobject_class, BT_SETTINGS_RECORD_BITRATE,
+      g_param_spec_uint ("record-bitrate", "record-bitrate prop",
+          "encoder bitrate in kbit/s, 0 for the encoder default", 0, 10000, 0,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  g_object_class_install_property (gobject_class, BT_SETTINGS_RECORD_THREADS,
+      g_param_spec_uint ("record-threads", "record-threads prop",
+          "threads for multi-threaded encoders, 0 for one per cpu", 0, 256, 0,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
   // playback controller
   g_object_class_install_property (gobject_class,
       BT_SETTINGS_PLAYBACK_CONTROLLER_COHERENCE_UPNP_ACTIVE,
@@ -257,9 +257,11 @@
  *   is closest to the sink
  * - as we operate push based, we use GST_PAD_PROBE_TYPE_BLOCK_DOWNSTREAM
  */
-/* TODO(ensonic):
- * - each time we/add remove a wire, we update the whole graph. Would be nice
- *   to avoid this when loading songs.
+/* Each time we add/remove a wire, we update the whole graph. When loading
+ * songs, the loaders wrap the construction in bt_setup_begin_update() and
+ * bt_setup_commit_update(). Adding wires in between only records them and
+ * the commit runs one check_connected() pass and links all connected elements
+ * in topological order.
  */
 
 // play safe when updating the song pipeline, if disabled we use pad-probes
@@ -370,6 +372,10 @@ struct _BtSetupPrivate
 #endif
   /* lock to sync the parallel pipeline update */
   GMutex update_mutex;
+  /* nesting level of bt_setup_begin_update() and whether a pipeline update was
+   * deferred */
+  guint update_level;
+  gboolean update_pending;
 };
 
 static guint signals[LAST_SIGNAL] = { 0, };
@@ -1368,6 +1374,23 @@ bt_setup_update_pipeline (const BtSetup * const self)
   return res;
 }
 
+/*
+ * bt_setup_sync_pipeline:
+ *
+ * Run bt_setup_update_pipeline() and wait for the update to be done.
+ */
+static void
+bt_setup_sync_pipeline (const BtSetup * const self)
+{
+  self->priv->update_pending = FALSE;
+  bt_setup_update_pipeline (self);
+
+  // here we have to *wait* for async_{add_to,remove_from}_pipeline() to be
+  // done.
+  g_mutex_lock (&self->priv->update_mutex);
+  g_mutex_unlock (&self->priv->update_mutex);
+}
+
 //-- public methods
 
 /**
@@ -1446,11 +1469,21 @@ bt_setup_add_wire (const BtSetup * const self, const BtWire * const wire)
     src->src_wires = g_list_prepend (src->src_wires, (gpointer) wire);
     dst->dst_wires = g_list_prepend (dst->dst_wires, (gpointer) wire);
     set_disconnected (self, GST_BIN (wire));
-    bt_setup_update_pipeline (self);
-
-    // here we have to *wait* for async_add_to_pipeline() to be done.
-    g_mutex_lock (&self->priv->update_mutex);
-    g_mutex_unlock (&self->priv->update_mutex);
+    if (self->priv->update_level) {
+      gboolean is_playing;
+
+      // while playing we don't defer, the pad-blocking for the dynamic updates
+      // is done per wire
+      g_object_get (self->priv->song, "is-playing", &is_playing, NULL);
+      if (!is_playing) {
+        GST_DEBUG_OBJECT (wire, "defer pipeline update");
+        self->priv->update_pending = TRUE;
+      } else {
+        bt_setup_sync_pipeline (self);
+      }
+    } else {
+      bt_setup_sync_pipeline (self);
+    }
 
     g_signal_emit ((gpointer) self, signals[WIRE_ADDED_EVENT], 0, wire);
     GST_DEBUG_OBJECT (wire, "added wire: %" G_OBJECT_REF_COUNT_FMT,
@@ -1542,15 +1575,22 @@ bt_setup_remove_wire (const BtSetup * const self, const BtWire * const wire)
         G_OBJECT_LOG_REF_COUNT (src));
     GST_DEBUG_OBJECT (dst, "wire.dst: %" G_OBJECT_REF_COUNT_FMT,
         G_OBJECT_LOG_REF_COUNT (dst));
-    g_object_unref (src);
-    g_object_unref (dst);
 
+    // apply deferred additions first, we can't add and remove in one update
+    if (self->priv->update_pending) {
+      bt_setup_sync_pipeline (self);
+    }
     set_disconnecting (self, GST_BIN (wire));
-    bt_setup_update_pipeline (self);
+    bt_setup_sync_pipeline (self);
 
-    // here we have to *wait* for async_remove_from_pipeline() to be done.
-    g_mutex_lock (&self->priv->update_mutex);
-    g_mutex_unlock (&self->priv->update_mutex);
+    // a single remaining wire from src does not need its queue anymore
+    if (src->src_wires && !src->src_wires->next) {
+      if (!bt_wire_update_queue ((BtWire *) src->src_wires->data)) {
+        GST_WARNING_OBJECT (src, "failed to relink the remaining wire");
+      }
+    }
+    g_object_unref (src);
+    g_object_unref (dst);
 
     self->priv->wires = g_list_delete_link (self->priv->wires, node);
 
@@ -1579,6 +1619,52 @@ bt_setup_remove_wire (const BtSetup * const self, const BtWire * const wire)
   }
 }
 
+/**
+ * bt_setup_begin_update:
+ * @self: the setup
+ *
+ * Start a batch of changes to the setup. Until the matching
+ * bt_setup_commit_update() adding wires won't update the pipeline. Calls can be
+ * nested, the pipeline is updated when the outermost batch is committed.
+ *
+ * Use this when adding many wires at once, e.g. when loading a song. Changes
+ * that are made while the song is playing are not deferred.
+ *
+ * Since: 0.12
+ */
+void
+bt_setup_begin_update (const BtSetup * const self)
+{
+  g_return_if_fail (BT_IS_SETUP (self));
+
+  self->priv->update_level++;
+  GST_DEBUG ("begin update: level=%u", self->priv->update_level);
+}
+
+/**
+ * bt_setup_commit_update:
+ * @self: the setup
+ *
+ * Finish a batch of changes started with bt_setup_begin_update(). When this
+ * ends the outermost batch, all wires that have been added meanwhile are linked
+ * in one pass.
+ *
+ * Since: 0.12
+ */
+void
+bt_setup_commit_update (const BtSetup * const self)
+{
+  g_return_if_fail (BT_IS_SETUP (self));
+  g_return_if_fail (self->priv->update_level > 0);
+
+  self->priv->update_level--;
+  GST_DEBUG ("commit update: level=%u, pending=%d", self->priv->update_level,
+      self->priv->update_pending);
+  if (!self->priv->update_level && self->priv->update_pending) {
+    bt_setup_sync_pipeline (self);
+  }
+}
+
 /**
  * bt_setup_get_machine_by_id:
  * @self: the setup to search for the machine
@@ -2013,6 +2099,7 @@ bt_setup_persistence_load (const GType type,
   GST_DEBUG ("PERSISTENCE::setup");
   g_assert (node);
 
+  bt_setup_begin_update (self);
   for (node = node->children; node; node = node->next) {
     if (!xmlNodeIsText (node)) {
       if (!strncmp ((gchar *) node->name, "machines\0", 9)) {
@@ -2083,6 +2170,7 @@ bt_setup_persistence_load (const GType type,
       }
     }
   }
+  bt_setup_commit_update (self);
   if (failed_parts) {
     bt_song_write_to_lowlevel_dot_file (self->priv->song);
   }
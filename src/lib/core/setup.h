@@ -80,4 +80,7 @@ gchar *bt_setup_get_unique_machine_id(const BtSetup * const self, const gchar *
 
 void bt_setup_remember_missing_machine(const BtSetup * const self, const gchar * const str);
 
+void bt_setup_begin_update(const BtSetup * const self);
+void bt_setup_commit_update(const BtSetup * const self);
+
 #endif // BT_SETUP_H
@@ -23,6 +23,17 @@
  *
  * In play and record modes it plugs a chain of elements. In combined play and
  * record mode it uses a tee and plugs both pipelines.
+ *
+ * The record formats use built-in encoding profiles. These can be replaced by
+ * installing a #GstEncodingTarget named "buzztrax" (see
+ * gst_encoding_target_save_to_file()). A profile in there named like the nick
+ * of a #BtSinkBinRecordFormat (e.g. "ogg-vorbis") is used instead of the
+ * built-in one. Quality, bitrate and threads of the encoders are taken from the
+ * "record-quality", "record-bitrate" and "record-threads" #BtSettings.
+ *
+ * Instead of a file, the recording can be streamed to stdout by using "-" as
+ * the file-name, or to an already open file descriptor by using "fd:N". See
+ * bt_sink_bin_get_record_fd().
  */
 
 /* TODO(ensonic): add properties for bpm, master volume and musical key,
@@ -70,12 +81,9 @@
  *   - unfortunately we need to make all sources report the duration
  */
 /* TODO(ensonic): improve encoding profiles
- * - we'd like to extend profiles
- *   - ideally gstreamer encoding profiles are stored somewhere and we just read
- *     them from an ini file or so
- *   - we could move the profiles to a BtAudioEncodingProfiles class
- *     - this could have the API do add, remove and probe profiles
- *     - test could easily e.g. add fake profiles then
+ * - we could move the profiles to a BtAudioEncodingProfiles class
+ *   - this could have the API do add, remove and probe profiles
+ *   - test could easily e.g. add fake profiles then
  */
 
 #define BT_CORE
@@ -87,6 +95,7 @@
 #include <gst/audio/gstaudiobasesink.h>
 #include <gst/base/gstbasesink.h>
 #include <gst/pbutils/encoding-profile.h>
+#include <gst/pbutils/encoding-target.h>
 #include <gst/pbutils/missing-plugins.h>
 #include "gst/tempo.h"
 
@@ -95,6 +104,13 @@
 /* define this to verify continuous timestamps */
 //#define BT_MONITOR_TIMESTAMPS
 
+/* name of the encoding target with replacements for the built-in profiles */
+#define BT_SINK_BIN_ENCODING_TARGET "buzztrax"
+/* key-file group for the cached probe results */
+#define BT_SINK_BIN_FORMAT_CACHE_GROUP "record-formats"
+// containers that seek back to write their index when finishing
+#define BT_SINK_BIN_NON_STREAMABLE_CAPS "video/quicktime; audio/x-m4a"
+
 //-- property ids
 
 enum
@@ -136,7 +152,7 @@ static const BtSinkBinRecordFormatInfo formats[] = {
   {"Ogg Opus record format", "Ogg Opus", "audio/ogg", "audio/x-opus"}
 };
 
-BtSinkBinRecordFormatState format_states[] = {
+static BtSinkBinRecordFormatState format_states[] = {
   RECORD_FORMAT_STATE_NOT_CHECKED,
   RECORD_FORMAT_STATE_NOT_CHECKED,
   RECORD_FORMAT_STATE_NOT_CHECKED,
@@ -189,6 +205,12 @@ struct _BtSinkBinPrivate
 
   /* master analyzers */
   GList *analyzers;
+
+#ifdef BT_MONITOR_TIMESTAMPS
+  /* the buffer timestamps jump back when looping, the running time must not */
+  GstSegment monitor_segment;
+  GstClockTime monitor_next_running_time;
+#endif
 };
 
 //-- prototypes
@@ -207,8 +229,8 @@ G_DEFINE_TYPE_WITH_CODE (BtSinkBin, bt_sink_bin, GST_TYPE_BIN,
 GType
 bt_sink_bin_mode_get_type (void)
 {
-  static GType type = 0;
-  if (G_UNLIKELY (type == 0)) {
+  static gsize type = 0;
+  if (g_once_init_enter (&type)) {
     static const GEnumValue values[] = {
       {BT_SINK_BIN_MODE_PLAY, "BT_SINK_BIN_MODE_PLAY", "play"},
       {BT_SINK_BIN_MODE_RECORD, "BT_SINK_BIN_MODE_RECORD", "record"},
@@ -217,7 +239,8 @@ bt_sink_bin_mode_get_type (void)
       {BT_SINK_BIN_MODE_PASS_THRU, "BT_SINK_BIN_MODE_PASS_THRU", "pass-thru"},
       {0, NULL, NULL},
     };
-    type = g_enum_register_static ("BtSinkBinMode", values);
+    g_once_init_leave (&type,
+        g_enum_register_static ("BtSinkBinMode", values));
   }
   return type;
 }
@@ -225,8 +248,8 @@ bt_sink_bin_mode_get_type (void)
 GType
 bt_sink_bin_record_format_get_type (void)
 {
-  static GType type = 0;
-  if (G_UNLIKELY (type == 0)) {
+  static gsize type = 0;
+  if (g_once_init_enter (&type)) {
     static const GEnumValue values[] = {
       {BT_SINK_BIN_RECORD_FORMAT_OGG_VORBIS, ".vorbis.ogg", "ogg-vorbis"},
       {BT_SINK_BIN_RECORD_FORMAT_MP3, ".mp3", "mp3"},
@@ -238,7 +261,8 @@ bt_sink_bin_record_format_get_type (void)
       {BT_SINK_BIN_RECORD_FORMAT_OGG_OPUS, ".opus.ogg", "ogg-opus"},
       {0, NULL, NULL},
     };
-    type = g_enum_register_static ("BtSinkBinRecordFormat", values);
+    g_once_init_leave (&type,
+        g_enum_register_static ("BtSinkBinRecordFormat", values));
   }
   return type;
 }
@@ -296,6 +320,69 @@ bt_sink_bin_create_recording_profile (const BtSinkBinRecordFormatInfo * info)
   }
 }
 
+static gpointer
+bt_sink_bin_load_encoding_target (gpointer data)
+{
+  GstEncodingTarget *target;
+
+  // the target is optional, not having one is not an error
+  if ((target = gst_encoding_target_load (BT_SINK_BIN_ENCODING_TARGET, NULL,
+              NULL))) {
+    GST_INFO ("using encoding profiles from target '%s'",
+        BT_SINK_BIN_ENCODING_TARGET);
+  }
+  return target;
+}
+
+static GstEncodingTarget *
+bt_sink_bin_get_encoding_target (void)
+{
+  static GOnce target_once = G_ONCE_INIT;
+
+  return g_once (&target_once, bt_sink_bin_load_encoding_target, NULL);
+}
+
+/*
+ * bt_sink_bin_get_external_recording_profile:
+ * @format: the record format
+ *
+ * Look up a replacement for the built-in profile of the @format in the
+ * encoding target.
+ *
+ * Returns: a new profile or %NULL if there is none
+ */
+static GstEncodingProfile *
+bt_sink_bin_get_external_recording_profile (BtSinkBinRecordFormat format)
+{
+  GstEncodingTarget *target = bt_sink_bin_get_encoding_target ();
+  GstEncodingProfile *profile = NULL;
+  GEnumClass *enum_class;
+  GEnumValue *enum_value;
+
+  if (!target || format == BT_SINK_BIN_RECORD_FORMAT_RAW)
+    return NULL;
+
+  enum_class = g_type_class_ref (BT_TYPE_SINK_BIN_RECORD_FORMAT);
+  enum_value = g_enum_get_value (enum_class, format);
+  if ((profile = gst_encoding_target_get_profile (target,
+              enum_value->value_nick))) {
+    GST_INFO ("using external profile for \"%s\"", enum_value->value_nick);
+  }
+  g_type_class_unref (enum_class);
+  return profile;
+}
+
+static GstEncodingProfile *
+bt_sink_bin_get_recording_profile (BtSinkBinRecordFormat format)
+{
+  GstEncodingProfile *profile;
+
+  if (!(profile = bt_sink_bin_get_external_recording_profile (format))) {
+    profile = bt_sink_bin_create_recording_profile (&formats[format]);
+  }
+  return profile;
+}
+
 //-- helper methods
 
 /*
@@ -544,6 +631,151 @@ Error:
   return list;
 }
 
+#define _SET_SCALED(t,T,p)                                                     \
+	case G_TYPE_ ## T:{                                                          \
+		const GParamSpec ## p *p=G_PARAM_SPEC_ ## T(property);                     \
+		g_object_set(self,n,(g ## t)(p->minimum+((p->maximum-p->minimum)*pos)),NULL); \
+	} break;
+
+/*
+ * bt_sink_bin_set_scaled_property:
+ * @self: the element
+ * @property: the property to set
+ * @pos: the position in the value range of the property from 0.0 to 1.0
+ *
+ * Sets a numeric property regardless of its type and range.
+ */
+static void
+bt_sink_bin_set_scaled_property (GstElement * self, GParamSpec * property,
+    gdouble pos)
+{
+  const gchar *n = property->name;
+
+  switch (bt_g_type_get_base_type (property->value_type)) {
+      _SET_SCALED (int, INT, Int)
+        _SET_SCALED (uint, UINT, UInt)
+        _SET_SCALED (int64, INT64, Int64)
+        _SET_SCALED (uint64, UINT64, UInt64)
+        _SET_SCALED (long, LONG, Long)
+        _SET_SCALED (ulong, ULONG, ULong)
+        _SET_SCALED (float, FLOAT, Float)
+        _SET_SCALED (double, DOUBLE, Double)
+      case G_TYPE_ENUM:{
+      const GEnumClass *e = G_PARAM_SPEC_ENUM (property)->enum_class;
+
+      g_object_set (self, n, e->values[(guint) ((e->n_values - 1) * pos)].value,
+          NULL);
+      break;
+    }
+    default:
+      GST_WARNING_OBJECT (self, "can't scale property '%s' of type '%s'", n,
+          G_PARAM_SPEC_TYPE_NAME (property));
+  }
+}
+
+/*
+ * bt_sink_bin_set_numeric_property:
+ * @self: the element
+ * @property: the property to set
+ * @value: the new value, will be clamped to the range of the property
+ *
+ * Sets a numeric property regardless of its type.
+ */
+static void
+bt_sink_bin_set_numeric_property (GstElement * self, GParamSpec * property,
+    gdouble value)
+{
+  GValue src = G_VALUE_INIT, dst = G_VALUE_INIT;
+
+  g_value_init (&src, G_TYPE_DOUBLE);
+  g_value_set_double (&src, value);
+  g_value_init (&dst, property->value_type);
+  if (g_value_transform (&src, &dst)) {
+    g_param_value_validate (property, &dst);
+    g_object_set_property ((GObject *) self, property->name, &dst);
+  } else {
+    GST_WARNING_OBJECT (self, "can't set property '%s' of type '%s'",
+        property->name, G_PARAM_SPEC_TYPE_NAME (property));
+  }
+  g_value_unset (&dst);
+  g_value_unset (&src);
+}
+
+/*
+ * bt_sink_bin_configure_encoder:
+ * @encoder: the encoder element
+ *
+ * Apply the encoder related #BtSettings. As encoders don't share an interface
+ * for these, we look for the commonly used property names.
+ */
+void
+bt_sink_bin_configure_encoder (GstElement * encoder)
+{
+  BtSettings *settings = bt_settings_make ();
+  GObjectClass *klass = G_OBJECT_GET_CLASS (encoder);
+  GstElementFactory *factory = gst_element_get_factory (encoder);
+  GParamSpec *property;
+  gint quality;
+  guint bitrate, threads;
+
+  g_object_get (settings, "record-quality", &quality, "record-bitrate",
+      &bitrate, "record-threads", &threads, NULL);
+  g_object_unref (settings);
+
+  if ((quality >= 0) && (property =
+          g_object_class_find_property (klass, "quality"))) {
+    gdouble pos = quality / 100.0;
+
+    // lame uses 0 for the best quality
+    if (!strcmp (GST_OBJECT_NAME (factory), "lamemp3enc"))
+      pos = 1.0 - pos;
+    GST_INFO_OBJECT (encoder, "quality: %d %%", quality);
+    bt_sink_bin_set_scaled_property (encoder, property, pos);
+  }
+  if (bitrate && (property = g_object_class_find_property (klass, "bitrate"))) {
+    GEnumValue *target = NULL;
+    gdouble value = bitrate * 1000.0;
+    gdouble max = 0.0;
+
+    // guess the unit from the range, some encoders take kbit/s
+    if (G_IS_PARAM_SPEC_INT (property))
+      max = G_PARAM_SPEC_INT (property)->maximum;
+    else if (G_IS_PARAM_SPEC_UINT (property))
+      max = G_PARAM_SPEC_UINT (property)->maximum;
+    if (max && max < 10000)
+      value = bitrate;
+    GST_INFO_OBJECT (encoder, "bitrate: %u kbit/s", bitrate);
+    bt_sink_bin_set_numeric_property (encoder, property, value);
+
+    // some encoders only use the bitrate in cbr mode (e.g. lamemp3enc)
+    if ((property = g_object_class_find_property (klass, "target")) &&
+        G_IS_PARAM_SPEC_ENUM (property) &&
+        (target = g_enum_get_value_by_nick (G_PARAM_SPEC_ENUM (property)->
+                enum_class, "bitrate"))) {
+      g_object_set (encoder, "target", target->value, NULL);
+    }
+  }
+  if ((property = g_object_class_find_property (klass, "threads")) ||
+      (property = g_object_class_find_property (klass, "n-threads"))) {
+    if (!threads)
+      threads = g_get_num_processors ();
+    GST_INFO_OBJECT (encoder, "threads: %u", threads);
+    bt_sink_bin_set_numeric_property (encoder, property, threads);
+  }
+}
+
+static void
+on_encodebin_deep_element_added (GstBin * bin, GstBin * sub_bin,
+    GstElement * element, gpointer user_data)
+{
+  GstElementFactory *factory = gst_element_get_factory (element);
+
+  if (factory && gst_element_factory_list_is_type (factory,
+          GST_ELEMENT_FACTORY_TYPE_AUDIO_ENCODER)) {
+    bt_sink_bin_configure_encoder (element);
+  }
+}
+
 GstElement *
 bt_sink_bin_make_and_configure_encodebin (GstEncodingProfile * profile)
 {
@@ -554,6 +786,8 @@ bt_sink_bin_make_and_configure_encodebin (GstEncodingProfile * profile)
 
   element = gst_element_factory_make ("encodebin", "sink-encodebin");
   gst_element_set_bus (element, bus);
+  g_signal_connect (element, "deep-element-added",
+      G_CALLBACK (on_encodebin_deep_element_added), NULL);
 
   GST_DEBUG_OBJECT (element, "set profile");
   // TODO(ensonic): this will post missing element mesages if the profile
@@ -585,27 +819,25 @@ bt_sink_bin_make_and_configure_encodebin (GstEncodingProfile * profile)
 }
 
 static GList *
-bt_sink_bin_get_recorder_elements (const BtSinkBin * const self)
+bt_sink_bin_make_recorder_elements (BtSinkBinRecordFormat format,
+    const gchar * file_name)
 {
   GList *list = NULL;
   GstElement *element;
   GstEncodingProfile *profile = NULL;
-
-  GST_DEBUG_OBJECT (self, "get record elements");
+  gint fd;
 
   // TODO(ensonic): check extension ?
 
   // generate recorder profile and set encodebin accordingly
-  profile =
-      bt_sink_bin_create_recording_profile (&formats[self->priv->
-          record_format]);
+  profile = bt_sink_bin_get_recording_profile (format);
   if (profile) {
     if ((element = bt_sink_bin_make_and_configure_encodebin (profile))) {
       list = g_list_append (list, element);
     }
     g_object_unref (profile);
   } else {
-    GST_DEBUG_OBJECT (self, "no profile, do raw recording");
+    GST_DEBUG ("no profile, do raw recording");
     // encodebin starts with a queue already
     element = gst_element_factory_make ("queue", "record-queue");
     if (element) {
@@ -613,25 +845,110 @@ bt_sink_bin_get_recorder_elements (const BtSinkBin * const self)
           "max-size-time", G_GUINT64_CONSTANT (0), "silent", TRUE, NULL);
       list = g_list_append (list, element);
     } else {
-      GST_WARNING_OBJECT (self, "failed to create 'queue'");
+      GST_WARNING ("failed to create 'queue'");
+    }
+  }
+  if ((fd = bt_sink_bin_get_record_fd (file_name)) != -1) {
+    // create fdsink, writes block while the reader is busy and thus throttle
+    // the rendering
+    GST_DEBUG ("recording to fd: %d", fd);
+    element = gst_element_factory_make ("fdsink", "fdsink");
+    if (element) {
+      g_object_set (element, "fd", fd,
+          /* this avoids the prerolling */
+          "async", FALSE, NULL);
+      list = g_list_append (list, element);
+    } else {
+      GST_WARNING ("failed to create 'fdsink'");
     }
+    return list;
   }
   // create filesink, set location property
-  GST_DEBUG_OBJECT (self, "recording to: %s", self->priv->record_file_name);
+  GST_DEBUG ("recording to: %s", file_name);
   element = gst_element_factory_make ("filesink", "filesink");
   if (element) {
-    g_object_set (element, "location", self->priv->record_file_name,
+    g_object_set (element, "location", file_name,
         // only for recording in in realtime and not as fast as we can
         // "sync", TRUE,
         /* this avoids the prerolling */
         "async", FALSE, NULL);
     list = g_list_append (list, element);
   } else {
-    GST_WARNING_OBJECT (self, "failed to create 'filesink'");
+    GST_WARNING ("failed to create 'filesink'");
   }
   return list;
 }
 
+static GList *
+bt_sink_bin_get_recorder_elements (const BtSinkBin * const self)
+{
+  GST_DEBUG_OBJECT (self, "get record elements");
+
+  return bt_sink_bin_make_recorder_elements (self->priv->record_format,
+      self->priv->record_file_name);
+}
+
+/*
+ * bt_sink_bin_make_recorder:
+ * @format: the format to record in
+ * @file_name: the file to write to
+ * @caps: (nullable): the raw audio format to convert to before encoding
+ *
+ * Create a bin with the same encoder and file-sink that the sink bin uses in
+ * record mode. The bin has a 'sink' ghost pad.
+ *
+ * Returns: the new bin or %NULL in case of an error
+ */
+GstElement *
+bt_sink_bin_make_recorder (BtSinkBinRecordFormat format,
+    const gchar * file_name, const GstCaps * caps)
+{
+  GstBin *bin;
+  GList *list, *node;
+  GstElement *first = NULL, *last = NULL, *element;
+  GstPad *pad;
+
+  if (!(list = bt_sink_bin_make_recorder_elements (format, file_name)))
+    return NULL;
+
+  if (caps) {
+    if ((element = gst_element_factory_make ("capsfilter", NULL))) {
+      g_object_set (element, "caps", caps, NULL);
+      list = g_list_prepend (list, element);
+    }
+    if ((element = gst_element_factory_make ("audioconvert", NULL))) {
+      list = g_list_prepend (list, element);
+    }
+  }
+
+  bin = (GstBin *) gst_bin_new (NULL);
+  for (node = list; node; node = g_list_next (node)) {
+    gst_bin_add (bin, GST_ELEMENT (node->data));
+  }
+  for (node = list; node; node = g_list_next (node)) {
+    GstElement *elem = GST_ELEMENT (node->data);
+
+    if (last && !gst_element_link (last, elem)) {
+      GST_WARNING_OBJECT (bin, "can't link %s and %s",
+          GST_OBJECT_NAME (last), GST_OBJECT_NAME (elem));
+      goto Error;
+    }
+    if (!first)
+      first = elem;
+    last = elem;
+  }
+  g_list_free (list);
+
+  pad = gst_element_get_static_pad (first, "sink");
+  gst_element_add_pad ((GstElement *) bin, gst_ghost_pad_new ("sink", pad));
+  gst_object_unref (pad);
+  return (GstElement *) bin;
+Error:
+  g_list_free (list);
+  gst_object_unref (bin);
+  return NULL;
+}
+
 #ifdef BT_MONITOR_SINK_DATA_FLOW
 static GstClockTime sink_probe_last_ts = GST_CLOCK_TIME_NONE;
 static gboolean
@@ -655,6 +972,45 @@ sink_probe (GstPad * pad, GstMiniObject * mini_obj, gpointer user_data)
 }
 #endif
 
+#ifdef BT_MONITOR_TIMESTAMPS
+static GstPadProbeReturn
+bt_sink_bin_monitor_timestamps (GstPad * pad, GstPadProbeInfo * info,
+    gpointer user_data)
+{
+  BtSinkBinPrivate *p = BT_SINK_BIN (user_data)->priv;
+
+  if (info->type & GST_PAD_PROBE_TYPE_BUFFER) {
+    GstBuffer *buf = GST_PAD_PROBE_INFO_BUFFER (info);
+    GstClockTime running_time =
+        gst_segment_to_running_time (&p->monitor_segment, GST_FORMAT_TIME,
+        GST_BUFFER_TIMESTAMP (buf));
+
+    if (GST_CLOCK_TIME_IS_VALID (p->monitor_next_running_time) &&
+        running_time != p->monitor_next_running_time) {
+      GST_WARNING_OBJECT (user_data, "discontinuity: expected %"
+          GST_TIME_FORMAT " got %" GST_TIME_FORMAT,
+          GST_TIME_ARGS (p->monitor_next_running_time),
+          GST_TIME_ARGS (running_time));
+    }
+    p->monitor_next_running_time = running_time + GST_BUFFER_DURATION (buf);
+  } else {
+    GstEvent *event = GST_PAD_PROBE_INFO_EVENT (info);
+
+    switch (GST_EVENT_TYPE (event)) {
+      case GST_EVENT_SEGMENT:
+        gst_event_copy_segment (event, &p->monitor_segment);
+        break;
+      case GST_EVENT_FLUSH_STOP:
+        p->monitor_next_running_time = GST_CLOCK_TIME_NONE;
+        break;
+      default:
+        break;
+    }
+  }
+  return GST_PAD_PROBE_OK;
+}
+#endif
+
 static gboolean
 bt_sink_bin_format_update (const BtSinkBin * const self)
 {
@@ -755,24 +1111,21 @@ bt_sink_bin_update (const BtSinkBin * const self)
     GST_WARNING_OBJECT (self, "Can't link caps-filter and audio-resample");
     return FALSE;
   }
-#ifdef BT_MONITOR_TIMESTAMPS
-  {
-    GstElement *identity = gst_element_factory_make ("identity", "identity");
-
-    g_object_set (identity, "check-perfect", TRUE, "silent", FALSE, NULL);
-    gst_bin_add (GST_BIN (self), identity);
-    if (!gst_element_link_pads (audio_resample, "src", identity, "sink")) {
-      GST_WARNING_OBJECT (self, "Can't link audio-resample and identity");
-    }
-    if (!gst_element_link_pads (identity, "src", tee, "sink")) {
-      GST_WARNING_OBJECT (self, "Can't link identity and tee");
-    }
-  }
-#else
   if (!gst_element_link_pads (audio_resample, "src", tee, "sink")) {
     GST_WARNING_OBJECT (self, "Can't link audio-resample and tee");
     return FALSE;
   }
+#ifdef BT_MONITOR_TIMESTAMPS
+  {
+    GstPad *pad = gst_element_get_static_pad (tee, "sink");
+
+    gst_segment_init (&self->priv->monitor_segment, GST_FORMAT_TIME);
+    self->priv->monitor_next_running_time = GST_CLOCK_TIME_NONE;
+    gst_pad_add_probe (pad, GST_PAD_PROBE_TYPE_BUFFER |
+        GST_PAD_PROBE_TYPE_EVENT_DOWNSTREAM, bt_sink_bin_monitor_timestamps,
+        (gpointer) self, NULL);
+    gst_object_unref (pad);
+  }
 #endif
 
   // add new children
@@ -1009,38 +1362,253 @@ master_volume_sync_handler (GstPad * pad, GstPadProbeInfo * info,
   return GST_PAD_PROBE_OK;
 }
 
+static BtSinkBinRecordFormatState
+bt_sink_bin_probe_record_format (BtSinkBinRecordFormat format)
+{
+  BtSinkBinRecordFormatState state = RECORD_FORMAT_STATE_MISSES_ELEMENTS;
+  GstEncodingProfile *profile = bt_sink_bin_get_recording_profile (format);
+  GstElement *element;
+
+  if (profile) {
+    if ((element = bt_sink_bin_make_and_configure_encodebin (profile))) {
+      state = RECORD_FORMAT_STATE_WORKING;
+      gst_object_unref (element);
+    }
+    g_object_unref (profile);
+  }
+  return state;
+}
+
+static gint
+bt_sink_bin_compare_strings (gconstpointer a, gconstpointer b)
+{
+  return strcmp (*(const gchar **) a, *(const gchar **) b);
+}
+
+/*
+ * bt_sink_bin_get_format_cache_stamp:
+ *
+ * The probe results stay valid as long as neither gstreamer nor any of the
+ * installed plugins changes. Besides the gstreamer version the stamp contains a
+ * checksum over the file-name and version of each plugin, so that upgrades and
+ * swapped plugins are noticed too.
+ *
+ * Returns: a stamp describing the installed gstreamer, free when done
+ */
+gchar *
+bt_sink_bin_get_format_cache_stamp (void)
+{
+  GList *plugins = gst_registry_get_plugin_list (gst_registry_get ());
+  GList *node;
+  GPtrArray *entries = g_ptr_array_new_with_free_func (g_free);
+  guint major, minor, micro, nano;
+  gchar *plugin_list, *checksum, *stamp;
+
+  for (node = plugins; node; node = g_list_next (node)) {
+    GstPlugin *plugin = GST_PLUGIN (node->data);
+    const gchar *file_name = gst_plugin_get_filename (plugin);
+
+    g_ptr_array_add (entries, g_strdup_printf ("%s:%s",
+            file_name ? file_name : gst_plugin_get_name (plugin),
+            gst_plugin_get_version (plugin)));
+  }
+  gst_plugin_list_free (plugins);
+  // the registry order is not stable
+  g_ptr_array_sort (entries, bt_sink_bin_compare_strings);
+  g_ptr_array_add (entries, NULL);
+  plugin_list = g_strjoinv ("\n", (gchar **) entries->pdata);
+  checksum = g_compute_checksum_for_string (G_CHECKSUM_SHA1, plugin_list, -1);
+
+  gst_version (&major, &minor, &micro, &nano);
+  stamp = g_strdup_printf ("%u.%u.%u.%u/%s", major, minor, micro, nano,
+      checksum);
+  g_free (checksum);
+  g_free (plugin_list);
+  g_ptr_array_free (entries, TRUE);
+  return stamp;
+}
+
+/*
+ * bt_sink_bin_probe_record_formats:
+ *
+ * Probe which record formats are usable. Building an encodebin for each format
+ * is slow, so we keep the results in a cache file and only probe again if the
+ * gstreamer installation has changed. Formats that use an external profile are
+ * always probed, as their definition can change at any time.
+ */
+static gpointer
+bt_sink_bin_probe_record_formats (gpointer data)
+{
+  GEnumClass *enum_class = g_type_class_ref (BT_TYPE_SINK_BIN_RECORD_FORMAT);
+  GEnumValue *enum_value;
+  GstEncodingProfile *profile;
+  GKeyFile *cache = g_key_file_new ();
+  gchar *cache_name, *stamp, *cached_stamp = NULL, *cache_data;
+  gsize cache_size;
+  gboolean valid = FALSE, dirty = FALSE, external;
+  GError *error = NULL;
+  guint i;
+
+  cache_name = g_build_filename (g_get_user_cache_dir (), PACKAGE,
+      "record-formats.ini", NULL);
+  stamp = bt_sink_bin_get_format_cache_stamp ();
+  if (g_key_file_load_from_file (cache, cache_name, G_KEY_FILE_NONE, NULL)) {
+    cached_stamp = g_key_file_get_string (cache,
+        BT_SINK_BIN_FORMAT_CACHE_GROUP, "stamp", NULL);
+    valid = !g_strcmp0 (stamp, cached_stamp);
+    g_free (cached_stamp);
+  }
+  if (!valid) {
+    GST_INFO ("no valid probe results in '%s'", cache_name);
+    g_key_file_free (cache);
+    cache = g_key_file_new ();
+    g_key_file_set_string (cache, BT_SINK_BIN_FORMAT_CACHE_GROUP, "stamp",
+        stamp);
+  }
+
+  for (i = 0; i < BT_SINK_BIN_RECORD_FORMAT_COUNT; i++) {
+    if (format_states[i] != RECORD_FORMAT_STATE_NOT_CHECKED)
+      continue;
+
+    enum_value = g_enum_get_value (enum_class, i);
+    if ((profile = bt_sink_bin_get_external_recording_profile (i))) {
+      g_object_unref (profile);
+      external = TRUE;
+    } else {
+      external = FALSE;
+    }
+    if (!external && g_key_file_has_key (cache,
+            BT_SINK_BIN_FORMAT_CACHE_GROUP, enum_value->value_nick, NULL)) {
+      format_states[i] = g_key_file_get_boolean (cache,
+          BT_SINK_BIN_FORMAT_CACHE_GROUP, enum_value->value_nick, NULL) ?
+          RECORD_FORMAT_STATE_WORKING : RECORD_FORMAT_STATE_MISSES_ELEMENTS;
+    } else {
+      format_states[i] = bt_sink_bin_probe_record_format (i);
+      if (!external) {
+        g_key_file_set_boolean (cache, BT_SINK_BIN_FORMAT_CACHE_GROUP,
+            enum_value->value_nick,
+            format_states[i] == RECORD_FORMAT_STATE_WORKING);
+        dirty = TRUE;
+      }
+    }
+    GST_INFO ("format \"%s\" is %s", enum_value->value_nick,
+        (format_states[i] == RECORD_FORMAT_STATE_WORKING) ? "working" :
+        "missing elements");
+  }
+
+  if (dirty) {
+    gchar *cache_dir = g_path_get_dirname (cache_name);
+
+    g_mkdir_with_parents (cache_dir, 0755);
+    g_free (cache_dir);
+    cache_data = g_key_file_to_data (cache, &cache_size, NULL);
+    if (!g_file_set_contents (cache_name, cache_data, cache_size, &error)) {
+      GST_WARNING ("failed to write probe results to '%s': %s", cache_name,
+          error->message);
+      g_error_free (error);
+    }
+    g_free (cache_data);
+  }
+
+  g_free (stamp);
+  g_free (cache_name);
+  g_key_file_free (cache);
+  g_type_class_unref (enum_class);
+  return NULL;
+}
+
 //-- methods
 
+/**
+ * bt_sink_bin_get_record_fd:
+ * @file_name: the record file-name
+ *
+ * Check if the @file_name refers to a stream instead of a file. Streams are
+ * given as "-" for stdout or as "fd:N" for the file descriptor N.
+ *
+ * Returns: the file descriptor to write to or -1 for regular files
+ *
+ * Since: 0.12
+ */
+gint
+bt_sink_bin_get_record_fd (const gchar * file_name)
+{
+  gchar *end;
+  gint64 fd;
+
+  g_return_val_if_fail (BT_IS_STRING (file_name), -1);
+
+  if (!strcmp (file_name, "-"))
+    return 1;
+  if (g_str_has_prefix (file_name, "fd:")) {
+    fd = g_ascii_strtoll (&file_name[3], &end, 10);
+    if ((end != &file_name[3]) && (*end == '\0') && (fd >= 0)
+        && (fd <= G_MAXINT)) {
+      return (gint) fd;
+    }
+    GST_WARNING ("invalid file descriptor in '%s'", file_name);
+  }
+  return -1;
+}
+
 /**
  * bt_sink_bin_is_record_format_supported:
  * @format: the format to check
  *
  * Each record format might need a couple of GStreamer element to work. This
- * function verifies that all needed element are available.
+ * function verifies that all needed element are available. The first call
+ * probes all formats, the results are cached on disk.
  *
  * Returns: %TRUE if a fomat is useable
  */
 gboolean
 bt_sink_bin_is_record_format_supported (BtSinkBinRecordFormat format)
 {
-  if (format_states[format] == RECORD_FORMAT_STATE_NOT_CHECKED) {
-    GstElement *element;
-    GstEncodingProfile *profile =
-        bt_sink_bin_create_recording_profile (&formats[format]);
+  static GOnce probe_once = G_ONCE_INIT;
 
-    // TODO(ensonic): if we run the plugin installer, we need to re-eval the
-    // profiles
-    if ((element = bt_sink_bin_make_and_configure_encodebin (profile))) {
-      format_states[format] = RECORD_FORMAT_STATE_WORKING;
-      gst_object_unref (element);
-    } else {
-      format_states[format] = RECORD_FORMAT_STATE_MISSES_ELEMENTS;
-    }
-    g_object_unref (profile);
-  }
+  g_return_val_if_fail (format < BT_SINK_BIN_RECORD_FORMAT_COUNT, FALSE);
+
+  // TODO(ensonic): if we run the plugin installer, we need to re-eval the
+  // profiles
+  g_once (&probe_once, bt_sink_bin_probe_record_formats, NULL);
   return format_states[format] > RECORD_FORMAT_STATE_NOT_CHECKED;
 }
 
+/**
+ * bt_sink_bin_is_record_format_streamable:
+ * @format: the format to check
+ *
+ * Some containers (e.g. mp4) need to seek back when finishing the file. Such
+ * formats can't be used to record to a stream (see bt_sink_bin_get_record_fd()).
+ *
+ * Returns: %TRUE if a format can be written to a stream
+ *
+ * Since: 0.12
+ */
+gboolean
+bt_sink_bin_is_record_format_streamable (BtSinkBinRecordFormat format)
+{
+  GstEncodingProfile *profile;
+  GstCaps *caps, *non_streamable_caps;
+  gboolean res = TRUE;
+
+  g_return_val_if_fail (format < BT_SINK_BIN_RECORD_FORMAT_COUNT, FALSE);
+
+  if (!(profile = bt_sink_bin_get_recording_profile (format)))
+    return TRUE;
+
+  if (GST_IS_ENCODING_CONTAINER_PROFILE (profile)) {
+    caps = gst_encoding_profile_get_format (profile);
+    non_streamable_caps =
+        gst_caps_from_string (BT_SINK_BIN_NON_STREAMABLE_CAPS);
+    res = !gst_caps_can_intersect (caps, non_streamable_caps);
+    gst_caps_unref (non_streamable_caps);
+    gst_caps_unref (caps);
+  }
+  g_object_unref (profile);
+  return res;
+}
+
 //-- wrapper
 
 //-- class internals
@@ -1345,7 +1913,8 @@ bt_sink_bin_class_init (BtSinkBinClass * klass)
 
   g_object_class_install_property (gobject_class, SINK_BIN_RECORD_FILE_NAME,
       g_param_spec_string ("record-file-name", "Record filename",
-          "the file-name to use for recording", NULL,
+          "the file-name to use for recording, '-' or 'fd:N' to stream",
+          NULL,
           G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 
   g_object_class_install_property (gobject_class, SINK_BIN_INPUT_GAIN,
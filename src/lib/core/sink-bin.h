@@ -99,6 +99,8 @@ typedef enum {
 } BtSinkBinRecordFormat;
 
 gboolean bt_sink_bin_is_record_format_supported(BtSinkBinRecordFormat format);
+gboolean bt_sink_bin_is_record_format_streamable(BtSinkBinRecordFormat format);
+gint bt_sink_bin_get_record_fd(const gchar *file_name);
 
 GType bt_sink_bin_get_type(void) G_GNUC_CONST;
 GType bt_sink_bin_mode_get_type(void) G_GNUC_CONST;
@@ -401,6 +401,7 @@ bt_song_io_load (BtSongIO const *self, const BtSong * const song, GError ** err)
   gboolean result;
   gchar *status;
   bt_song_io_virtual_load load;
+  BtSetup *setup;
 
   g_return_val_if_fail (BT_IS_SONG_IO (self), FALSE);
   g_return_val_if_fail (BT_IS_SONG (song), FALSE);
@@ -427,7 +428,13 @@ bt_song_io_load (BtSongIO const *self, const BtSong * const song, GError ** err)
   g_object_set ((gpointer) self, "status", status, NULL);
 
   g_object_set ((gpointer) song, "song-io", self, NULL);
-  if ((result = load (self, song, err))) {
+  // link the machines and wires once after everything has been loaded
+  g_object_get ((gpointer) song, "setup", &setup, NULL);
+  bt_setup_begin_update (setup);
+  result = load (self, song, err);
+  bt_setup_commit_update (setup);
+  g_object_unref (setup);
+  if (result) {
     bt_song_io_update_filename (BT_SONG_IO (self), song);
     GST_INFO ("loading done");
     //DEBUG
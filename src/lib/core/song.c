@@ -92,7 +92,7 @@
  * - I added a pending_async_seek flag, but since we rate limmit from the UI we
  *   never skipped a seek
  */
-/* TODO: make looping seamless:
+/* Seamless looping:
  * - play with loop enabled:
  *   - apps sends flushing segmented seek
  *   - on segment_done, send segmented seek
@@ -130,14 +130,19 @@
  *       e:adder        :                         e.seek, e.new_seg, buffer, buffer, ...
  *       e:sink         :                          e.seek, e.new_seg, buffer, buffer, ...
  *
+ * - the loop seek is sent from the "sync-message::segment-done" handler in the
+ *   streaming thread, so that looping does not stall while the main-loop is
+ *   busy, see test_bt_song_play_loop_is_seamless
  * CHECKED:
  * - using "sync-message::segment-done" does not help
+ *   this still applies to the jumpy loops, the sync handler only removes the
+ *   dependency on the main-loop
  * - making buffer-time more than twice latency-time does not help either
  *   see sink-bin.c::bt_sink_bin_configure_latency()
- * TODO:
  * - run with realtime scheduling - both help!
- *   sudo chrt -f -p 1 $(pidof lt-buzztrax-edit)
- *   sudo chrt -r -p 1 $(pidof lt-buzztrax-edit)
+ *   this is now done for the streaming threads, see the 'realtime-policy'
+ *   setting and bt_song_setup_streaming_thread()
+ * TODO:
  * - run with different sinks:
  *   jack: issues with loops !
  * (buzztrax-edit:6784): GStreamer-CRITICAL **: gst_buffer_copy_into: assertion 'bufsize >= offset + size' failed
@@ -153,6 +158,9 @@
  *
  * GST_DEBUG_FILE="trace.log" GST_DEBUG_NO_COLOR=1 GST_DEBUG="GST_TRACER:7" GST_TRACERS=stats ./buzztrax-edit
  */
+/* for sched_setaffinity() and the CPU_SET macros */
+#define _GNU_SOURCE
+
 #define BT_CORE
 #define BT_SONG_C
 
@@ -160,6 +168,17 @@
 #include <glib/gprintf.h>
 #include "gst/tempo.h"
 
+#if defined(HAVE_SCHED_SETSCHEDULER) || defined(HAVE_SCHED_SETAFFINITY)
+#include <errno.h>
+#include <sched.h>
+#endif
+
+#ifdef USE_X86_SSE
+#ifdef HAVE_XMMINTRIN_H
+#include <xmmintrin.h>
+#endif
+#endif
+
 /* if a state change does not happen within this time, cancel playback
  * this time includes prerolling, set to 30 seconds for now */
 #define STATE_CHANGE_TIMEOUT 30
@@ -193,9 +212,17 @@ enum
   SONG_PLAY_RATE,
   SONG_IS_PLAYING,
   SONG_IS_IDLE,
-  SONG_IO
+  SONG_IO,
+  SONG_PARALLEL
 };
 
+typedef enum
+{
+  BT_SONG_CPU_AFFINITY_NONE = 0,
+  BT_SONG_CPU_AFFINITY_SPREAD,
+  BT_SONG_CPU_AFFINITY_SET
+} BtSongCpuAffinity;
+
 struct _BtSongPrivate
 {
   /* used to validate if dispose has run */
@@ -229,11 +256,30 @@ struct _BtSongPrivate
   GstEvent *loop_seek_event;
   GstEvent *idle_seek_event;
   GstEvent *idle_loop_seek_event;
-  /* timeout handlers */
-  guint paused_timeout_id, playback_timeout_id;
+  /* protects the loop seek events and the is_playing/is_idle_active flags,
+   * they are used from the streaming thread */
+  GMutex loop_lock;
+  /* timeout handlers, the paused timeout is attached to the thread-default
+   * main context, so that songs can be played from worker threads */
+  GSource *paused_timeout;
+  guint playback_timeout_id;
 
   /* the song-io plugin during i/o operations */
   BtSongIO *song_io;
+
+  /* setup for the streaming threads, from the settings, the lock protects them
+   * against the settings changing while streaming threads get started */
+  GMutex thread_settings_lock;
+  gint rt_policy, rt_priority;
+  gboolean rt_failed;
+  BtSongCpuAffinity cpu_affinity;
+#ifdef HAVE_SCHED_SETAFFINITY
+  cpu_set_t cpu_set;
+#endif
+  gint next_cpu;
+
+  /* scheduling mode: run each machine in a streaming thread of its own */
+  gboolean parallel;
 };
 
 //-- the class
@@ -295,6 +341,7 @@ bt_song_update_play_seek_event (const BtSong * const self)
 
   if (p->play_seek_event)
     gst_event_unref (p->play_seek_event);
+  g_mutex_lock (&p->loop_lock);
   if (p->loop_seek_event)
     gst_event_unref (p->loop_seek_event);
 
@@ -313,6 +360,7 @@ bt_song_update_play_seek_event (const BtSong * const self)
         play_pos * tick_duration, loop_end * tick_duration);
     p->loop_seek_event = NULL;
   }
+  g_mutex_unlock (&p->loop_lock);
 }
 
 /*
@@ -432,7 +480,8 @@ bt_song_update_play_seek_event_and_play_pos (const BtSong * const self)
  * ------------------- = stpb
  * (bpm*tpb*30*1000000)
  *
- * - maybe we get set target-latency=-1 for no subticks (=1) e.g. when recording
+ * - when only recording (the master is in record mode) we use stpb=1, there
+ *   is nobody listening and fewer, larger buffers render faster
  * - make this a property on the song that merges latency setting + playback mode?
  */
 static void
@@ -444,13 +493,21 @@ bt_song_send_audio_context (const BtSong * const self)
   gulong bpm, tpb;
   guint latency;
   glong stpb = 0;
+  BtSinkBinMode mode = BT_SINK_BIN_MODE_PLAY;
 
   g_object_get (p->song_info, "bpm", &bpm, "tpb", &tpb, NULL);
   g_object_get (settings, "latency", &latency, NULL);
   g_object_unref (settings);
 
-  stpb = (glong) ((GST_SECOND * 60) / (bpm * tpb * latency * GST_MSECOND));
-  stpb = MAX (1, stpb);
+  if (BT_IS_SINK_BIN (p->master_bin)) {
+    g_object_get (p->master_bin, "mode", &mode, NULL);
+  }
+  if (mode == BT_SINK_BIN_MODE_RECORD) {
+    stpb = 1;
+  } else {
+    stpb = (glong) ((GST_SECOND * 60) / (bpm * tpb * latency * GST_MSECOND));
+    stpb = MAX (1, stpb);
+  }
   GST_INFO ("chosing subticks=%ld from bpm=%lu,tpb=%lu,latency=%u", stpb, bpm,
       tpb, latency);
 
@@ -591,8 +648,200 @@ bt_song_send_initial_seek (const BtSong * const self, GstBin * bin,
 }
 #endif
 
+#ifdef HAVE_SCHED_SETAFFINITY
+/*
+ * bt_song_parse_cpu_list:
+ *
+ * Parse a list of cpus such as "0,2-3" into @set.
+ *
+ * Returns: %TRUE if at least one cpu was given
+ */
+static gboolean
+bt_song_parse_cpu_list (const gchar * str, cpu_set_t * set)
+{
+  gchar **parts = g_strsplit (str, ",", -1);
+  gchar **part;
+  gboolean res = FALSE;
+
+  CPU_ZERO (set);
+  for (part = parts; *part; part++) {
+    gchar *end;
+    guint64 beg, last;
+
+    beg = last = g_ascii_strtoull (*part, &end, 10);
+    if (end == *part)
+      continue;
+    if (*end == '-')
+      last = g_ascii_strtoull (&end[1], NULL, 10);
+    for (; beg <= last && beg < CPU_SETSIZE; beg++) {
+      CPU_SET ((gint) beg, set);
+      res = TRUE;
+    }
+  }
+  g_strfreev (parts);
+  return res;
+}
+#endif
+
+static void
+bt_song_read_thread_settings (const BtSong * const self)
+{
+  BtSongPrivate *p = self->priv;
+  BtSettings *settings = bt_settings_make ();
+  gchar *policy, *affinity;
+  guint priority;
+  gint rt_policy = -1, rt_priority = 0;
+  BtSongCpuAffinity cpu_affinity = BT_SONG_CPU_AFFINITY_NONE;
+#ifdef HAVE_SCHED_SETAFFINITY
+  cpu_set_t cpu_set;
+
+  CPU_ZERO (&cpu_set);
+#endif
+
+  g_object_get (settings, "realtime-policy", &policy, "realtime-priority",
+      &priority, "cpu-affinity", &affinity, NULL);
+  g_object_unref (settings);
+
+#ifdef HAVE_SCHED_SETSCHEDULER
+  if (!g_strcmp0 (policy, "fifo"))
+    rt_policy = SCHED_FIFO;
+  else if (!g_strcmp0 (policy, "rr"))
+    rt_policy = SCHED_RR;
+  if (rt_policy != -1) {
+    rt_priority = CLAMP ((gint) priority,
+        sched_get_priority_min (rt_policy), sched_get_priority_max (rt_policy));
+  }
+#endif
+
+#ifdef HAVE_SCHED_SETAFFINITY
+  if (!g_strcmp0 (affinity, "spread"))
+    cpu_affinity = BT_SONG_CPU_AFFINITY_SPREAD;
+  else if (affinity && *affinity) {
+    if (bt_song_parse_cpu_list (affinity, &cpu_set))
+      cpu_affinity = BT_SONG_CPU_AFFINITY_SET;
+    else
+      GST_WARNING ("ignoring invalid cpu-affinity: '%s'", affinity);
+  }
+#endif
+
+  // streaming threads read these while they start up
+  g_mutex_lock (&p->thread_settings_lock);
+  p->rt_policy = rt_policy;
+  p->rt_priority = rt_priority;
+  p->rt_failed = FALSE;
+  p->cpu_affinity = cpu_affinity;
+#ifdef HAVE_SCHED_SETAFFINITY
+  p->cpu_set = cpu_set;
+#endif
+  g_mutex_unlock (&p->thread_settings_lock);
+
+  GST_INFO ("streaming threads: policy='%s', priority=%u, affinity='%s'",
+      policy, priority, affinity);
+  g_free (policy);
+  g_free (affinity);
+}
+
+/*
+ * bt_song_setup_streaming_thread:
+ *
+ * Called from within a new streaming thread to apply the scheduling policy,
+ * the cpu affinity and the floating point mode. Works on a snapshot of the
+ * settings, as they can change from the main thread at any time.
+ */
+static void
+bt_song_setup_streaming_thread (const BtSong * const self, GstElement * owner)
+{
+  BtSongPrivate *p = self->priv;
+  gint rt_policy, rt_priority;
+  gboolean rt_failed;
+  BtSongCpuAffinity cpu_affinity;
+#ifdef HAVE_SCHED_SETAFFINITY
+  cpu_set_t set;
+#endif
+
+  g_mutex_lock (&p->thread_settings_lock);
+  rt_policy = p->rt_policy;
+  rt_priority = p->rt_priority;
+  rt_failed = p->rt_failed;
+  cpu_affinity = p->cpu_affinity;
+#ifdef HAVE_SCHED_SETAFFINITY
+  set = p->cpu_set;
+#endif
+  g_mutex_unlock (&p->thread_settings_lock);
+
+#ifdef HAVE_SCHED_SETSCHEDULER
+  if (rt_policy != -1 && !rt_failed) {
+    struct sched_param param = { 0, };
+
+    // on linux pid=0 refers to the calling thread
+    param.sched_priority = rt_priority;
+    if (sched_setscheduler (0, rt_policy, &param) < 0) {
+      GST_WARNING_OBJECT (owner, "switching scheduler failed: %s",
+          g_strerror (errno));
+      // don't try again, the permissions won't change, unless the settings
+      // have been changed meanwhile
+      g_mutex_lock (&p->thread_settings_lock);
+      if (p->rt_policy == rt_policy && p->rt_priority == rt_priority)
+        p->rt_failed = TRUE;
+      g_mutex_unlock (&p->thread_settings_lock);
+    }
+  }
+#endif
+#ifdef HAVE_SCHED_SETAFFINITY
+  if (cpu_affinity != BT_SONG_CPU_AFFINITY_NONE) {
+    if (cpu_affinity == BT_SONG_CPU_AFFINITY_SPREAD) {
+      gint cpu = g_atomic_int_add (&p->next_cpu, 1) % g_get_num_processors ();
+
+      CPU_ZERO (&set);
+      CPU_SET (cpu, &set);
+    }
+    if (sched_setaffinity (0, sizeof (set), &set) < 0) {
+      GST_WARNING_OBJECT (owner, "setting cpu affinity failed: %s",
+          g_strerror (errno));
+    }
+  }
+#endif
+#if USE_X86_SSE
+  // the flags are per thread, see bt_init_post()
+  _mm_setcsr (_mm_getcsr () | 0x8040); // set DAZ and FZ bits
+#endif
+}
+
+/*
+ * bt_song_update_scheduling:
+ *
+ * Relink all wires, so that they get or release the queue that decouples the
+ * machines (see bt_wire_link_machines()).
+ */
+static void
+bt_song_update_scheduling (const BtSong * const self)
+{
+  GList *list, *node;
+
+  if (!self->priv->setup)
+    return;
+
+  g_object_get (self->priv->setup, "wires", &list, NULL);
+  for (node = list; node; node = g_list_next (node)) {
+    if (!bt_wire_reconnect (BT_WIRE (node->data))) {
+      GST_WARNING_OBJECT (node->data, "failed to relink the wire");
+    }
+  }
+  g_list_free (list);
+}
+
 //-- handler
 
+static void
+bt_song_remove_paused_timeout (const BtSong * const self)
+{
+  if (self->priv->paused_timeout) {
+    g_source_destroy (self->priv->paused_timeout);
+    g_source_unref (self->priv->paused_timeout);
+    self->priv->paused_timeout = NULL;
+  }
+}
+
 static gboolean
 on_song_paused_timeout (gpointer user_data)
 {
@@ -603,16 +852,51 @@ on_song_paused_timeout (gpointer user_data)
     bt_song_write_to_lowlevel_dot_file (self);
     bt_song_stop (self);
   }
-  self->priv->paused_timeout_id = 0;
+  bt_song_remove_paused_timeout (self);
   return FALSE;
 }
 
+/* Loop from the streaming thread that finished the segment. The sources
+ * continue right away, without waiting for the main-loop to dispatch the
+ * message. */
 static void
-on_song_segment_done (const GstBus * const bus,
+on_song_segment_done_sync (const GstBus * const bus,
     const GstMessage * const message, gconstpointer user_data)
 {
   const BtSong *const self = BT_SONG (user_data);
+  BtSongPrivate *p = self->priv;
+  GstEvent *event = NULL;
+  guint32 seek_seqnum;
+
+  g_mutex_lock (&p->loop_lock);
+  if (p->is_playing) {
+    if (p->loop_seek_event)
+      event = gst_event_copy (p->loop_seek_event);
+  } else if (p->is_idle_active) {
+    event = gst_event_copy (p->idle_loop_seek_event);
+  }
+  g_mutex_unlock (&p->loop_lock);
+
+  if (!event) {
+    GST_WARNING ("song isn't playing/idling ?!?");
+    return;
+  }
+
+  seek_seqnum = gst_util_seqnum_next ();
+  gst_event_set_seqnum (event, seek_seqnum);
+  // a non flushing seek, the new segment continues where the old one ended
+  if (!(gst_element_send_event (GST_ELEMENT (p->master_bin), event))) {
+    GST_WARNING ("element failed to handle loop seek event");
+  } else {
+    GST_INFO ("-> loop (%u)", seek_seqnum);
+  }
+}
+
 #ifndef GST_DISABLE_GST_DEBUG
+static void
+on_song_segment_done (const GstBus * const bus,
+    const GstMessage * const message, gconstpointer user_data)
+{
   GstFormat format;
   gint64 position;
   guint32 seek_seqnum = gst_message_get_seqnum ((GstMessage *) message);
@@ -623,42 +907,14 @@ on_song_segment_done (const GstBus * const bus,
   last_ts = this_ts;
 
   gst_message_parse_segment_done ((GstMessage *) message, &format, &position);
-#endif
 
   GST_INFO
       ("received SEGMENT_DONE (%u) bus message: from %s, with fmt=%s, ts=%"
       GST_TIME_FORMAT " after %" GST_TIME_FORMAT, seek_seqnum,
       GST_OBJECT_NAME (GST_MESSAGE_SRC (message)), gst_format_get_name (format),
       GST_TIME_ARGS (position), GST_TIME_ARGS (ts_diff));
-
-  if (self->priv->is_playing || self->priv->is_idle_active) {
-    GstEvent *event;
-
-    if (self->priv->is_playing) {
-      event = gst_event_copy (self->priv->loop_seek_event);
-    } else {
-      event = gst_event_copy (self->priv->idle_loop_seek_event);
-    }
-    g_assert (event);
-#ifndef GST_DISABLE_GST_DEBUG
-    seek_seqnum = gst_util_seqnum_next ();
-    gst_event_set_seqnum (event, seek_seqnum);
-#else
-    gst_event_set_seqnum (event, gst_util_seqnum_next ());
-#endif
-    if (!(gst_element_send_event (GST_ELEMENT (self->priv->master_bin), event))) {
-      GST_WARNING ("element failed to handle loop seek event");
-    } else {
-      GST_INFO ("-> loop (%u)", seek_seqnum);
-      /*
-         gst_pipeline_set_new_stream_time (GST_PIPELINE (self->priv->bin), 0);
-         gst_element_get_state (GST_ELEMENT (self->priv->bin), NULL, NULL, 40 * GST_MSECOND);
-       */
-    }
-  } else {
-    GST_WARNING ("song isn't playing/idling ?!?");
-  }
 }
+#endif
 
 static void
 on_song_eos (const GstBus * const bus, const GstMessage * const message,
@@ -729,7 +985,9 @@ on_song_state_changed (const GstBus * const bus, GstMessage * message,
       case GST_STATE_CHANGE_PAUSED_TO_PLAYING:
         if (!p->is_playing) {
           GST_INFO_OBJECT (p->bin, "playback started");
+          g_mutex_lock (&p->loop_lock);
           p->is_playing = TRUE;
+          g_mutex_unlock (&p->loop_lock);
           g_object_notify (G_OBJECT (self), "is-playing");
           // if the song is empty playback is done
           if (!GST_BIN_NUMCHILDREN (p->bin)) {
@@ -740,10 +998,7 @@ on_song_state_changed (const GstBus * const bus, GstMessage * message,
           GST_INFO_OBJECT (p->bin, "looping");
         }
         bt_song_update_playback_position (self);
-        if (p->paused_timeout_id) {
-          g_source_remove (p->paused_timeout_id);
-          p->paused_timeout_id = 0;
-        }
+        bt_song_remove_paused_timeout (self);
         break;
       default:
         break;
@@ -759,10 +1014,7 @@ on_song_async_done (const GstBus * const bus, GstMessage * message,
 
   if (GST_MESSAGE_SRC (message) == GST_OBJECT (self->priv->bin)) {
     GST_INFO ("async operation done");
-    if (self->priv->paused_timeout_id) {
-      g_source_remove (self->priv->paused_timeout_id);
-      self->priv->paused_timeout_id = 0;
-    }
+    bt_song_remove_paused_timeout (self);
   }
 }
 
@@ -823,45 +1075,21 @@ on_song_request_state (const GstBus * const bus, GstMessage * message,
   //}
 }
 
-#ifdef DETAILED_CPU_LOAD
 static void
-on_song_stream_status (const GstBus * const bus, GstMessage * message,
+on_song_stream_status_sync (const GstBus * const bus, GstMessage * message,
     gconstpointer user_data)
 {
-  //const BtSong * const self = BT_SONG(user_data);
+  const BtSong *const self = BT_SONG (user_data);
   GstStreamStatusType type;
   GstElement *owner;
 
   gst_message_parse_stream_status (message, &type, &owner);
-
-  GST_WARNING_OBJECT (GST_MESSAGE_SRC (message), "new stream status '%d' on %s",
-      type, GST_OBJECT_NAME (owner));
-  /* we could use this to determine CPU usage per thread
-   * - for that we need to periodically call getrusage(RUSAGE_THREAD,&ru);
-   *   from each thread
-   * - this could be done from a dataprobe on the pad that starts the thread or even
-   *   all pads in that thread
-   * - the dataprobe would
-   *   - need a previous ClockTime, elapsed wallclock time and a pointer to the
-   *     BtMachine, we could have a global hashtable that maps thread-id to a
-   *     BtPerfData struct
-   *   - set the cpu-load value on the BtMachine (no notify!)
-   * - the application can poll the value from a machine property
-   *   and show load-meters in the UI
-   */
-
-  switch (type) {
-    case GST_STREAM_STATUS_TYPE_CREATE:
-      // TODO(ensonic): add to thread-id -> perf-data map
-      break;
-    case GST_STREAM_STATUS_TYPE_DESTROY:
-      // TODO(ensonic): remove from thread-id -> perf data map
-      break;
-    default:
-      break;
+  // this is posted from within the new streaming thread
+  if (type == GST_STREAM_STATUS_TYPE_ENTER) {
+    GST_DEBUG_OBJECT (owner, "setup new streaming thread");
+    bt_song_setup_streaming_thread (self, owner);
   }
 }
-#endif
 
 static void
 bt_song_on_loop_changed (BtSequence * const sequence, GParamSpec * const arg,
@@ -911,6 +1139,31 @@ bt_song_on_latency_changed (BtSongInfo * const song_info,
   bt_song_send_audio_context (BT_SONG (user_data));
 }
 
+static void
+bt_song_on_setup_changed (BtSetup * const setup, GObject * const object,
+    gconstpointer user_data)
+{
+  const BtSong *const self = BT_SONG (user_data);
+
+  return_if_disposed ();
+  if (!bt_sequence_is_compiled (self->priv->sequence))
+    return;
+
+  // the schedule depends on the machines and wires, rebuild it
+  GST_DEBUG ("setup changed, recompile the sequence");
+  g_object_set (self->priv->sequence, "compiled", FALSE, NULL);
+  if (self->priv->is_playing || self->priv->is_preparing)
+    g_object_set (self->priv->sequence, "compiled", TRUE, NULL);
+}
+
+static void
+bt_song_on_thread_settings_changed (BtSettings * const settings,
+    GParamSpec * const arg, gconstpointer user_data)
+{
+  // this applies to streaming threads that get started afterwards
+  bt_song_read_thread_settings (BT_SONG (user_data));
+}
+
 /* required for live mode */
 
 /*
@@ -934,13 +1187,17 @@ bt_song_idle_start (const BtSong * const self)
   GstStateChangeReturn res;
 
   GST_INFO ("prepare idle loop");
+  g_mutex_lock (&self->priv->loop_lock);
   self->priv->is_idle_active = TRUE;
+  g_mutex_unlock (&self->priv->loop_lock);
   // prepare idle loop
   if ((res =
           gst_element_set_state (GST_ELEMENT (self->priv->bin),
               GST_STATE_PAUSED)) == GST_STATE_CHANGE_FAILURE) {
     GST_WARNING ("can't go to paused state");
+    g_mutex_lock (&self->priv->loop_lock);
     self->priv->is_idle_active = FALSE;
+    g_mutex_unlock (&self->priv->loop_lock);
     return FALSE;
   }
   GST_DEBUG ("->PAUSED state change returned '%s'",
@@ -956,7 +1213,9 @@ bt_song_idle_start (const BtSong * const self)
           gst_element_set_state (GST_ELEMENT (self->priv->bin),
               GST_STATE_PLAYING)) == GST_STATE_CHANGE_FAILURE) {
     GST_WARNING ("can't go to playing state");
+    g_mutex_lock (&self->priv->loop_lock);
     self->priv->is_idle_active = FALSE;
+    g_mutex_unlock (&self->priv->loop_lock);
     return FALSE;
   }
   GST_DEBUG (">PLAYING state change returned '%s'",
@@ -988,7 +1247,9 @@ bt_song_idle_stop (const BtSong * const self)
   }
   GST_DEBUG ("state change returned '%s'",
       gst_element_state_change_return_get_name (res));
+  g_mutex_lock (&self->priv->loop_lock);
   self->priv->is_idle_active = FALSE;
+  g_mutex_unlock (&self->priv->loop_lock);
   return TRUE;
 }
 
@@ -1046,8 +1307,13 @@ bt_song_play (const BtSong * const self)
     bt_song_idle_stop (self);
 
   GST_INFO ("prepare playback");
+  // flatten the patterns for the controllers
+  if (bt_experiments_check_active (BT_EXPERIMENT_COMPILED_SONG))
+    g_object_set (self->priv->sequence, "compiled", TRUE, NULL);
   // update play-pos
   bt_song_update_play_seek_event_and_play_pos (self);
+  // the buffer size depends on the sink mode, which might have changed
+  bt_song_send_audio_context (self);
   // prepare playback
   self->priv->is_preparing = TRUE;
 
@@ -1082,9 +1348,12 @@ bt_song_play (const BtSong * const self)
     case GST_STATE_CHANGE_ASYNC:
       GST_INFO ("->PLAYING needs async wait");
       // start a short timeout that aborts playback if if get not started
-      self->priv->paused_timeout_id =
-          g_timeout_add_seconds (STATE_CHANGE_TIMEOUT, on_song_paused_timeout,
-          (gpointer) self);
+      self->priv->paused_timeout =
+          g_timeout_source_new_seconds (STATE_CHANGE_TIMEOUT);
+      g_source_set_callback (self->priv->paused_timeout,
+          on_song_paused_timeout, (gpointer) self, NULL);
+      g_source_attach (self->priv->paused_timeout,
+          g_main_context_get_thread_default ());
       break;
     default:
       GST_WARNING ("unexpected state-change-return %d:%s", res,
@@ -1128,10 +1397,7 @@ bt_song_stop (const BtSong * const self)
       gst_element_state_change_return_get_name (res));
 
   // kill a pending timeout
-  if (self->priv->paused_timeout_id) {
-    g_source_remove (self->priv->paused_timeout_id);
-    self->priv->paused_timeout_id = 0;
-  }
+  bt_song_remove_paused_timeout (self);
   // do not stop if not playing or not preparing
   if (self->priv->is_preparing) {
     self->priv->is_preparing = FALSE;
@@ -1141,9 +1407,13 @@ bt_song_stop (const BtSong * const self)
     goto done;
 
   GST_INFO ("playback stopped");
+  g_mutex_lock (&self->priv->loop_lock);
   self->priv->is_playing = FALSE;
+  g_mutex_unlock (&self->priv->loop_lock);
 
 done:
+  // the compiled schedule is kept up to date by the sequence, so that the next
+  // playback can reuse it, changes to the setup invalidate it
   g_object_notify (G_OBJECT (self), "is-playing");
   if (self->priv->is_idle)
     bt_song_idle_start (self);
@@ -1403,6 +1673,20 @@ bt_song_write_to_lowlevel_dot_file (const BtSong * const self)
       PACKAGE_NAME);
 }
 
+/*
+ * bt_song_is_parallel:
+ * @self: the song
+ *
+ * Check the scheduling mode without the overhead of g_object_get().
+ *
+ * Returns: %TRUE if each machine runs in a streaming thread of its own
+ */
+gboolean
+bt_song_is_parallel (const BtSong * const self)
+{
+  return self->priv->parallel;
+}
+
 //-- io interface
 
 static xmlNodePtr
@@ -1502,13 +1786,16 @@ bt_song_constructed (GObject * object)
   g_return_if_fail (BT_IS_APPLICATION (self->priv->app));
 
   g_object_get ((gpointer) (self->priv->app), "bin", &self->priv->bin, NULL);
+  bt_song_read_thread_settings (self);
 
   GstBus *const bus = gst_element_get_bus (GST_ELEMENT (self->priv->bin));
   if (bus) {
     GST_DEBUG ("listen to bus messages (%p)", bus);
     gst_bus_add_signal_watch_full (bus, G_PRIORITY_HIGH);
+#ifndef GST_DISABLE_GST_DEBUG
     bt_g_signal_connect_object (bus, "message::segment-done",
         G_CALLBACK (on_song_segment_done), (gpointer) self, 0);
+#endif
     bt_g_signal_connect_object (bus, "message::eos", G_CALLBACK (on_song_eos),
         (gpointer) self, 0);
     bt_g_signal_connect_object (bus, "message::state-changed",
@@ -1521,10 +1808,11 @@ bt_song_constructed (GObject * object)
         G_CALLBACK (on_song_latency), (gpointer) self, 0);
     bt_g_signal_connect_object (bus, "message::request-state",
         G_CALLBACK (on_song_request_state), (gpointer) self, 0);
-#ifdef DETAILED_CPU_LOAD
-    bt_g_signal_connect_object (bus, "message::stream-status",
-        G_CALLBACK (on_song_stream_status), (gpointer) self, 0);
-#endif
+    gst_bus_enable_sync_message_emission (bus);
+    bt_g_signal_connect_object (bus, "sync-message::stream-status",
+        G_CALLBACK (on_song_stream_status_sync), (gpointer) self, 0);
+    bt_g_signal_connect_object (bus, "sync-message::segment-done",
+        G_CALLBACK (on_song_segment_done_sync), (gpointer) self, 0);
 
     gst_bus_set_flushing (bus, FALSE);
     gst_object_unref (bus);
@@ -1545,6 +1833,15 @@ bt_song_constructed (GObject * object)
   g_signal_connect_object (self->priv->sequence, "notify::length",
       G_CALLBACK (bt_song_on_length_changed), (gpointer) self, 0);
   GST_DEBUG ("  sequence-signals connected");
+  g_signal_connect_object (self->priv->setup, "machine-added",
+      G_CALLBACK (bt_song_on_setup_changed), (gpointer) self, 0);
+  g_signal_connect_object (self->priv->setup, "machine-removed",
+      G_CALLBACK (bt_song_on_setup_changed), (gpointer) self, 0);
+  g_signal_connect_object (self->priv->setup, "wire-added",
+      G_CALLBACK (bt_song_on_setup_changed), (gpointer) self, 0);
+  g_signal_connect_object (self->priv->setup, "wire-removed",
+      G_CALLBACK (bt_song_on_setup_changed), (gpointer) self, 0);
+  GST_DEBUG ("  setup-signals connected");
   g_signal_connect_object (self->priv->song_info, "notify::tpb",
       G_CALLBACK (bt_song_on_tempo_changed), (gpointer) self, 0);
   g_signal_connect_object (self->priv->song_info, "notify::bpm",
@@ -1552,6 +1849,12 @@ bt_song_constructed (GObject * object)
   GST_DEBUG ("  song-info-signals connected");
   g_signal_connect_object (settings, "notify::latency",
       G_CALLBACK (bt_song_on_latency_changed), (gpointer) self, 0);
+  g_signal_connect_object (settings, "notify::realtime-policy",
+      G_CALLBACK (bt_song_on_thread_settings_changed), (gpointer) self, 0);
+  g_signal_connect_object (settings, "notify::realtime-priority",
+      G_CALLBACK (bt_song_on_thread_settings_changed), (gpointer) self, 0);
+  g_signal_connect_object (settings, "notify::cpu-affinity",
+      G_CALLBACK (bt_song_on_thread_settings_changed), (gpointer) self, 0);
   g_object_unref (settings);
 
   bt_song_send_audio_context (self);
@@ -1609,6 +1912,9 @@ bt_song_get_property (GObject * const object, const guint property_id,
     case SONG_IO:
       g_value_set_object (value, self->priv->song_io);
       break;
+    case SONG_PARALLEL:
+      g_value_set_boolean (value, self->priv->parallel);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, property_id, pspec);
       break;
@@ -1670,6 +1976,19 @@ bt_song_set_property (GObject * const object, const guint property_id,
       GST_DEBUG ("set the song-io plugin for the song: %p",
           self->priv->song_io);
       break;
+    case SONG_PARALLEL:{
+      gboolean parallel = g_value_get_boolean (value);
+      if (parallel != self->priv->parallel) {
+        if (self->priv->is_playing) {
+          GST_WARNING ("can't change the scheduling mode while playing");
+        } else {
+          self->priv->parallel = parallel;
+          GST_DEBUG ("set the parallel scheduling mode: %d", parallel);
+          bt_song_update_scheduling (self);
+        }
+      }
+      break;
+    }
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, property_id, pspec);
       break;
@@ -1688,8 +2007,7 @@ bt_song_dispose (GObject * const object)
 
   if (self->priv->playback_timeout_id)
     g_source_remove (self->priv->playback_timeout_id);
-  if (self->priv->paused_timeout_id)
-    g_source_remove (self->priv->paused_timeout_id);
+  bt_song_remove_paused_timeout (self);
 
   if (self->priv->bin) {
     if (self->priv->is_playing)
@@ -1698,6 +2016,7 @@ bt_song_dispose (GObject * const object)
       bt_song_idle_stop (self);
 
     GstBus *const bus = gst_element_get_bus (GST_ELEMENT (self->priv->bin));
+    gst_bus_disable_sync_message_emission (bus);
     gst_bus_remove_signal_watch (bus);
     gst_object_unref (bus);
   }
@@ -1751,7 +2070,6 @@ bt_song_dispose (GObject * const object)
   GST_DEBUG ("  done");
 }
 
-#ifndef GST_DISABLE_GST_DEBUG
 static void
 bt_song_finalize (GObject * const object)
 {
@@ -1759,11 +2077,13 @@ bt_song_finalize (GObject * const object)
 
   GST_DEBUG ("!!!! self=%p", self);
 
+  g_mutex_clear (&self->priv->loop_lock);
+  g_mutex_clear (&self->priv->thread_settings_lock);
+
   GST_DEBUG ("  chaining up");
   G_OBJECT_CLASS (bt_song_parent_class)->finalize (object);
   GST_DEBUG ("  done");
 }
-#endif
 
 //-- class internals
 
@@ -1781,6 +2101,8 @@ bt_song_init (BtSong * self)
   e = (GstClockTime) (G_MAXINT64 - (1 * GST_SECOND));
   self->priv->idle_seek_event = MAKE_SEEK_EVENT_FL (1.0, s, e);
   self->priv->idle_loop_seek_event = MAKE_SEEK_EVENT_L (1.0, s, e);
+  g_mutex_init (&self->priv->loop_lock);
+  g_mutex_init (&self->priv->thread_settings_lock);
   GST_DEBUG ("  done");
 }
 
@@ -1793,9 +2115,7 @@ bt_song_class_init (BtSongClass * const klass)
   gobject_class->set_property = bt_song_set_property;
   gobject_class->get_property = bt_song_get_property;
   gobject_class->dispose = bt_song_dispose;
-#ifndef GST_DISABLE_GST_DEBUG
   gobject_class->finalize = bt_song_finalize;
-#endif
 
   g_object_class_install_property (gobject_class, SONG_APP,
       g_param_spec_object ("app", "app contruct prop",
@@ -1859,4 +2179,22 @@ bt_song_class_init (BtSongClass * const klass)
       g_param_spec_object ("song-io", "song-io prop",
           "the song-io plugin during i/o operations",
           BT_TYPE_SONG_IO, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  /**
+   * BtSong:parallel:
+   *
+   * Run each machine in a streaming thread of its own. All wires get a queue,
+   * so that a chain of machines is processed as a pipeline and independent
+   * chains only meet at the mixer inputs. This scales with the number of
+   * cores, but adds a buffer of latency per wire. Use the 'cpu-affinity'
+   * setting to spread the threads over the cores. Can only be changed when
+   * the song is not playing.
+   *
+   * Since: 0.12
+   */
+  g_object_class_install_property (gobject_class, SONG_PARALLEL,
+      g_param_spec_boolean ("parallel",
+          "parallel prop",
+          "run each machine in a thread of its own",
+          FALSE, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 }
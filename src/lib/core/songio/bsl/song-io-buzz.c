@@ -157,10 +157,8 @@ typedef struct
   const BtSongIOBuzz *self;
 } CompressionCtx;
 
-static CompressionCtx ctxt = { {0,}, 0 };
-
 static guint32
-unpack_bits (guint32 amount)
+unpack_bits (CompressionCtx * ctxt, guint32 amount)
 {
   guint32 ret = 0, shift = 0;
   guint32 size, mask, val;
@@ -169,41 +167,43 @@ unpack_bits (guint32 amount)
 
   GST_LOG ("unpack_bits(%d)", amount);
 
-  if ((ctxt.bytes_in_file_remain == 0) && (ctxt.cur_index == MAXPACKEDBUFFER)) {
+  if ((ctxt->bytes_in_file_remain == 0)
+      && (ctxt->cur_index == MAXPACKEDBUFFER)) {
     GST_WARNING ("unpack_bits().1 = 0 : eof");
-    ctxt.error = TRUE;
+    ctxt->error = TRUE;
     return 0;
   }
 
   while (amount > 0) {
     //check to see if we need to update buffer and/or index
-    if ((ctxt.cur_bit == max_bits) || (ctxt.bytes_in_buffer == 0)) {
-      ctxt.cur_bit = 0;
-      ctxt.cur_index++;
-      if (ctxt.cur_index >= ctxt.bytes_in_buffer) {
+    if ((ctxt->cur_bit == max_bits) || (ctxt->bytes_in_buffer == 0)) {
+      ctxt->cur_bit = 0;
+      ctxt->cur_index++;
+      if (ctxt->cur_index >= ctxt->bytes_in_buffer) {
         //run out of buffer... read more file into buffer
         amount_needed =
-            (ctxt.bytes_in_file_remain >
-            ctxt.max_bytes) ? ctxt.max_bytes : ctxt.bytes_in_file_remain;
+            (ctxt->bytes_in_file_remain >
+            ctxt->max_bytes) ? ctxt->max_bytes : ctxt->bytes_in_file_remain;
 
-        amount_got = mem_read (ctxt.self, ctxt.packed_buf, 1, amount_needed);
+        amount_got =
+            mem_read (ctxt->self, ctxt->packed_buf, 1, amount_needed);
         GST_LOG ("reading %u bytes at pos %ld and got %u bytes",
-            amount_needed, ctxt.self->priv->data_pos, amount_got);
+            amount_needed, ctxt->self->priv->data_pos, amount_got);
 
-        ctxt.bytes_in_file_remain -= amount_got;
-        ctxt.bytes_in_buffer = amount_got;
-        ctxt.cur_index = 0;
+        ctxt->bytes_in_file_remain -= amount_got;
+        ctxt->bytes_in_buffer = amount_got;
+        ctxt->cur_index = 0;
 
         //if we didnt read anything then exit now
         if (amount_got == 0) {
           //make sure nothing else is read
-          ctxt.bytes_in_file_remain = 0;
-          ctxt.cur_index = MAXPACKEDBUFFER;
-          ctxt.error = TRUE;
+          ctxt->bytes_in_file_remain = 0;
+          ctxt->cur_index = MAXPACKEDBUFFER;
+          ctxt->error = TRUE;
           if (amount_needed == 0) {
             GST_WARNING
                 ("got 0 bytes, wanted 0 bytes, %u bytes in file remain, fpos %ld",
-                ctxt.bytes_in_file_remain, ctxt.self->priv->data_pos);
+                ctxt->bytes_in_file_remain, ctxt->self->priv->data_pos);
           } else {
             GST_WARNING ("got 0 bytes, wanted %u bytes", amount_needed);
           }
@@ -212,15 +212,15 @@ unpack_bits (guint32 amount)
       }
     }
     //calculate size to read from current guint32
-    size =
-        ((amount + ctxt.cur_bit) > max_bits) ? max_bits - ctxt.cur_bit : amount;
+    size = ((amount + ctxt->cur_bit) > max_bits) ?
+        max_bits - ctxt->cur_bit : amount;
 
     //calculate bitmask
     mask = (1 << size) - 1;
 
     //Read value from buffer
-    val = ctxt.packed_buf[ctxt.cur_index];
-    val = val >> ctxt.cur_bit;
+    val = ctxt->packed_buf[ctxt->cur_index];
+    val = val >> ctxt->cur_bit;
 
     //apply mask to value
     val &= mask;
@@ -232,7 +232,7 @@ unpack_bits (guint32 amount)
     ret |= val;
 
     //update info
-    ctxt.cur_bit += size;
+    ctxt->cur_bit += size;
     shift += size;
     amount -= size;
   }
@@ -241,17 +241,17 @@ unpack_bits (guint32 amount)
 }
 
 static guint32
-count_zero_bits (void)
+count_zero_bits (CompressionCtx * ctxt)
 {
   guint32 bit;
   guint32 count = 0;
 
   GST_LOG ("count_zero_bits()");
 
-  bit = unpack_bits (1);
-  while ((bit == 0) && (!ctxt.error)) {
+  bit = unpack_bits (ctxt, 1);
+  while ((bit == 0) && (!ctxt->error)) {
     count++;
-    bit = unpack_bits (1);
+    bit = unpack_bits (ctxt, 1);
   }
   GST_LOG ("count_zero_bits() = %u", count);
   return count;
@@ -281,8 +281,8 @@ free_compression_values (CompressionValues * cv)
 }
 
 static gboolean
-decompress_samples (CompressionValues * cv, guint16 * outbuf,
-    guint32 block_size)
+decompress_samples (CompressionCtx * ctxt, CompressionValues * cv,
+    guint16 * outbuf, guint32 block_size)
 {
   guint32 switch_value, bits, size, zero_count;
   guint32 val;
@@ -293,18 +293,18 @@ decompress_samples (CompressionValues * cv, guint16 * outbuf,
     return FALSE;
 
   //Get compression method
-  switch_value = unpack_bits (2);
+  switch_value = unpack_bits (ctxt, 2);
 
   //read size (in bits) of compressed values
-  bits = unpack_bits (4);
+  bits = unpack_bits (ctxt, 4);
 
   size = block_size;
-  while ((size > 0) && (!ctxt.error)) {
+  while ((size > 0) && (!ctxt->error)) {
     //read compressed value
-    val = (guint16) unpack_bits (bits);
+    val = (guint16) unpack_bits (ctxt, bits);
 
     //count zeros
-    zero_count = count_zero_bits ();
+    zero_count = count_zero_bits (ctxt);
 
     //construct
     val = (guint16) ((zero_count << bits) | val);
@@ -350,12 +350,13 @@ decompress_samples (CompressionValues * cv, guint16 * outbuf,
     *outbuf++ = cv->result;
     size--;
   }
-  GST_LOG ("decompress_samples() = %d", !ctxt.error);
-  return !ctxt.error;
+  GST_LOG ("decompress_samples() = %d", !ctxt->error);
+  return !ctxt->error;
 }
 
 static gboolean
-decompress_wave (guint16 * outbuf, guint32 num_samples, guint channels)
+decompress_wave (CompressionCtx * ctxt, guint16 * outbuf, guint32 num_samples,
+    guint channels)
 {
   guint32 zero_count, shift, block_size, last_block_size, num_blocks;
   guint32 result_shift, count, i, j;
@@ -367,13 +368,13 @@ decompress_wave (guint16 * outbuf, guint32 num_samples, guint channels)
   if (!outbuf)
     return FALSE;
 
-  zero_count = count_zero_bits ();
+  zero_count = count_zero_bits (ctxt);
   if (zero_count) {
     GST_WARNING ("Unknown wave data compression %d\n", zero_count);
     return FALSE;
   }
   //get size shifter
-  shift = unpack_bits (4);
+  shift = unpack_bits (ctxt, 4);
 
   //get size of compressed blocks
   block_size = 1 << shift;
@@ -385,7 +386,7 @@ decompress_wave (guint16 * outbuf, guint32 num_samples, guint channels)
   last_block_size = (block_size - 1) & num_samples;
 
   //get result shifter value (used to shift data after decompression)
-  result_shift = unpack_bits (4);
+  result_shift = unpack_bits (ctxt, 4);
 
   GST_DEBUG ("before decomp loop: "
       " shift = %u"
@@ -408,7 +409,7 @@ decompress_wave (guint16 * outbuf, guint32 num_samples, guint channels)
         block_size = last_block_size;
       }
 
-      if (!decompress_samples (&cv1, outbuf, block_size)) {
+      if (!decompress_samples (ctxt, &cv1, outbuf, block_size)) {
         GST_WARNING ("abort with %d remaining blocks", count);
         return FALSE;
       }
@@ -425,7 +426,7 @@ decompress_wave (guint16 * outbuf, guint32 num_samples, guint channels)
     }
   } else {                      // stereo handling
     //read "channel sum" flag
-    sum_channels = (guint8) unpack_bits (1);
+    sum_channels = (guint8) unpack_bits (ctxt, 1);
 
     //zero internal compression values and alloc some temporary space
     init_compression_values (&cv1, block_size);
@@ -440,8 +441,8 @@ decompress_wave (guint16 * outbuf, guint32 num_samples, guint channels)
         block_size = last_block_size;
       }
       //decompress both channels into temporary area
-      if ((!decompress_samples (&cv1, cv1.temp, block_size)) ||
-          (!decompress_samples (&cv2, cv2.temp, block_size)))
+      if ((!decompress_samples (ctxt, &cv1, cv1.temp, block_size)) ||
+          (!decompress_samples (ctxt, &cv2, cv2.temp, block_size)))
         return FALSE;
 
       for (i = 0; i < block_size; i++) {
@@ -2013,6 +2014,7 @@ read_cwav_section (const BtSongIOBuzz * self, const BtSong * song)
   GList *list, *node;
   gulong bytes, length, remain;
   guint channels;
+  CompressionCtx ctxt = { {0,}, 0 };
 
   // this section is optional
   if (!entry)
@@ -2132,7 +2134,7 @@ read_cwav_section (const BtSongIOBuzz * self, const BtSong * song)
             }
             remain -= bytes;
           } else {
-            decompress_wave ((guint16 *) data, length, channels);
+            decompress_wave (&ctxt, (guint16 *) data, length, channels);
           }
           g_object_set (wavelevel, "data", data, NULL);
           // DEBUG
@@ -186,6 +186,31 @@ bt_gst_check_elements (GList * list)
   return res;
 }
 
+static gpointer
+bt_gst_check_core_elements_once (gpointer data)
+{
+  GList *core_elements = NULL;
+  GList *res;
+
+  // gstreamer
+  core_elements = g_list_prepend (core_elements, "capsfilter");
+  core_elements = g_list_prepend (core_elements, "fdsrc");
+  core_elements = g_list_prepend (core_elements, "fdsink");
+  core_elements = g_list_prepend (core_elements, "filesink");
+  core_elements = g_list_prepend (core_elements, "identity");
+  core_elements = g_list_prepend (core_elements, "queue");
+  core_elements = g_list_prepend (core_elements, "tee");
+  // gst-plugins-base
+  core_elements = g_list_prepend (core_elements, "audioconvert");
+  core_elements = g_list_prepend (core_elements, "audioresample");
+  core_elements = g_list_prepend (core_elements, "audiotestsrc");
+  core_elements = g_list_prepend (core_elements, "adder");
+  core_elements = g_list_prepend (core_elements, "volume");
+  res = bt_gst_check_elements (core_elements);
+  g_list_free (core_elements);
+  return res;
+}
+
 /**
  * bt_gst_check_core_elements:
  *
@@ -198,37 +223,13 @@ bt_gst_check_elements (GList * list)
 GList *
 bt_gst_check_core_elements (void)
 {
-  static GList *core_elements = NULL;
-  static GList *res = NULL;
-  static gboolean core_elements_checked = FALSE;
+  static GOnce core_elements_once = G_ONCE_INIT;
 
   /* TODO(ensonic): if registry ever gets a 'changed' signal, we need to connect to that and
-   * reset core_elements_checked to FALSE
+   * reset core_elements_once
    * There is gst_registry_get_feature_list_cookie() now
    */
-  if (!core_elements_checked) {
-    // gstreamer
-    core_elements = g_list_prepend (core_elements, "capsfilter");
-    core_elements = g_list_prepend (core_elements, "fdsrc");
-    core_elements = g_list_prepend (core_elements, "fdsink");
-    core_elements = g_list_prepend (core_elements, "filesink");
-    core_elements = g_list_prepend (core_elements, "identity");
-    core_elements = g_list_prepend (core_elements, "queue");
-    core_elements = g_list_prepend (core_elements, "tee");
-    // gst-plugins-base
-    core_elements = g_list_prepend (core_elements, "audioconvert");
-    core_elements = g_list_prepend (core_elements, "audioresample");
-    core_elements = g_list_prepend (core_elements, "audiotestsrc");
-    core_elements = g_list_prepend (core_elements, "adder");
-    core_elements = g_list_prepend (core_elements, "volume");
-    core_elements_checked = TRUE;
-    res = bt_gst_check_elements (core_elements);
-    g_list_free (core_elements);
-    core_elements = res;
-  } else {
-    res = core_elements;
-  }
-  return res;
+  return g_once (&core_elements_once, bt_gst_check_core_elements_once, NULL);
 }
 
 //-- gst safe linking
@@ -935,11 +936,6 @@ bt_g_signal_connect_object (gpointer instance, const gchar * detailed_signal,
 static GstClockTime treal_last = G_GINT64_CONSTANT (0), tuser_last =
 G_GINT64_CONSTANT (0), tsys_last = G_GINT64_CONSTANT (0);
 //long clk=1;
-//long num_cpus;
-
-#if WIN32
-#include <windows.h>            //For GetSystemInfo
-#endif
 
 
 /*
@@ -953,23 +949,13 @@ bt_cpu_load_init (void)
   treal_last = gst_util_get_timestamp ();
   //clk=sysconf(_SC_CLK_TCK);
 
-  /* TODO(ensonic): we might need to handle multi core cpus and divide by num-cores
-   * http://lxr.linux.no/linux/include/linux/cpumask.h
-   #ifndef WIN32
-   num_cpus = sysconf (_SC_NPROCESSORS_ONLN);
-   #else
-   SYSTEM_INFO si;
-   GetSystemInfo(&si);
-   num_cpus = si.dwNumberOfProcessors;
-   #endif
-   */
 }
 
 /**
  * bt_cpu_load_get_current:
  *
  * Determines the current CPU load. Run this from a timeout handler (with e.g. a
- * 1 second interval).
+ * 1 second interval). The load is relative to all cpu cores.
  *
  * Returns: CPU usage as integer ranging from 0% to 100%
  */
@@ -994,10 +980,10 @@ bt_cpu_load_get_current (void)
   tnow = GST_TIMEVAL_TO_TIME (rus.ru_stime);
   tsys = tnow - tsys_last;
   tsys_last = tnow;
-  // percentage
+  // percentage of all cores
   cpuload =
       (guint) gst_util_uint64_scale (tuser + tsys, G_GINT64_CONSTANT (100),
-      treal);
+      treal * g_get_num_processors ());
   cpuload = (cpuload < 100) ? cpuload : 100;
   GST_LOG ("real %" GST_TIME_FORMAT ", user %" GST_TIME_FORMAT ", sys %"
       GST_TIME_FORMAT " => cpuload %d", GST_TIME_ARGS (treal),
@@ -1007,6 +993,146 @@ bt_cpu_load_get_current (void)
   return cpuload;
 }
 
+//-- per machine/wire cpu load accounting
+
+/* thread cpu time spent in accounted parts (see bt_perf_data_stop()) */
+static GPrivate accounted_time = G_PRIVATE_INIT (g_free);
+
+static GstClockTime
+bt_cpu_load_get_thread_time (void)
+{
+#if defined(HAVE_CLOCK_GETTIME) && defined(CLOCK_THREAD_CPUTIME_ID)
+  struct timespec ts;
+
+  clock_gettime (CLOCK_THREAD_CPUTIME_ID, &ts);
+  return GST_TIMESPEC_TO_TIME (ts);
+#elif defined(RUSAGE_THREAD)
+  struct rusage rus;
+
+  getrusage (RUSAGE_THREAD, &rus);
+  return GST_TIMEVAL_TO_TIME (rus.ru_utime) + GST_TIMEVAL_TO_TIME (rus.ru_stime);
+#else
+  return gst_util_get_timestamp ();
+#endif
+}
+
+static GstClockTime
+bt_cpu_load_get_accounted_time (void)
+{
+  GstClockTime *accounted = g_private_get (&accounted_time);
+
+  return accounted ? *accounted : 0;
+}
+
+static void
+bt_cpu_load_add_accounted_time (GstClockTime time)
+{
+  GstClockTime *accounted = g_private_get (&accounted_time);
+
+  if (!accounted) {
+    accounted = g_new0 (GstClockTime, 1);
+    g_private_set (&accounted_time, accounted);
+  }
+  *accounted += time;
+}
+
+/*
+ * bt_perf_data_init:
+ * @self: the perf data
+ *
+ * Reset the history.
+ */
+void
+bt_perf_data_init (BtPerfData * self)
+{
+  memset (self, 0, sizeof (BtPerfData));
+  self->start = GST_CLOCK_TIME_NONE;
+}
+
+/*
+ * bt_perf_data_start:
+ * @self: the perf data
+ *
+ * Call this when a buffer enters the part. Use this from a pad-probe.
+ */
+void
+bt_perf_data_start (BtPerfData * self)
+{
+  self->thread = g_thread_self ();
+  self->accounted = bt_cpu_load_get_accounted_time ();
+  self->start = bt_cpu_load_get_thread_time ();
+}
+
+/*
+ * bt_perf_data_stop:
+ * @self: the perf data
+ * @duration: the duration of the buffer
+ *
+ * Call this when the buffer leaves the part. Use this from a pad-probe. The
+ * processing time is recorded, unless the buffer changed threads.
+ */
+void
+bt_perf_data_stop (BtPerfData * self, GstClockTime duration)
+{
+  GstClockTime now, time, accounted;
+
+  if (self->thread != g_thread_self () || !GST_CLOCK_TIME_IS_VALID (self->start)
+      || !GST_CLOCK_TIME_IS_VALID (duration))
+    return;
+
+  now = bt_cpu_load_get_thread_time ();
+  accounted = bt_cpu_load_get_accounted_time () - self->accounted;
+  time = now - self->start;
+  // don't count nested parts twice
+  time = (time > accounted) ? time - accounted : 0;
+  bt_cpu_load_add_accounted_time (time);
+
+  self->time[self->pos] = time;
+  self->duration[self->pos] = duration;
+  self->pos = (self->pos + 1) % BT_PERF_DATA_HISTORY;
+  self->start = GST_CLOCK_TIME_NONE;
+}
+
+/*
+ * bt_perf_data_restart:
+ * @self: the perf data
+ * @duration: the duration of the buffer
+ *
+ * For sources, which have no input: record the time since the previous buffer
+ * minus the time spent in accounted parts downstream and start over.
+ */
+void
+bt_perf_data_restart (BtPerfData * self, GstClockTime duration)
+{
+  bt_perf_data_stop (self, duration);
+  bt_perf_data_start (self);
+}
+
+/*
+ * bt_perf_data_get_load:
+ * @self: the perf data
+ *
+ * Get the load over the recent buffers.
+ *
+ * Returns: the processing time in percent of the buffer durations, values
+ * above 100 mean that the part can't keep up with realtime
+ */
+guint
+bt_perf_data_get_load (const BtPerfData * self)
+{
+  GstClockTime time = 0, duration = 0;
+  guint i;
+
+  for (i = 0; i < BT_PERF_DATA_HISTORY; i++) {
+    time += self->time[i];
+    duration += self->duration[i];
+  }
+  if (!duration)
+    return 0;
+  return (guint) gst_util_uint64_scale (time, G_GINT64_CONSTANT (100),
+      duration);
+}
+
 //-- string formatting helper
 
 /**
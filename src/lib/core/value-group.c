@@ -25,12 +25,15 @@
  * and one for plain fields. This allows step wise entry of data (multi column
  * entry of sparse enums). The validated cells are only set as the plain value
  * becomes valid. Invalid values are not copied nor are they stored in the song.
- */
-/* TODO(ensonic): consider to lazily create the actual GValue *data array, by
- * keeping a count of non-empty cells
- * - if the count goes up to 1 we allocate
- * - if the count goes down to zero we can free the storage
- * - we can shortcut operations in empty groups
+ *
+ * Most groups in a song never get any data (e.g. unused voices), therefore the
+ * storage is only allocated when the first value is entered and released again
+ * when the last value is removed. Operations on empty groups are shortcut.
+ *
+ * The cells are stored as native values of the parameter type together with a
+ * bitmap of the used cells. #GValues are only created when reading cells
+ * through the API. Groups that are read with bt_value_group_get_event_data()
+ * additionally keep a #GValue view of all validated cells.
  */
 
 #define BT_CORE
@@ -55,6 +58,20 @@ enum
   VALUE_GROUP_LENGTH
 };
 
+/* a cell, the type of the value is given by the column */
+typedef union
+{
+  gint v_int;                   // also used for booleans and enums
+  guint v_uint;
+  glong v_long;
+  gulong v_ulong;
+  gint64 v_int64;
+  guint64 v_uint64;
+  gfloat v_float;
+  gdouble v_double;
+  gchar *v_string;
+} BtValueGroupCell;
+
 struct _BtValueGroupPrivate
 {
   /* used to validate if dispose has run */
@@ -65,20 +82,455 @@ struct _BtValueGroupPrivate
   gulong columns;
   BtParameterGroup *param_group;
 
-  GValue *data;
+  /* the value types and base types of the <columns> columns */
+  GType *types;
+  GType *base_types;
+
+  /* <length>*<columns> cells and a bitmap of the used ones, both %NULL while
+   * the group is empty */
+  BtValueGroupCell *data;
+  guint8 *used;
+  /* the number of set bits in <used> */
+  gulong n_used;
+
+  /* <length>*<params> cells handed out by bt_value_group_get_event_data(),
+   * kept in sync with the data, %NULL until first used */
+  GValue *views;
+
+  /* nesting level of bt_value_group_begin_batch() */
+  guint batch_level;
+  /* the cells changed since the last group-changed notify */
+  gboolean dirty;
+  gulong dirty_beg_tick, dirty_end_tick;
+  gulong dirty_beg_param, dirty_end_param;
 };
 
 static guint signals[LAST_SIGNAL] = { 0, };
 
 //-- the class
 
-G_DEFINE_TYPE_WITH_CODE (BtValueGroup, bt_value_group, G_TYPE_OBJECT, 
+G_DEFINE_TYPE_WITH_CODE (BtValueGroup, bt_value_group, G_TYPE_OBJECT,
     G_ADD_PRIVATE(BtValueGroup));
 
 //-- macros
 
+#define CELL_IS_USED(p,i) (((p)->used[(i) >> 3] & (1 << ((i) & 7))) != 0)
+#define CELL_MARK_USED(p,i) G_STMT_START {                                     \
+  if (!CELL_IS_USED (p, i)) {                                                  \
+    (p)->used[(i) >> 3] |= (1 << ((i) & 7));                                   \
+    (p)->n_used++;                                                             \
+  }                                                                            \
+} G_STMT_END
+#define CELL_MARK_UNUSED(p,i) G_STMT_START {                                   \
+  if (CELL_IS_USED (p, i)) {                                                   \
+    (p)->used[(i) >> 3] &= ~(1 << ((i) & 7));                                  \
+    (p)->n_used--;                                                             \
+  }                                                                            \
+} G_STMT_END
+
 //-- helper
 
+/*
+ * bt_value_group_ensure_data:
+ * @self: the value-group
+ *
+ * Allocates the event data grid on first use.
+ *
+ * Returns: %FALSE if there is no storage
+ */
+static gboolean
+bt_value_group_ensure_data (const BtValueGroup * const self)
+{
+  if (G_UNLIKELY (!self->priv->data)) {
+    const gulong data_count = self->priv->length * self->priv->columns;
+
+    if (!data_count)
+      return FALSE;
+    self->priv->data = g_try_new0 (BtValueGroupCell, data_count);
+    self->priv->used = g_try_new0 (guint8, (data_count + 7) >> 3);
+    if (!self->priv->data || !self->priv->used) {
+      GST_INFO ("allocating value-group data for length %lu, params = %lu "
+          "failed", self->priv->length, self->priv->params);
+      g_free (self->priv->data);
+      g_free (self->priv->used);
+      self->priv->data = NULL;
+      self->priv->used = NULL;
+      return FALSE;
+    }
+    self->priv->n_used = 0;
+  }
+  return TRUE;
+}
+
+/*
+ * bt_value_group_free_data:
+ * @self: the value-group
+ *
+ * Frees the event data grid including all cell values.
+ */
+static void
+bt_value_group_free_data (const BtValueGroup * const self)
+{
+  BtValueGroupPrivate *const p = self->priv;
+  const gulong data_count = p->length * p->columns;
+  gulong i;
+
+  if (!p->data)
+    return;
+  for (i = 0; i < data_count; i++) {
+    if (CELL_IS_USED (p, i)
+        && p->base_types[i % p->columns] == G_TYPE_STRING)
+      g_free (p->data[i].v_string);
+  }
+  g_free (p->data);
+  g_free (p->used);
+  p->data = NULL;
+  p->used = NULL;
+  p->n_used = 0;
+}
+
+/*
+ * bt_value_group_release_if_empty:
+ * @self: the value-group
+ *
+ * Frees the event data grid if there are no values left.
+ */
+static void
+bt_value_group_release_if_empty (const BtValueGroup * const self)
+{
+  if (!self->priv->data || self->priv->n_used)
+    return;
+  bt_value_group_free_data (self);
+  GST_DEBUG ("released storage of empty value-group");
+}
+
+/*
+ * bt_value_group_unset_cell:
+ * @self: the value-group
+ * @ix: the cell index
+ *
+ * Clears the cell at @ix.
+ */
+static inline void
+bt_value_group_unset_cell (const BtValueGroup * const self, const gulong ix)
+{
+  BtValueGroupPrivate *const p = self->priv;
+
+  if (CELL_IS_USED (p, ix)) {
+    if (p->base_types[ix % p->columns] == G_TYPE_STRING) {
+      g_free (p->data[ix].v_string);
+      p->data[ix].v_string = NULL;
+    }
+    CELL_MARK_UNUSED (p, ix);
+  }
+}
+
+/*
+ * bt_value_group_move_cell:
+ * @self: the value-group
+ * @src: the source cell index
+ * @dst: the target cell index
+ *
+ * Moves the content of the cell @src to @dst and clears @src.
+ */
+static inline void
+bt_value_group_move_cell (const BtValueGroup * const self, const gulong src,
+    const gulong dst)
+{
+  BtValueGroupPrivate *const p = self->priv;
+
+  bt_value_group_unset_cell (self, dst);
+  if (CELL_IS_USED (p, src)) {
+    // ownership of strings moves along
+    p->data[dst] = p->data[src];
+    p->data[src].v_string = NULL;
+    CELL_MARK_USED (p, dst);
+    CELL_MARK_UNUSED (p, src);
+  }
+}
+
+/*
+ * bt_value_group_store_cell:
+ * @self: the value-group
+ * @ix: the cell index
+ * @value: the value to store
+ *
+ * Stores @value in the cell at @ix. The value needs to match the type of the
+ * column.
+ */
+static void
+bt_value_group_store_cell (const BtValueGroup * const self, const gulong ix,
+    const GValue * const value)
+{
+  BtValueGroupPrivate *const p = self->priv;
+  const GType base_type = p->base_types[ix % p->columns];
+  BtValueGroupCell *const cell = &p->data[ix];
+
+  switch (base_type) {
+    case G_TYPE_INT:
+      cell->v_int = g_value_get_int (value);
+      break;
+    case G_TYPE_UINT:
+      cell->v_uint = g_value_get_uint (value);
+      break;
+    case G_TYPE_LONG:
+      cell->v_long = g_value_get_long (value);
+      break;
+    case G_TYPE_ULONG:
+      cell->v_ulong = g_value_get_ulong (value);
+      break;
+    case G_TYPE_INT64:
+      cell->v_int64 = g_value_get_int64 (value);
+      break;
+    case G_TYPE_UINT64:
+      cell->v_uint64 = g_value_get_uint64 (value);
+      break;
+    case G_TYPE_FLOAT:
+      cell->v_float = g_value_get_float (value);
+      break;
+    case G_TYPE_DOUBLE:
+      cell->v_double = g_value_get_double (value);
+      break;
+    case G_TYPE_BOOLEAN:
+      cell->v_int = g_value_get_boolean (value);
+      break;
+    case G_TYPE_ENUM:
+      cell->v_int = g_value_get_enum (value);
+      break;
+    case G_TYPE_STRING:
+      if (CELL_IS_USED (p, ix))
+        g_free (cell->v_string);
+      cell->v_string = g_value_dup_string (value);
+      break;
+    default:
+      GST_WARNING ("unhandled gvalue type %s", g_type_name (base_type));
+      return;
+  }
+  CELL_MARK_USED (p, ix);
+}
+
+/*
+ * bt_value_group_load_cell:
+ * @self: the value-group
+ * @ix: the cell index
+ * @value: the target
+ *
+ * Copies the cell at @ix into @value. Initializes @value to the column type
+ * if needed.
+ */
+static void
+bt_value_group_load_cell (const BtValueGroup * const self, const gulong ix,
+    GValue * const value)
+{
+  const BtValueGroupPrivate *const p = self->priv;
+  const gulong column = ix % p->columns;
+  const BtValueGroupCell *const cell = &p->data[ix];
+
+  if (!BT_IS_GVALUE (value))
+    g_value_init (value, p->types[column]);
+
+  switch (p->base_types[column]) {
+    case G_TYPE_INT:
+      g_value_set_int (value, cell->v_int);
+      break;
+    case G_TYPE_UINT:
+      g_value_set_uint (value, cell->v_uint);
+      break;
+    case G_TYPE_LONG:
+      g_value_set_long (value, cell->v_long);
+      break;
+    case G_TYPE_ULONG:
+      g_value_set_ulong (value, cell->v_ulong);
+      break;
+    case G_TYPE_INT64:
+      g_value_set_int64 (value, cell->v_int64);
+      break;
+    case G_TYPE_UINT64:
+      g_value_set_uint64 (value, cell->v_uint64);
+      break;
+    case G_TYPE_FLOAT:
+      g_value_set_float (value, cell->v_float);
+      break;
+    case G_TYPE_DOUBLE:
+      g_value_set_double (value, cell->v_double);
+      break;
+    case G_TYPE_BOOLEAN:
+      g_value_set_boolean (value, cell->v_int);
+      break;
+    case G_TYPE_ENUM:
+      g_value_set_enum (value, cell->v_int);
+      break;
+    case G_TYPE_STRING:
+      g_value_set_string (value, cell->v_string);
+      break;
+    default:
+      break;
+  }
+}
+
+/*
+ * bt_value_group_sync_views:
+ * @self: the value-group
+ * @beg_tick: the first changed tick
+ * @end_tick: the last changed tick
+ * @beg_param: the first changed param
+ * @end_param: the last changed param
+ *
+ * Updates the #GValue views of the given region after the cells changed.
+ */
+static void
+bt_value_group_sync_views (const BtValueGroup * const self,
+    const gulong beg_tick, const gulong end_tick, const gulong beg_param,
+    const gulong end_param)
+{
+  const BtValueGroupPrivate *const p = self->priv;
+  gulong i, j, ix;
+  GValue *view;
+
+  if (!p->views)
+    return;
+  for (i = beg_tick; i <= end_tick && i < p->length; i++) {
+    for (j = beg_param; j <= end_param && j < p->params; j++) {
+      view = &p->views[i * p->params + j];
+      ix = i * p->columns + j;
+      if (p->data && CELL_IS_USED (p, ix)) {
+        bt_value_group_load_cell (self, ix, view);
+      } else if (BT_IS_GVALUE (view)) {
+        g_value_unset (view);
+      }
+    }
+  }
+}
+
+/*
+ * bt_value_group_free_views:
+ * @self: the value-group
+ * @length: the length the views have been allocated for
+ *
+ * Frees the #GValue views of the cells.
+ */
+static void
+bt_value_group_free_views (const BtValueGroup * const self,
+    const gulong length)
+{
+  BtValueGroupPrivate *const p = self->priv;
+  const gulong view_count = length * p->params;
+  gulong i;
+
+  if (!p->views)
+    return;
+  for (i = 0; i < view_count; i++) {
+    if (BT_IS_GVALUE (&p->views[i]))
+      g_value_unset (&p->views[i]);
+  }
+  g_free (p->views);
+  p->views = NULL;
+}
+
+/*
+ * bt_value_group_mark_dirty:
+ * @self: the value-group
+ * @beg_tick: the first changed tick
+ * @end_tick: the last changed tick
+ * @beg_param: the first changed param
+ * @end_param: the last changed param
+ *
+ * Adds the given region to the changed region.
+ */
+static void
+bt_value_group_mark_dirty (const BtValueGroup * const self,
+    const gulong beg_tick, const gulong end_tick, const gulong beg_param,
+    const gulong end_param)
+{
+  BtValueGroupPrivate *const p = self->priv;
+
+  if (p->dirty) {
+    p->dirty_beg_tick = MIN (p->dirty_beg_tick, beg_tick);
+    p->dirty_end_tick = MAX (p->dirty_end_tick, end_tick);
+    p->dirty_beg_param = MIN (p->dirty_beg_param, beg_param);
+    p->dirty_end_param = MAX (p->dirty_end_param, end_param);
+  } else {
+    p->dirty_beg_tick = beg_tick;
+    p->dirty_end_tick = end_tick;
+    p->dirty_beg_param = beg_param;
+    p->dirty_end_param = end_param;
+    p->dirty = TRUE;
+  }
+}
+
+/*
+ * bt_value_group_flush_changes:
+ * @self: the value-group
+ *
+ * Sends the final group-changed notify for the changed region.
+ */
+static void
+bt_value_group_flush_changes (const BtValueGroup * const self)
+{
+  g_signal_emit ((gpointer) self, signals[GROUP_CHANGED_EVENT], 0,
+      self->priv->param_group, FALSE);
+  self->priv->dirty = FALSE;
+}
+
+/*
+ * bt_value_group_param_changed:
+ * @self: the value-group
+ * @tick: the tick
+ * @param: the param
+ *
+ * Notifies about a single cell change or records it for the current batch.
+ */
+static void
+bt_value_group_param_changed (const BtValueGroup * const self,
+    const gulong tick, const gulong param)
+{
+  if (self->priv->batch_level) {
+    bt_value_group_mark_dirty (self, tick, tick, param, param);
+  } else {
+    g_signal_emit ((gpointer) self, signals[PARAM_CHANGED_EVENT], 0,
+        self->priv->param_group, tick, param);
+  }
+}
+
+/*
+ * bt_value_group_begin_change:
+ * @self: the value-group
+ *
+ * Announces a change of multiple cells, unless a batch is in progress.
+ */
+static void
+bt_value_group_begin_change (const BtValueGroup * const self)
+{
+  if (!self->priv->batch_level) {
+    g_signal_emit ((gpointer) self, signals[GROUP_CHANGED_EVENT], 0,
+        self->priv->param_group, TRUE);
+  }
+}
+
+/*
+ * bt_value_group_end_change:
+ * @self: the value-group
+ * @beg_tick: the first changed tick
+ * @end_tick: the last changed tick
+ * @beg_param: the first changed param
+ * @end_param: the last changed param
+ *
+ * Finishes a change of multiple cells. Releases the storage if the change left
+ * the group empty. The notify is deferred to the end of the batch if one is in
+ * progress.
+ */
+static void
+bt_value_group_end_change (const BtValueGroup * const self,
+    const gulong beg_tick, const gulong end_tick, const gulong beg_param,
+    const gulong end_param)
+{
+  bt_value_group_release_if_empty (self);
+  bt_value_group_sync_views (self, beg_tick, end_tick, beg_param, end_param);
+  bt_value_group_mark_dirty (self, beg_tick, end_tick, beg_param, end_param);
+  if (!self->priv->batch_level)
+    bt_value_group_flush_changes (self);
+}
+
 /*
  * bt_value_group_resize_data_length:
  * @self: the value-group to resize the length
@@ -90,54 +542,97 @@ static void
 bt_value_group_resize_data_length (const BtValueGroup * const self,
     const gulong length)
 {
-  const gulong old_data_count = length * self->priv->columns;
-  const gulong new_data_count = self->priv->length * self->priv->columns;
-  GValue *const data = self->priv->data;
+  BtValueGroupPrivate *const p = self->priv;
+  const gulong old_data_count = length * p->columns;
+  const gulong new_data_count = p->length * p->columns;
+  BtValueGroupCell *const data = p->data;
+  guint8 *const used = p->used;
+  const gulong n_used = p->n_used;
+  gulong i, count;
+
+  // the views are recreated for the new length on demand
+  bt_value_group_free_views (self, length);
+  // empty groups have no storage that needs to be resized
+  if (!data)
+    return;
+  if (!new_data_count) {
+    const gulong new_length = p->length;
+
+    p->length = length;
+    bt_value_group_free_data (self);
+    p->length = new_length;
+    return;
+  }
 
   // allocate new space
-  if ((self->priv->data = g_try_new0 (GValue, new_data_count))) {
-    if (data) {
-      gulong count = MIN (old_data_count, new_data_count);
-      GST_DEBUG ("keeping data count=%lu, old=%lu, new=%lu", count,
-          old_data_count, new_data_count);
-      // copy old values over
-      memcpy (self->priv->data, data, count * sizeof (GValue));
-      // free gvalues
-      if (old_data_count > new_data_count) {
-        gulong i;
-
-        for (i = new_data_count; i < old_data_count; i++) {
-          if (BT_IS_GVALUE (&data[i]))
-            g_value_unset (&data[i]);
-        }
+  p->data = NULL;
+  p->used = NULL;
+  if (bt_value_group_ensure_data (self)) {
+    count = MIN (old_data_count, new_data_count);
+    GST_DEBUG ("keeping data count=%lu, old=%lu, new=%lu", count,
+        old_data_count, new_data_count);
+    // copy old values over
+    memcpy (p->data, data, count * sizeof (BtValueGroupCell));
+    memcpy (p->used, used, count >> 3);
+    for (i = count & ~7UL; i < count; i++) {
+      if (used[i >> 3] & (1 << (i & 7)))
+        CELL_MARK_USED (p, i);
+    }
+    // free strings of the dropped cells
+    p->n_used = n_used;
+    for (i = count; i < old_data_count; i++) {
+      if (used[i >> 3] & (1 << (i & 7))) {
+        if (p->base_types[i % p->columns] == G_TYPE_STRING)
+          g_free (data[i].v_string);
+        p->n_used--;
       }
-      // free old data
-      g_free (data);
     }
+    // free old data
+    g_free (data);
+    g_free (used);
     GST_DEBUG
         ("extended value-group length from %lu to %lu, params = %lu",
-        length, self->priv->length, self->priv->params);
+        length, p->length, p->params);
+    bt_value_group_release_if_empty (self);
   } else {
     GST_INFO
         ("extending value-group length from %lu to %lu failed, params = %lu",
-        length, self->priv->length, self->priv->params);
-    //self->priv->data=data;
-    //self->priv->length=length;
+        length, p->length, p->params);
+    p->data = data;
+    p->used = used;
+    p->length = length;
   }
 }
 
-static GValue *
-bt_value_group_get_event_data_unchecked (const BtValueGroup * const self,
-    const gulong tick, const gulong param)
+/*
+ * bt_value_group_init_types:
+ * @self: the value-group
+ *
+ * Looks up the types of the columns. The plain values of enums are stored as
+ * ints, the other plain columns are unused.
+ */
+static void
+bt_value_group_init_types (const BtValueGroup * const self)
 {
-  return &self->priv->data[(tick * self->priv->columns) + param];
+  BtValueGroupPrivate *const p = self->priv;
+  gulong i;
+
+  p->types = g_new0 (GType, p->columns);
+  p->base_types = g_new0 (GType, p->columns);
+  for (i = 0; i < p->params; i++) {
+    p->types[i] = bt_parameter_group_get_param_type (p->param_group, i);
+    p->base_types[i] = bt_g_type_get_base_type (p->types[i]);
+    if (p->base_types[i] == G_TYPE_ENUM) {
+      p->types[p->params + i] = p->base_types[p->params + i] = G_TYPE_INT;
+    }
+  }
 }
 
 static GType
 bt_value_group_get_param_type (const BtValueGroup * const self,
     const gulong param)
 {
-  return bt_parameter_group_get_param_type (self->priv->param_group, param);
+  return self->priv->types[param];
 }
 
 //-- constructor methods
@@ -175,24 +670,29 @@ BtValueGroup *
 bt_value_group_copy (const BtValueGroup * const self)
 {
   BtValueGroup *value_group;
+  BtValueGroupPrivate *sp, *dp;
   gulong i, data_count;
-  GValue *sdata, *ddata;
 
   g_return_val_if_fail (BT_IS_VALUE_GROUP (self), NULL);
 
+  sp = self->priv;
   GST_INFO ("copying group vg = %p", self);
 
-  value_group =
-      bt_value_group_new (self->priv->param_group, self->priv->length);
+  value_group = bt_value_group_new (sp->param_group, sp->length);
 
-  data_count = self->priv->length * self->priv->columns;
-  sdata = self->priv->data;
-  ddata = value_group->priv->data;
-  // deep copy data
+  data_count = sp->length * sp->columns;
+  if (!sp->data || !bt_value_group_ensure_data (value_group)) {
+    return value_group;
+  }
+  dp = value_group->priv;
+  memcpy (dp->data, sp->data, data_count * sizeof (BtValueGroupCell));
+  memcpy (dp->used, sp->used, (data_count + 7) >> 3);
+  dp->n_used = sp->n_used;
+  // deep copy strings
   for (i = 0; i < data_count; i++) {
-    if (BT_IS_GVALUE (&sdata[i])) {
-      g_value_init (&ddata[i], G_VALUE_TYPE (&sdata[i]));
-      g_value_copy (&sdata[i], &ddata[i]);
+    if (CELL_IS_USED (sp, i) && sp->base_types[i % sp->columns] ==
+        G_TYPE_STRING) {
+      dp->data[i].v_string = g_strdup (sp->data[i].v_string);
     }
   }
   GST_INFO ("  group vg = %p copied", value_group);
@@ -210,6 +710,8 @@ bt_value_group_copy (const BtValueGroup * const self)
  *
  * Fetches a cell from the given location in the pattern. If there is no event
  * there, then the %GValue is uninitialized. Test with BT_IS_GVALUE(event).
+ * The returned value must not be modified. It is owned by the group, follows
+ * changes of the cell and stays valid until the length of the group changes.
  *
  * Returns: the GValue or %NULL if out of the pattern range
  *
@@ -219,15 +721,57 @@ GValue *
 bt_value_group_get_event_data (const BtValueGroup * const self,
     const gulong tick, const gulong param)
 {
+  BtValueGroupPrivate *p;
+
   g_return_val_if_fail (BT_IS_VALUE_GROUP (self), NULL);
-  g_return_val_if_fail (self->priv->data, NULL);
   g_return_val_if_fail (tick < self->priv->length, NULL);
   g_return_val_if_fail (param < self->priv->params, NULL);
 
   GST_LOG ("getting gvalue at tick=%lu/%lu and param %lu/%lu", tick,
       self->priv->length, param, self->priv->params);
 
-  return bt_value_group_get_event_data_unchecked (self, tick, param);
+  p = self->priv;
+  if (!p->views) {
+    p->views = g_new0 (GValue, p->length * p->params);
+    bt_value_group_sync_views (self, 0, p->length - 1, 0, p->params - 1);
+  }
+  return &p->views[tick * p->params + param];
+}
+
+/**
+ * bt_value_group_get_event_value:
+ * @self: the pattern to search for the param
+ * @tick: the tick (time) position starting with 0
+ * @param: the number of the parameter starting with 0
+ * @value: (out caller-allocates): the target, either uninitialized or
+ *   initialized to the type of the parameter
+ *
+ * Copies the cell from the given location in the pattern into @value. If there
+ * is no event there, @value is not modified.
+ *
+ * Returns: %TRUE if there was an event
+ *
+ * Since: 0.12
+ */
+gboolean
+bt_value_group_get_event_value (const BtValueGroup * const self,
+    const gulong tick, const gulong param, GValue * const value)
+{
+  const BtValueGroupPrivate *p;
+  gulong ix;
+
+  g_return_val_if_fail (BT_IS_VALUE_GROUP (self), FALSE);
+  g_return_val_if_fail (tick < self->priv->length, FALSE);
+  g_return_val_if_fail (param < self->priv->params, FALSE);
+  g_return_val_if_fail (value, FALSE);
+
+  p = self->priv;
+  ix = tick * p->columns + param;
+  if (!p->data || !CELL_IS_USED (p, ix))
+    return FALSE;
+
+  bt_value_group_load_cell (self, ix, value);
+  return TRUE;
 }
 
 /**
@@ -248,63 +792,71 @@ bt_value_group_set_event (const BtValueGroup * const self, const gulong tick,
     const gulong param, const gchar * const value)
 {
   gboolean res = FALSE;
-  GValue *event;
+  GValue event = G_VALUE_INIT;
+  gulong ix;
   GType type;
 
   g_return_val_if_fail (BT_IS_VALUE_GROUP (self), FALSE);
   g_return_val_if_fail (tick < self->priv->length, FALSE);
   g_return_val_if_fail (param < self->priv->params, FALSE);
 
+  if (!self->priv->data) {
+    // nothing to unset in an empty group
+    if (!BT_IS_STRING (value)) {
+      bt_value_group_param_changed (self, tick, param);
+      return TRUE;
+    }
+    if (!bt_value_group_ensure_data (self))
+      return FALSE;
+  }
+
   type = bt_value_group_get_param_type (self, param);
+  ix = tick * self->priv->columns + param;
   // plain value
   if (G_TYPE_IS_ENUM (type)) {
-    event = bt_value_group_get_event_data_unchecked (self, tick,
-        self->priv->params + param);
+    const gulong pix = ix + self->priv->params;
+
     if (BT_IS_STRING (value)) {
       // set value
-      if (!BT_IS_GVALUE (event)) {
-        g_value_init (event, G_TYPE_INT);
-      }
-      bt_str_parse_gvalue (event, value);
+      g_value_init (&event, G_TYPE_INT);
+      bt_str_parse_gvalue (&event, value);
+      bt_value_group_store_cell (self, pix, &event);
+      g_value_unset (&event);
       GST_DEBUG ("Set shadow value at: %lu,%lu: '%s'", tick, param, value);
     } else {
       // unset value
-      if (BT_IS_GVALUE (event)) {
-        g_value_unset (event);
-      }
+      bt_value_group_unset_cell (self, pix);
     }
   }
   // validated value
-  event = bt_value_group_get_event_data_unchecked (self, tick, param);
   if (BT_IS_STRING (value)) {
     // set value
-    if (!BT_IS_GVALUE (event)) {
-      g_value_init (event, type);
-    }
-    if (bt_str_parse_gvalue (event, value)) {
+    g_value_init (&event, type);
+    if (bt_str_parse_gvalue (&event, value)) {
       if (bt_parameter_group_is_param_no_value (self->priv->param_group, param,
-              event)) {
-        g_value_unset (event);
+              &event)) {
+        bt_value_group_unset_cell (self, ix);
       } else {
+        bt_value_group_store_cell (self, ix, &event);
         GST_DEBUG ("Set real value at: %lu,%lu: '%s'", tick, param, value);
       }
       res = TRUE;
     } else {
-      g_value_unset (event);
+      bt_value_group_unset_cell (self, ix);
       GST_DEBUG ("failed to set GValue for cell at tick=%lu, param=%lu", tick,
           param);
     }
+    g_value_unset (&event);
   } else {
     // unset value
-    if (BT_IS_GVALUE (event)) {
-      g_value_unset (event);
-    }
+    bt_value_group_unset_cell (self, ix);
     res = TRUE;
   }
+  bt_value_group_release_if_empty (self);
+  bt_value_group_sync_views (self, tick, tick, param, param);
   if (res) {
     // notify others that the data has been changed
-    g_signal_emit ((gpointer) self, signals[PARAM_CHANGED_EVENT], 0,
-        self->priv->param_group, tick, param);
+    bt_value_group_param_changed (self, tick, param);
   }
   return res;
 }
@@ -325,27 +877,36 @@ gchar *
 bt_value_group_get_event (const BtValueGroup * const self, const gulong tick,
     const gulong param)
 {
+  const BtValueGroupPrivate *p;
   gchar *value = NULL;
-  GValue *event;
+  GValue event = G_VALUE_INIT;
+  gulong ix;
 
   g_return_val_if_fail (BT_IS_VALUE_GROUP (self), NULL);
   g_return_val_if_fail (tick < self->priv->length, NULL);
   g_return_val_if_fail (param < self->priv->params, NULL);
 
+  p = self->priv;
+  if (!p->data)
+    return NULL;
+
   // validated value
-  event = bt_value_group_get_event_data_unchecked (self, tick, param);
-  if (BT_IS_GVALUE (event)) {
-    value = bt_str_format_gvalue (event);
+  ix = tick * p->columns + param;
+  if (CELL_IS_USED (p, ix)) {
+    bt_value_group_load_cell (self, ix, &event);
+    value = bt_str_format_gvalue (&event);
     GST_DEBUG ("return valid value at: %lu,%lu: '%s'", tick, param, value);
   } else {
     // plain value
-    event = bt_value_group_get_event_data_unchecked (self, tick,
-        self->priv->params + param);
-    if (BT_IS_GVALUE (event)) {
-      value = bt_str_format_gvalue (event);
+    ix += p->params;
+    if (CELL_IS_USED (p, ix)) {
+      bt_value_group_load_cell (self, ix, &event);
+      value = bt_str_format_gvalue (&event);
       GST_DEBUG ("return plain value at: %lu,%lu: '%s'", tick, param, value);
     }
   }
+  if (BT_IS_GVALUE (&event))
+    g_value_unset (&event);
   return value;
 }
 
@@ -369,10 +930,10 @@ bt_value_group_test_event (const BtValueGroup * const self, const gulong tick,
   g_return_val_if_fail (tick < self->priv->length, FALSE);
   g_return_val_if_fail (param < self->priv->params, FALSE);
 
-  const GValue *const event =
-      bt_value_group_get_event_data_unchecked (self, tick, param);
+  if (!self->priv->data)
+    return FALSE;
 
-  return BT_IS_GVALUE (event);
+  return CELL_IS_USED (self->priv, tick * self->priv->columns + param);
 }
 
 /**
@@ -390,18 +951,20 @@ gboolean
 bt_value_group_test_tick (const BtValueGroup * const self, const gulong tick)
 {
   const gulong params = self->priv->params;
-  gulong i;
-  GValue *data;
+  gulong i, ix;
 
   g_return_val_if_fail (BT_IS_VALUE_GROUP (self), FALSE);
   g_return_val_if_fail (tick < self->priv->length, FALSE);
 
-  data = &self->priv->data[tick * self->priv->columns];
+  if (!self->priv->data)
+    return FALSE;
+
+  ix = tick * self->priv->columns;
   for (i = 0; i < params; i++) {
-    if (BT_IS_GVALUE (data)) {
+    if (CELL_IS_USED (self->priv, ix)) {
       return TRUE;
     }
-    data++;
+    ix++;
   }
   return FALSE;
 }
@@ -413,21 +976,17 @@ _insert_row (const BtValueGroup * const self, const gulong tick,
 {
   gulong i, length = self->priv->length;
   gulong params = self->priv->columns;
-  GValue *src = &self->priv->data[param + params * (length - 2)];
-  GValue *dst = &self->priv->data[param + params * (length - 1)];
+  gulong src, dst;
 
   GST_INFO ("insert row at %lu,%lu", tick, param);
 
+  if (!self->priv->data || length < 2)
+    return;
+  src = param + params * (length - 2);
+  dst = param + params * (length - 1);
+
   for (i = tick; i < length - 1; i++) {
-    if (BT_IS_GVALUE (src)) {
-      if (!BT_IS_GVALUE (dst))
-        g_value_init (dst, G_VALUE_TYPE (src));
-      g_value_copy (src, dst);
-      g_value_unset (src);
-    } else {
-      if (BT_IS_GVALUE (dst))
-        g_value_unset (dst);
-    }
+    bt_value_group_move_cell (self, src, dst);
     src -= params;
     dst -= params;
   }
@@ -449,13 +1008,11 @@ bt_value_group_insert_row (const BtValueGroup * const self, const gulong tick,
 {
   g_return_if_fail (BT_IS_VALUE_GROUP (self));
   g_return_if_fail (tick < self->priv->length);
-  g_return_if_fail (self->priv->data);
 
-  g_signal_emit ((gpointer) self, signals[GROUP_CHANGED_EVENT], 0,
-      self->priv->param_group, TRUE);
+  bt_value_group_begin_change (self);
   _insert_row (self, tick, param);
-  g_signal_emit ((gpointer) self, signals[GROUP_CHANGED_EVENT], 0,
-      self->priv->param_group, FALSE);
+  bt_value_group_end_change (self, tick,
+      self->priv->length - 1, param, param);
 }
 
 /**
@@ -477,13 +1034,12 @@ bt_value_group_insert_full_row (const BtValueGroup * const self,
 
   GST_DEBUG ("insert full-row at %lu", tick);
 
-  g_signal_emit ((gpointer) self, signals[GROUP_CHANGED_EVENT], 0,
-      self->priv->param_group, TRUE);
+  bt_value_group_begin_change (self);
   for (j = 0; j < params; j++) {
     _insert_row (self, tick, j);
   }
-  g_signal_emit ((gpointer) self, signals[GROUP_CHANGED_EVENT], 0,
-      self->priv->param_group, FALSE);
+  bt_value_group_end_change (self, tick,
+      self->priv->length - 1, 0, MAX (params, 1) - 1);
 }
 
 
@@ -493,24 +1049,22 @@ _delete_row (const BtValueGroup * const self, const gulong tick,
 {
   gulong i, length = self->priv->length;
   gulong params = self->priv->columns;
-  GValue *src = &self->priv->data[param + params * (tick + 1)];
-  GValue *dst = &self->priv->data[param + params * tick];
+  gulong src, dst;
 
-  GST_INFO ("insert row at %lu,%lu", tick, param);
+  GST_INFO ("delete row at %lu,%lu", tick, param);
+
+  if (!self->priv->data)
+    return;
+  src = param + params * (tick + 1);
+  dst = param + params * tick;
 
   for (i = tick; i < length - 1; i++) {
-    if (BT_IS_GVALUE (src)) {
-      if (!BT_IS_GVALUE (dst))
-        g_value_init (dst, G_VALUE_TYPE (src));
-      g_value_copy (src, dst);
-      g_value_unset (src);
-    } else {
-      if (BT_IS_GVALUE (dst))
-        g_value_unset (dst);
-    }
+    bt_value_group_move_cell (self, src, dst);
     src += params;
     dst += params;
   }
+  // the last row is empty now
+  bt_value_group_unset_cell (self, dst);
 }
 
 /**
@@ -529,13 +1083,11 @@ bt_value_group_delete_row (const BtValueGroup * const self, const gulong tick,
 {
   g_return_if_fail (BT_IS_VALUE_GROUP (self));
   g_return_if_fail (tick < self->priv->length);
-  g_return_if_fail (self->priv->data);
 
-  g_signal_emit ((gpointer) self, signals[GROUP_CHANGED_EVENT], 0,
-      self->priv->param_group, TRUE);
+  bt_value_group_begin_change (self);
   _delete_row (self, tick, param);
-  g_signal_emit ((gpointer) self, signals[GROUP_CHANGED_EVENT], 0,
-      self->priv->param_group, FALSE);
+  bt_value_group_end_change (self, tick,
+      self->priv->length - 1, param, param);
 }
 
 /**
@@ -557,13 +1109,12 @@ bt_value_group_delete_full_row (const BtValueGroup * const self,
 
   GST_DEBUG ("insert full-row at %lu", tick);
 
-  g_signal_emit ((gpointer) self, signals[GROUP_CHANGED_EVENT], 0,
-      self->priv->param_group, TRUE);
+  bt_value_group_begin_change (self);
   for (j = 0; j < params; j++) {
     _delete_row (self, tick, j);
   }
-  g_signal_emit ((gpointer) self, signals[GROUP_CHANGED_EVENT], 0,
-      self->priv->param_group, FALSE);
+  bt_value_group_end_change (self, tick,
+      self->priv->length - 1, 0, MAX (params, 1) - 1);
 }
 
 
@@ -572,12 +1123,11 @@ _clear_column (const BtValueGroup * const self, BtValueGroupOp op,
     const gulong start_tick, const gulong end_tick, const gulong param)
 {
   gulong params = self->priv->columns;
-  GValue *beg = &self->priv->data[param + params * start_tick];
+  gulong beg = param + params * start_tick;
   gulong i, ticks = (end_tick + 1) - start_tick;
 
   for (i = 0; i < ticks; i++) {
-    if (BT_IS_GVALUE (beg))
-      g_value_unset (beg);
+    bt_value_group_unset_cell (self, beg);
     beg += params;
   }
 }
@@ -585,13 +1135,12 @@ _clear_column (const BtValueGroup * const self, BtValueGroupOp op,
 
 #define _BLEND(t,T)                                                            \
 	case G_TYPE_ ## T: {                                                         \
-		gdouble val=(gdouble)g_value_get_ ## t(beg);                               \
-	  gdouble step=((gdouble)g_value_get_ ## t(end)-val)/(gdouble)ticks;         \
+		gdouble val=(gdouble)data[beg].v_ ## t;                                    \
+	  gdouble step=((gdouble)data[end].v_ ## t-val)/(gdouble)ticks;              \
 	                                                                             \
 		for(i=0;i<ticks;i++) {                                                     \
-			if(!BT_IS_GVALUE(beg))                                                   \
-				g_value_init(beg,G_TYPE_ ## T);                                        \
-			g_value_set_ ## t(beg,(g ## t)(val+(step*i)));                           \
+			data[beg].v_ ## t=(g ## t)(val+(step*i));                                \
+			CELL_MARK_USED(priv,beg);                                                \
 			beg+=params;                                                             \
 		}                                                                          \
 	} break;
@@ -600,19 +1149,21 @@ static void
 _blend_column (const BtValueGroup * const self, BtValueGroupOp op,
     const gulong start_tick, const gulong end_tick, const gulong param)
 {
-  gulong params = self->priv->columns;
-  GValue *beg = &self->priv->data[param + params * start_tick];
-  GValue *end = &self->priv->data[param + params * end_tick];
+  BtValueGroupPrivate *const priv = self->priv;
+  BtValueGroupCell *const data = priv->data;
+  gulong params = priv->columns;
+  gulong beg = param + params * start_tick;
+  gulong end = param + params * end_tick;
   gulong i, ticks = end_tick - start_tick;
   GParamSpec *property;
   GType base_type;
 
-  if (!BT_IS_GVALUE (beg) || !BT_IS_GVALUE (end)) {
+  if (!CELL_IS_USED (priv, beg) || !CELL_IS_USED (priv, end)) {
     GST_INFO ("Can't blend, beg or end is empty");
     return;
   }
-  property = bt_parameter_group_get_param_spec (self->priv->param_group, param);
-  base_type = bt_g_type_get_base_type (property->value_type);
+  property = bt_parameter_group_get_param_spec (priv->param_group, param);
+  base_type = priv->base_types[param];
 
   GST_INFO ("blending gvalue type %s", g_type_name (base_type));
 
@@ -629,14 +1180,12 @@ _blend_column (const BtValueGroup * const self, BtValueGroupOp op,
         _BLEND (double, DOUBLE)
       case G_TYPE_BOOLEAN:
     {
-      gdouble val = (gdouble) g_value_get_boolean (beg);
-      gdouble step =
-          ((gdouble) g_value_get_boolean (end) - val) / (gdouble) ticks;
+      gdouble val = (gdouble) data[beg].v_int;
+      gdouble step = ((gdouble) data[end].v_int - val) / (gdouble) ticks;
       val += 0.5;
       for (i = 0; i < ticks; i++) {
-        if (!BT_IS_GVALUE (beg))
-          g_value_init (beg, G_TYPE_BOOLEAN);
-        g_value_set_boolean (beg, (gboolean) (val + (step * i)));
+        data[beg].v_int = (gboolean) (val + (step * i));
+        CELL_MARK_USED (priv, beg);
         beg += params;
       }
     }
@@ -649,12 +1198,12 @@ _blend_column (const BtValueGroup * const self, BtValueGroupOp op,
       gint v, v1, v2;
 
       // we need the index of the enum value and the number of values inbetween
-      v = g_value_get_enum (beg);
+      v = data[beg].v_int;
       for (v1 = 0; v1 < e->n_values; v1++) {
         if (e->values[v1].value == v)
           break;
       }
-      v = g_value_get_enum (end);
+      v = data[end].v_int;
       for (v2 = 0; v2 < e->n_values; v2++) {
         if (e->values[v2].value == v)
           break;
@@ -663,11 +1212,10 @@ _blend_column (const BtValueGroup * const self, BtValueGroupOp op,
       //GST_DEBUG("v1 = %d, v2=%d, step=%lf",v1,v2,step);
 
       for (i = 0; i < ticks; i++) {
-        if (!BT_IS_GVALUE (beg))
-          g_value_init (beg, property->value_type);
         v = (gint) (v1 + (step * i));
         // handle sparse enums
-        g_value_set_enum (beg, e->values[v].value);
+        data[beg].v_int = e->values[v].value;
+        CELL_MARK_USED (priv, beg);
         beg += params;
       }
     }
@@ -682,37 +1230,34 @@ static void
 _flip_column (const BtValueGroup * const self, BtValueGroupOp op,
     const gulong start_tick, const gulong end_tick, const gulong param)
 {
-  gulong params = self->priv->columns;
-  GValue *beg = &self->priv->data[param + params * start_tick];
-  GValue *end = &self->priv->data[param + params * end_tick];
-  GParamSpec *property;
-  GType base_type;
-  GValue tmp = { 0, };
-
-  property = bt_parameter_group_get_param_spec (self->priv->param_group, param);
-  base_type = property->value_type;
+  BtValueGroupPrivate *const priv = self->priv;
+  BtValueGroupCell *const data = priv->data;
+  gulong params = priv->columns;
+  gulong beg = param + params * start_tick;
+  gulong end = param + params * end_tick;
+  BtValueGroupCell tmp;
+  gboolean beg_used;
 
-  GST_INFO ("flipping gvalue type %s", g_type_name (base_type));
+  GST_INFO ("flipping gvalue type %s", g_type_name (priv->types[param]));
 
-  g_value_init (&tmp, base_type);
   while (beg < end) {
-    if (BT_IS_GVALUE (beg) && BT_IS_GVALUE (end)) {
-      g_value_copy (beg, &tmp);
-      g_value_copy (end, beg);
-      g_value_copy (&tmp, end);
-    } else if (!BT_IS_GVALUE (beg) && BT_IS_GVALUE (end)) {
-      g_value_init (beg, base_type);
-      g_value_copy (end, beg);
-      g_value_unset (end);
-    } else if (BT_IS_GVALUE (beg) && !BT_IS_GVALUE (end)) {
-      g_value_init (end, base_type);
-      g_value_copy (beg, end);
-      g_value_unset (beg);
+    beg_used = CELL_IS_USED (priv, beg);
+    tmp = data[beg];
+    data[beg] = data[end];
+    data[end] = tmp;
+    if (CELL_IS_USED (priv, end)) {
+      CELL_MARK_USED (priv, beg);
+    } else {
+      CELL_MARK_UNUSED (priv, beg);
+    }
+    if (beg_used) {
+      CELL_MARK_USED (priv, end);
+    } else {
+      CELL_MARK_UNUSED (priv, end);
     }
     beg += params;
     end -= params;
   }
-  g_value_unset (&tmp);
 }
 
 
@@ -721,10 +1266,9 @@ _flip_column (const BtValueGroup * const self, BtValueGroupOp op,
       const GParamSpec ## p *p=G_PARAM_SPEC_ ## T(property);                   \
       g ## t d = p->maximum-p->minimum;                                        \
       for(i=0;i<ticks;i++) {                                                   \
-        if(!BT_IS_GVALUE(beg))                                                 \
-          g_value_init(beg,G_TYPE_ ## T);                                      \
         rnd=((gdouble)rand())/(RAND_MAX+1.0);                                  \
-        g_value_set_ ## t(beg,(g ## t)(p->minimum+(d*rnd)));                   \
+        data[beg].v_ ## t=(g ## t)(p->minimum+(d*rnd));                        \
+        CELL_MARK_USED(priv,beg);                                              \
         beg+=params;                                                           \
       }                                                                        \
     } break;
@@ -733,15 +1277,17 @@ static void
 _randomize_column (const BtValueGroup * const self, BtValueGroupOp op,
     const gulong start_tick, const gulong end_tick, const gulong param)
 {
-  gulong params = self->priv->columns;
-  GValue *beg = &self->priv->data[param + params * start_tick];
+  BtValueGroupPrivate *const priv = self->priv;
+  BtValueGroupCell *const data = priv->data;
+  gulong params = priv->columns;
+  gulong beg = param + params * start_tick;
   gulong i, ticks = (end_tick + 1) - start_tick;
   GParamSpec *property;
   GType base_type;
   gdouble rnd;
 
-  property = bt_parameter_group_get_param_spec (self->priv->param_group, param);
-  base_type = bt_g_type_get_base_type (property->value_type);
+  property = bt_parameter_group_get_param_spec (priv->param_group, param);
+  base_type = priv->base_types[param];
 
   GST_INFO ("randomizing gvalue type %s", g_type_name (base_type));
 
@@ -759,10 +1305,9 @@ _randomize_column (const BtValueGroup * const self, BtValueGroupOp op,
       case G_TYPE_BOOLEAN:
     {
       for (i = 0; i < ticks; i++) {
-        if (!BT_IS_GVALUE (beg))
-          g_value_init (beg, G_TYPE_BOOLEAN);
         rnd = ((gdouble) rand ()) / (RAND_MAX + 1.0);
-        g_value_set_boolean (beg, (gboolean) (2 * rnd));
+        data[beg].v_int = (gboolean) (2 * rnd);
+        CELL_MARK_USED (priv, beg);
         beg += params;
       }
       break;
@@ -774,12 +1319,11 @@ _randomize_column (const BtValueGroup * const self, BtValueGroupOp op,
       gint v;
 
       for (i = 0; i < ticks; i++) {
-        if (!BT_IS_GVALUE (beg))
-          g_value_init (beg, property->value_type);
         rnd = ((gdouble) rand ()) / (RAND_MAX + 1.0);
         v = (gint) (d * rnd);
         // handle sparse enums
-        g_value_set_enum (beg, e->values[v].value);
+        data[beg].v_int = e->values[v].value;
+        CELL_MARK_USED (priv, beg);
         beg += params;
       }
       break;
@@ -792,8 +1336,8 @@ _randomize_column (const BtValueGroup * const self, BtValueGroupOp op,
 
 #define _RANGE_RANDOMIZE(t,T)                                                  \
 	case G_TYPE_ ## T: {                                                         \
-      g ## t mi = g_value_get_ ## t(beg);                                      \
-      g ## t ma = g_value_get_ ## t(end);                                      \
+      g ## t mi = data[beg].v_ ## t;                                           \
+      g ## t ma = data[end].v_ ## t;                                           \
       if (ma < mi) {                                                           \
         g ## t d = ma;                                                         \
         ma = mi;                                                               \
@@ -801,10 +1345,9 @@ _randomize_column (const BtValueGroup * const self, BtValueGroupOp op,
       }                                                                        \
       g ## t d = ma - mi;                                                      \
       for(i=0;i<ticks;i++) {                                                   \
-        if(!BT_IS_GVALUE(beg))                                                 \
-          g_value_init(beg,G_TYPE_ ## T);                                      \
         rnd=((gdouble)rand())/(RAND_MAX+1.0);                                  \
-        g_value_set_ ## t(beg,(g ## t)(mi+(d*rnd)));                           \
+        data[beg].v_ ## t=(g ## t)(mi+(d*rnd));                                \
+        CELL_MARK_USED(priv,beg);                                              \
         beg+=params;                                                           \
       }                                                                        \
     } break;
@@ -813,26 +1356,28 @@ static void
 _range_randomize_column (const BtValueGroup * const self, BtValueGroupOp op,
     const gulong start_tick, const gulong end_tick, const gulong param)
 {
-  gulong params = self->priv->columns;
-  GValue *beg = &self->priv->data[param + params * start_tick];
-  GValue *end = &self->priv->data[param + params * end_tick];
+  BtValueGroupPrivate *const priv = self->priv;
+  BtValueGroupCell *const data = priv->data;
+  gulong params = priv->columns;
+  gulong beg = param + params * start_tick;
+  gulong end = param + params * end_tick;
   gulong i, ticks = (end_tick + 1) - start_tick;
   GParamSpec *property;
   GType base_type;
   gdouble rnd;
 
-  if (!BT_IS_GVALUE (beg) || !BT_IS_GVALUE (end)) {
-    if (!BT_IS_GVALUE (beg)) {
+  if (!CELL_IS_USED (priv, beg) || !CELL_IS_USED (priv, end)) {
+    if (!CELL_IS_USED (priv, beg)) {
       GST_INFO ("Can't ranged randomize, beg is empty");
     }
-    if (!BT_IS_GVALUE (end)) {
+    if (!CELL_IS_USED (priv, end)) {
       GST_INFO ("Can't ranged randomize, end is empty");
     }
     return;
   }
 
-  property = bt_parameter_group_get_param_spec (self->priv->param_group, param);
-  base_type = bt_g_type_get_base_type (property->value_type);
+  property = bt_parameter_group_get_param_spec (priv->param_group, param);
+  base_type = priv->base_types[param];
 
   GST_INFO ("randomizing ranged gvalue type %s", g_type_name (base_type));
 
@@ -852,10 +1397,9 @@ _range_randomize_column (const BtValueGroup * const self, BtValueGroupOp op,
       case G_TYPE_BOOLEAN:
     {
       for (i = 0; i < ticks; i++) {
-        if (!BT_IS_GVALUE (beg))
-          g_value_init (beg, G_TYPE_BOOLEAN);
         rnd = ((gdouble) rand ()) / (RAND_MAX + 1.0);
-        g_value_set_boolean (beg, (gboolean) (2 * rnd));
+        data[beg].v_int = (gboolean) (2 * rnd);
+        CELL_MARK_USED (priv, beg);
         beg += params;
       }
       break;
@@ -863,14 +1407,14 @@ _range_randomize_column (const BtValueGroup * const self, BtValueGroupOp op,
     case G_TYPE_ENUM:{
       const GParamSpecEnum *p = G_PARAM_SPEC_ENUM (property);
       const GEnumClass *e = p->enum_class;
-      gint mi = g_value_get_enum (beg);
+      gint mi = data[beg].v_int;
       for (i = 0; i < e->n_values; i++) {
         if (e->values[i].value == mi) {
           mi = i;
           break;
         }
       }
-      gint ma = g_value_get_enum (end);
+      gint ma = data[end].v_int;
       for (i = 0; i < e->n_values; i++) {
         if (e->values[i].value == ma) {
           ma = i;
@@ -886,12 +1430,11 @@ _range_randomize_column (const BtValueGroup * const self, BtValueGroupOp op,
       gint v;
 
       for (i = 0; i < ticks; i++) {
-        if (!BT_IS_GVALUE (beg))
-          g_value_init (beg, property->value_type);
         rnd = ((gdouble) rand ()) / (RAND_MAX + 1.0);
         v = (gint) (d * rnd);
         // handle sparse enums
-        g_value_set_enum (beg, e->values[mi + v].value);
+        data[beg].v_int = e->values[mi + v].value;
+        CELL_MARK_USED (priv, beg);
         beg += params;
       }
       break;
@@ -908,15 +1451,15 @@ _range_randomize_column (const BtValueGroup * const self, BtValueGroupOp op,
       g ## t v;                                                                \
       step = dir * (fine ? 1.0 : ((p->maximum - p->minimum) / 16.0));          \
       for(i=0;i<ticks;i++) {                                                   \
-        if(BT_IS_GVALUE(beg)) {                                                \
-          v = g_value_get_ ## t(beg);                                          \
+        if(CELL_IS_USED(priv,beg)) {                                           \
+          v = data[beg].v_ ## t;                                               \
           if (step < 0) {                                                      \
             if (v >= (p->minimum - step)) {                                    \
-              g_value_set_ ## t(beg,(g ## t) (v + step));                      \
+              data[beg].v_ ## t = (g ## t) (v + step);                         \
             }                                                                  \
           } else {                                                             \
             if (v <= (p->maximum - step)) {                                    \
-              g_value_set_ ## t(beg,(g ## t) (v + step));                      \
+              data[beg].v_ ## t = (g ## t) (v + step);                         \
             }                                                                  \
           }                                                                    \
         }                                                                      \
@@ -930,15 +1473,15 @@ _range_randomize_column (const BtValueGroup * const self, BtValueGroupOp op,
       g ## t v;                                                                \
       step = (dir * (p->maximum - p->minimum)) / (fine ? 65535.0 : 16.0);      \
       for(i=0;i<ticks;i++) {                                                   \
-        if(BT_IS_GVALUE(beg)) {                                                \
-          v = g_value_get_ ## t(beg);                                          \
+        if(CELL_IS_USED(priv,beg)) {                                           \
+          v = data[beg].v_ ## t;                                               \
           if (step < 0) {                                                      \
             if (v >= (p->minimum - step)) {                                    \
-              g_value_set_ ## t(beg,(g ## t) (v + step));                      \
+              data[beg].v_ ## t = (g ## t) (v + step);                         \
             }                                                                  \
           } else {                                                             \
             if (v <= (p->maximum - step)) {                                    \
-              g_value_set_ ## t(beg,(g ## t) (v + step));                      \
+              data[beg].v_ ## t = (g ## t) (v + step);                         \
             }                                                                  \
           }                                                                    \
         }                                                                      \
@@ -950,8 +1493,10 @@ static void
 _transpose_column (const BtValueGroup * const self, BtValueGroupOp op,
     const gulong start_tick, const gulong end_tick, const gulong param)
 {
-  gulong params = self->priv->columns;
-  GValue *beg = &self->priv->data[param + params * start_tick];
+  BtValueGroupPrivate *const priv = self->priv;
+  BtValueGroupCell *const data = priv->data;
+  gulong params = priv->columns;
+  gulong beg = param + params * start_tick;
   gulong i, ticks = (end_tick + 1) - start_tick;
   GParamSpec *property;
   GType base_type;
@@ -979,8 +1524,8 @@ _transpose_column (const BtValueGroup * const self, BtValueGroupOp op,
       g_assert_not_reached ();
   }
 
-  property = bt_parameter_group_get_param_spec (self->priv->param_group, param);
-  base_type = bt_g_type_get_base_type (property->value_type);
+  property = bt_parameter_group_get_param_spec (priv->param_group, param);
+  base_type = priv->base_types[param];
 
   GST_INFO ("transposing gvalue type %s", g_type_name (base_type));
 
@@ -995,18 +1540,15 @@ _transpose_column (const BtValueGroup * const self, BtValueGroupOp op,
         _TRANSPOSE_FLT (double, DOUBLE, Double)
       case G_TYPE_BOOLEAN:
     {
-      gboolean v;
-
       for (i = 0; i < ticks; i++) {
-        if (BT_IS_GVALUE (beg)) {
-          v = g_value_get_boolean (beg);
-          if (v == FALSE && dir > 0) {
-            g_value_set_boolean (beg, TRUE);
-          }
-          if (v == TRUE && dir < 0) {
-            g_value_set_boolean (beg, FALSE);
+        if (CELL_IS_USED (priv, beg)) {
+          if (dir > 0) {
+            data[beg].v_int = TRUE;
+          } else {
+            data[beg].v_int = FALSE;
           }
         }
+        beg += params;
       }
       break;
     }
@@ -1028,8 +1570,8 @@ _transpose_column (const BtValueGroup * const self, BtValueGroupOp op,
       step *= dir;
 
       for (i = 0; i < ticks; i++) {
-        if (BT_IS_GVALUE (beg)) {
-          ev = g_value_get_enum (beg);
+        if (CELL_IS_USED (priv, beg)) {
+          ev = data[beg].v_int;
           for (v = 0; v < d; v++) {
             if (e->values[v].value == ev) {
               break;
@@ -1037,7 +1579,7 @@ _transpose_column (const BtValueGroup * const self, BtValueGroupOp op,
           }
           v += (gint) step;
           if ((v >= 0) && (v <= d)) {
-            g_value_set_enum (beg, e->values[v].value);
+            data[beg].v_int = e->values[v].value;
           }
         }
         beg += params;
@@ -1085,15 +1627,17 @@ bt_value_group_transform_colum (const BtValueGroup * const self,
   g_return_if_fail (BT_IS_VALUE_GROUP (self));
   g_return_if_fail (start_tick < self->priv->length);
   g_return_if_fail (end_tick < self->priv->length);
-  g_return_if_fail (self->priv->data);
 
   if (op == BT_VALUE_GROUP_OP_CLEAR) {
-    g_signal_emit ((gpointer) self, signals[GROUP_CHANGED_EVENT], 0,
-        self->priv->param_group, TRUE);
+    bt_value_group_begin_change (self);
   }
-  ops[op] (self, op, start_tick, end_tick, param);
-  g_signal_emit ((gpointer) self, signals[GROUP_CHANGED_EVENT], 0,
-      self->priv->param_group, FALSE);
+  // only randomize creates values in an empty group
+  if (self->priv->data || (op == BT_VALUE_GROUP_OP_RANDOMIZE &&
+          bt_value_group_ensure_data (self))) {
+    ops[op] (self, op, start_tick, end_tick, param);
+  }
+  bt_value_group_end_change (self, start_tick, end_tick, param,
+      param);
 
 }
 
@@ -1115,20 +1659,22 @@ bt_value_group_transform_colums (const BtValueGroup * const self,
   g_return_if_fail (BT_IS_VALUE_GROUP (self));
   g_return_if_fail (start_tick < self->priv->length);
   g_return_if_fail (end_tick < self->priv->length);
-  g_return_if_fail (self->priv->data);
 
   gulong j, params = self->priv->params;
   OpFunc opfunc = ops[op];
 
   if (op == BT_VALUE_GROUP_OP_CLEAR) {
-    g_signal_emit ((gpointer) self, signals[GROUP_CHANGED_EVENT], 0,
-        self->priv->param_group, TRUE);
+    bt_value_group_begin_change (self);
   }
-  for (j = 0; j < params; j++) {
-    opfunc (self, op, start_tick, end_tick, j);
+  // only randomize creates values in an empty group
+  if (self->priv->data || (op == BT_VALUE_GROUP_OP_RANDOMIZE &&
+          bt_value_group_ensure_data (self))) {
+    for (j = 0; j < params; j++) {
+      opfunc (self, op, start_tick, end_tick, j);
+    }
   }
-  g_signal_emit ((gpointer) self, signals[GROUP_CHANGED_EVENT], 0,
-      self->priv->param_group, FALSE);
+  bt_value_group_end_change (self, start_tick, end_tick, 0,
+      MAX (params, 1) - 1);
 
 }
 
@@ -1138,15 +1684,18 @@ _serialize_column (const BtValueGroup * const self, const gulong start_tick,
     const gulong end_tick, const gulong param, GString * data)
 {
   gulong params = self->priv->columns;
-  GValue *beg = &self->priv->data[param + params * start_tick];
+  gulong beg = param + params * start_tick;
   gulong i, ticks = (end_tick + 1) - start_tick;
+  GValue event = G_VALUE_INIT;
   gchar *val;
 
   g_string_append (data,
       g_type_name (bt_value_group_get_param_type (self, param)));
   for (i = 0; i < ticks; i++) {
-    if (BT_IS_GVALUE (beg)) {
-      if ((val = bt_str_format_gvalue (beg))) {
+    // empty groups serialize as empty cells
+    if (self->priv->data && CELL_IS_USED (self->priv, beg)) {
+      bt_value_group_load_cell (self, beg, &event);
+      if ((val = bt_str_format_gvalue (&event))) {
         g_string_append_c (data, ',');
         g_string_append (data, val);
         g_free (val);
@@ -1157,6 +1706,8 @@ _serialize_column (const BtValueGroup * const self, const gulong start_tick,
     }
     beg += params;
   }
+  if (BT_IS_GVALUE (&event))
+    g_value_unset (&event);
   g_string_append_c (data, '\n');
 }
 
@@ -1180,7 +1731,6 @@ bt_value_group_serialize_column (const BtValueGroup * const self,
   g_return_if_fail (BT_IS_VALUE_GROUP (self));
   g_return_if_fail (start_tick < self->priv->length);
   g_return_if_fail (end_tick < self->priv->length);
-  g_return_if_fail (self->priv->data);
   g_return_if_fail (data);
 
   _serialize_column (self, start_tick, end_tick, param, data);
@@ -1236,10 +1786,12 @@ bt_value_group_deserialize_column (const BtValueGroup * const self,
   g_return_val_if_fail (BT_IS_VALUE_GROUP (self), FALSE);
   g_return_val_if_fail (start_tick < self->priv->length, FALSE);
   g_return_val_if_fail (end_tick < self->priv->length, FALSE);
-  g_return_val_if_fail (self->priv->data, FALSE);
   g_return_val_if_fail (data, FALSE);
   g_return_val_if_fail (param < self->priv->params, FALSE);
 
+  if (!bt_value_group_ensure_data (self))
+    return FALSE;
+
   gboolean ret = TRUE;
   gchar **fields = g_strsplit_set (data, ",", 0);
   GType dtype = bt_value_group_get_param_type (self, param);
@@ -1248,25 +1800,25 @@ bt_value_group_deserialize_column (const BtValueGroup * const self,
   if (dtype == stype) {
     gint i = 1;
     gulong params = self->priv->columns;
-    GValue *beg = &self->priv->data[param + params * start_tick];
-    GValue *end = &self->priv->data[param + params * end_tick];
+    gulong beg = param + params * start_tick;
+    gulong end = param + params * end_tick;
+    GValue event = G_VALUE_INIT;
 
     GST_INFO ("types match %s <-> %s", fields[0], g_type_name (dtype));
 
+    g_value_init (&event, dtype);
     while (fields[i] && *fields[i] && (beg <= end)) {
       if (*fields[i] != ' ') {
-        if (!BT_IS_GVALUE (beg)) {
-          g_value_init (beg, dtype);
-        }
-        bt_str_parse_gvalue (beg, fields[i]);
+        bt_str_parse_gvalue (&event, fields[i]);
+        bt_value_group_store_cell (self, beg, &event);
       } else {
-        if (BT_IS_GVALUE (beg)) {
-          g_value_unset (beg);
-        }
+        bt_value_group_unset_cell (self, beg);
       }
       beg += params;
       i++;
     }
+    g_value_unset (&event);
+    bt_value_group_end_change (self, start_tick, end_tick, param, param);
   } else {
     GST_INFO ("types don't match in %s <-> %s", fields[0], g_type_name (dtype));
     ret = FALSE;
@@ -1275,6 +1827,88 @@ bt_value_group_deserialize_column (const BtValueGroup * const self,
   return ret;
 }
 
+/**
+ * bt_value_group_begin_batch:
+ * @self: the value group
+ *
+ * Starts a batch of changes. Until the matching bt_value_group_end_batch() no
+ * change notifications are sent. The changed cells are collected and announced
+ * by a single #BtValueGroup::group-changed signal at the end of the batch.
+ * Use bt_value_group_get_changed_region() from the signal handler to get the
+ * changed cells. Batches can be nested.
+ *
+ * Since: 0.12
+ */
+void
+bt_value_group_begin_batch (const BtValueGroup * const self)
+{
+  g_return_if_fail (BT_IS_VALUE_GROUP (self));
+
+  self->priv->batch_level++;
+}
+
+/**
+ * bt_value_group_end_batch:
+ * @self: the value group
+ *
+ * Ends a batch of changes started with bt_value_group_begin_batch(). Sends the
+ * #BtValueGroup::group-changed signal if cells have been changed.
+ *
+ * Since: 0.12
+ */
+void
+bt_value_group_end_batch (const BtValueGroup * const self)
+{
+  g_return_if_fail (BT_IS_VALUE_GROUP (self));
+  g_return_if_fail (self->priv->batch_level > 0);
+
+  if (!--self->priv->batch_level && self->priv->dirty) {
+    GST_DEBUG ("batch changed ticks %lu..%lu, params %lu..%lu",
+        self->priv->dirty_beg_tick, self->priv->dirty_end_tick,
+        self->priv->dirty_beg_param, self->priv->dirty_end_param);
+    bt_value_group_flush_changes (self);
+  }
+}
+
+/**
+ * bt_value_group_get_changed_region:
+ * @self: the value group
+ * @beg_tick: (out) (optional): location for the first changed tick
+ * @end_tick: (out) (optional): location for the last changed tick
+ * @beg_param: (out) (optional): location for the first changed param
+ * @end_param: (out) (optional): location for the last changed param
+ *
+ * Gets the region of cells that have been changed. This is only available from
+ * a #BtValueGroup::group-changed handler with @intermediate=%FALSE.
+ *
+ * Returns: %TRUE if the region is known
+ *
+ * Since: 0.12
+ */
+gboolean
+bt_value_group_get_changed_region (const BtValueGroup * const self,
+    gulong * beg_tick, gulong * end_tick, gulong * beg_param,
+    gulong * end_param)
+{
+  const BtValueGroupPrivate *p;
+
+  g_return_val_if_fail (BT_IS_VALUE_GROUP (self), FALSE);
+
+  p = self->priv;
+  if (!p->dirty)
+    return FALSE;
+
+  if (beg_tick)
+    *beg_tick = p->dirty_beg_tick;
+  if (end_tick)
+    *end_tick = p->dirty_end_tick;
+  if (beg_param)
+    *beg_param = p->dirty_beg_param;
+  if (end_param)
+    *end_param = p->dirty_end_param;
+  return TRUE;
+}
+
 //-- g_object overrides
 
 static void
@@ -1301,6 +1935,7 @@ bt_value_group_set_property (GObject * const object, const guint property_id,
       g_object_get ((gpointer) (self->priv->param_group), "num-params",
           &self->priv->params, NULL);
       self->priv->columns = self->priv->params * 2;
+      bt_value_group_init_types (self);
       break;
     }
     case VALUE_GROUP_LENGTH:{
@@ -1354,19 +1989,11 @@ static void
 bt_value_group_finalize (GObject * const object)
 {
   const BtValueGroup *const self = BT_VALUE_GROUP (object);
-  GValue *v;
-  gulong i;
 
-  if (self->priv->data) {
-    const gulong data_count = self->priv->length * self->priv->columns;
-    // free gvalues in self->priv->data
-    for (i = 0; i < data_count; i++) {
-      v = &self->priv->data[i];
-      if (BT_IS_GVALUE (v))
-        g_value_unset (v);
-    }
-    g_free (self->priv->data);
-  }
+  bt_value_group_free_data (self);
+  bt_value_group_free_views (self, self->priv->length);
+  g_free (self->priv->types);
+  g_free (self->priv->base_types);
 
   G_OBJECT_CLASS (bt_value_group_parent_class)->finalize (object);
 }
@@ -1417,7 +2044,8 @@ bt_value_group_class_init (BtValueGroupClass * const klass)
    * Signals that this value-group has been changed (more than in one place).
    * When doing e.g. line inserts, one will receive two updates, one before and
    * one after. The first will have @intermediate=%TRUE. Applications can use
-   * that to defer change-consolidation.
+   * that to defer change-consolidation. The final update can query the
+   * changed cells using bt_value_group_get_changed_region().
    */
   signals[GROUP_CHANGED_EVENT] =
       g_signal_new ("group-changed", G_TYPE_FROM_CLASS (klass),
@@ -92,6 +92,7 @@ BtValueGroup *bt_value_group_new(const BtParameterGroup * const param_group, con
 BtValueGroup *bt_value_group_copy(const BtValueGroup * const self);
 
 GValue *bt_value_group_get_event_data(const BtValueGroup * const self, const gulong tick, const gulong param);
+gboolean bt_value_group_get_event_value(const BtValueGroup * const self, const gulong tick, const gulong param, GValue * const value);
 
 gboolean bt_value_group_set_event(const BtValueGroup * const self, const gulong tick, const gulong param, const gchar * const value);
 gchar *bt_value_group_get_event(const BtValueGroup * const self, const gulong tick, const gulong param);
@@ -111,6 +112,10 @@ void bt_value_group_serialize_column(const BtValueGroup * const self, const gulo
 void bt_value_group_serialize_columns(const BtValueGroup * const self, const gulong start_tick, const gulong end_tick, GString *data);
 gboolean bt_value_group_deserialize_column(const BtValueGroup * const self, const gulong start_tick, const gulong end_tick, const gulong param, const gchar *data);
 
+void bt_value_group_begin_batch(const BtValueGroup * const self);
+void bt_value_group_end_batch(const BtValueGroup * const self);
+gboolean bt_value_group_get_changed_region(const BtValueGroup * const self, gulong *beg_tick, gulong *end_tick, gulong *beg_param, gulong *end_param);
+
 GType bt_value_group_get_type(void) G_GNUC_CONST;
 
 #endif // BT_VALUE_GROUP_H
@@ -121,15 +121,16 @@ G_DEFINE_TYPE_WITH_CODE (BtWave, bt_wave, G_TYPE_OBJECT,
 GType
 bt_wave_loop_mode_get_type (void)
 {
-  static GType type = 0;
-  if (G_UNLIKELY (type == 0)) {
+  static gsize type = 0;
+  if (g_once_init_enter (&type)) {
     static const GEnumValue values[] = {
       {BT_WAVE_LOOP_MODE_OFF, "off", "off"},
       {BT_WAVE_LOOP_MODE_FORWARD, "forward", "forward"},
       {BT_WAVE_LOOP_MODE_PINGPONG, "ping-pong", "ping-pong"},
       {0, NULL, NULL},
     };
-    type = g_enum_register_static ("BtWaveLoopMode", values);
+    g_once_init_leave (&type,
+        g_enum_register_static ("BtWaveLoopMode", values));
   }
   return type;
 }
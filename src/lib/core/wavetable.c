@@ -69,6 +69,9 @@ struct _BtWavetablePrivate
    */
   GList *waves;                 // each entry points to a BtWave
   GList *missing_waves;         // each entry points to a gchar*
+
+  /* user-data and callbacks handed out to wave-table aware plugins */
+  gpointer callbacks[2];
 };
 
 static guint signals[LAST_SIGNAL] = { 0, };
@@ -515,13 +518,6 @@ get_wave_buffer (BtWavetable * self, guint wave_ix, guint wave_level_ix)
   return s;
 }
 
-static gpointer callbacks[] = {
-  /* user-data */
-  NULL,
-  /* callbacks */
-  get_wave_buffer
-};
-
 /* bt_wavetable_get_callbacks:
  * @self: wabe table
  *
@@ -530,12 +526,14 @@ static gpointer callbacks[] = {
  *
  * Note: this is not a well defined interface yet and subject to change.
  *
- * Returns a static pointer array. The first entry will point to the wavetable
- * and the 2nd entry will be a pointer to a function get get wave buffers.
+ * Returns a pointer array owned by the wavetable. The first entry will point to
+ * the wavetable and the 2nd entry will be a pointer to a function get get wave
+ * buffers.
  */
 gpointer
 bt_wavetable_get_callbacks (BtWavetable * self)
 {
-  callbacks[0] = (gpointer) self;
-  return &callbacks;
+  self->priv->callbacks[0] = (gpointer) self;
+  self->priv->callbacks[1] = (gpointer) get_wave_buffer;
+  return &self->priv->callbacks;
 }
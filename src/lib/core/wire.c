@@ -43,6 +43,10 @@
 #include "core_private.h"
 #include <glib/gprintf.h>
 
+/* time to ramp the volume to new values from the patterns, this avoids zipper
+ * noise on the sample accurate parameter changes */
+#define WIRE_PARAM_RAMP_TIME ((GstClockTime) (5 * GST_MSECOND))
+
 //-- property ids
 
 enum
@@ -56,7 +60,8 @@ enum
   WIRE_PAN,
   WIRE_NUM_PARAMS,
   WIRE_ANALYZERS,
-  WIRE_PRETTY_NAME
+  WIRE_PRETTY_NAME,
+  WIRE_CPU_LOAD
 };
 
 // capsfiter, convert, pan, volume are gap-aware
@@ -113,6 +118,9 @@ struct _BtWirePrivate
 
   /* wire analyzers */
   GList *analyzers;
+
+  /* processing time of the wire (after the queue) */
+  BtPerfData perf;
 };
 
 static GQuark error_domain = 0;
@@ -133,8 +141,15 @@ static gchar *sink_pn[] = {
   "sink"                        /* pan */
 };
 
+/* wires are also created from worker threads (e.g. bt-cmd batch rendering),
+ * the lock guards the lazy init of the factories */
+static GMutex factories_lock;
 static GstElementFactory *factories[PART_COUNT];
 
+//-- prototypes
+
+static GstPadProbeReturn bt_wire_on_perf_start (GstPad * pad,
+    GstPadProbeInfo * info, gpointer user_data);
 
 //-- the class
 
@@ -212,14 +227,17 @@ bt_wire_make_internal_element (const BtWire * const self, const BtWirePart part,
 
   g_return_val_if_fail ((self->priv->machines[part] == NULL), TRUE);
 
+  g_mutex_lock (&factories_lock);
   if (!factories[part]) {
     /* we never unref them, instead we keep them until the end */
-    if (!(factories[part] = gst_element_factory_find (factory_name))) {
-      GST_WARNING_OBJECT (self, "failed to lookup factory %s", factory_name);
-      goto Error;
-    }
+    factories[part] = gst_element_factory_find (factory_name);
   }
   f = factories[part];
+  g_mutex_unlock (&factories_lock);
+  if (!f) {
+    GST_WARNING_OBJECT (self, "failed to lookup factory %s", factory_name);
+    goto Error;
+  }
 
   // create internal element
   //strcat(name,parent_name);strcat(name,":");strcat(name,element_name);
@@ -260,6 +278,32 @@ Error:
   return res;
 }
 
+/*
+ * bt_wire_needs_queue:
+ * @self: the wire
+ * @n_pending: the number of wires from the same source that are being linked,
+ * but are not yet part of the setup
+ *
+ * A queue is only needed to decouple the branches of a spreader, that is if
+ * the source machine has more than one outgoing wire. In the parallel
+ * scheduling mode (see #BtSong:parallel) all wires get a queue.
+ *
+ * Returns: %TRUE if the wire should have a queue
+ */
+static gboolean
+bt_wire_needs_queue (const BtWire * const self, const guint n_pending)
+{
+  const BtMachine *const src = self->priv->src;
+  guint n_wires = g_list_length (src->src_wires) + n_pending;
+
+  if (bt_song_is_parallel (self->priv->song))
+    return TRUE;
+  // the wire is added to the setup after it has been linked
+  if (!g_list_find (src->src_wires, self))
+    n_wires++;
+  return n_wires > 1;
+}
+
 //-- helper methods
 
 static void
@@ -287,6 +331,15 @@ bt_wire_init_params (const BtWire * const self)
   self->priv->param_group =
       bt_parameter_group_new (self->priv->num_params, parents, params,
       self->priv->song, self->priv->dst);
+
+  // only the volume element reads value arrays, audiopanorama syncs once per
+  // buffer and would not see the ramp
+  GstControlBinding *cb = gst_object_get_control_binding ((GstObject *)
+      parents[0], params[0]->name);
+  if (cb) {
+    g_object_set (cb, "ramp-time", WIRE_PARAM_RAMP_TIME, NULL);
+    gst_object_unref (cb);
+  }
 }
 
 /*
@@ -341,9 +394,125 @@ bt_wire_deactivate_analyzers (const BtWire * const self)
       self->priv->analyzers, is_playing);
 }
 
+/*
+ * bt_wire_get_caps_channels:
+ * @self: the wire
+ * @caps: the caps to check
+ *
+ * Get the max number of channels that @caps allow.
+ *
+ * Returns: the number of channels, 1 if the caps have no channel field
+ */
+static gint
+bt_wire_get_caps_channels (const BtWire * const self, const GstCaps * caps)
+{
+  GstStructure *structure;
+  const GValue *cv;
+  gint c, i, channels = 1, size = gst_caps_get_size (caps);
+
+  for (i = 0; i < size; i++) {
+    if ((structure = gst_caps_get_structure (caps, i))) {
+      if ((cv = gst_structure_get_value (structure, "channels"))) {
+        if (G_VALUE_HOLDS_INT (cv)) {
+          c = g_value_get_int (cv);
+        } else if (GST_VALUE_HOLDS_INT_RANGE (cv)) {
+          c = gst_value_get_int_range_max (cv);
+        } else {
+          c = 0;
+          GST_WARNING_OBJECT (self, "type for channels on wire: %s",
+              g_type_name (gst_structure_get_field_type (structure,
+                      "channels")));
+        }
+        if (c > channels)
+          channels = c;
+      } else {
+        GST_WARNING_OBJECT (self,
+            "missing channels field in the wires sink machine sink-pad caps");
+      }
+    }
+  }
+  GST_INFO ("channels on wire.dst=%d, (checked %d caps)", channels, size);
+  return channels;
+}
+
+/*
+ * bt_wire_has_fixed_channels:
+ * @caps: the caps to check
+ *
+ * Check if all structures in @caps allow exactly one channel count.
+ *
+ * Returns: %TRUE if the channel count is fixed
+ */
+static gboolean
+bt_wire_has_fixed_channels (const GstCaps * const caps)
+{
+  const GValue *cv;
+  gint i, size = gst_caps_get_size (caps);
+
+  for (i = 0; i < size; i++) {
+    cv = gst_structure_get_value (gst_caps_get_structure (caps, i), "channels");
+    if (!cv || !G_VALUE_HOLDS_INT (cv))
+      return FALSE;
+  }
+  return (size > 0);
+}
+
+/*
+ * bt_wire_get_dst_channels:
+ * @self: the wire
+ * @dst_machine: the element of the target machine
+ * @pad: the sink pad of @dst_machine
+ *
+ * Determine how many channels the target machine will accept. Querying the
+ * allowed caps is expensive (it used to be ~14% of the loading time), thus we
+ * use the template caps if they already fix the channel count. The allowed
+ * caps depend on how the element is linked, hence the query is not cached.
+ *
+ * Returns: the number of channels or 0 if the caps are not known yet
+ */
+static gint
+bt_wire_get_dst_channels (const BtWire * const self,
+    GstElement * const dst_machine, GstPad * const pad)
+{
+  GstCaps *caps;
+  gint channels;
+  gboolean fixed = FALSE;
+
+  // the template caps limit what the pad can negotiate
+  caps = gst_pad_get_pad_template_caps (pad);
+  if (gst_caps_is_any (caps)) {
+    channels = 2;
+  } else {
+    channels = bt_wire_get_caps_channels (self, caps);
+    fixed = bt_wire_has_fixed_channels (caps);
+  }
+  gst_caps_unref (caps);
+  if (channels < 2 || fixed) {
+    return channels;
+  }
+  // a negotiated pad has a fixed format, that can differ between instances
+  if ((caps = gst_pad_get_current_caps (pad))) {
+    channels = bt_wire_get_caps_channels (self, caps);
+    gst_caps_unref (caps);
+    return channels;
+  }
+  // this does not work for unlinked pads
+  if ((caps = gst_pad_get_allowed_caps (pad))) {
+    GST_INFO_OBJECT (self, "caps on sink pad %" GST_PTR_FORMAT, caps);
+    channels = bt_wire_get_caps_channels (self, caps);
+    gst_caps_unref (caps);
+  } else {
+    GST_INFO_OBJECT (dst_machine, "empty caps :(");
+    channels = 0;
+  }
+  return channels;
+}
+
 /*
  * bt_wire_link_machines:
  * @self: the wire that should be used for this connection
+ * @n_pending: the number of wires from the same source that are being linked,
+ * but are not yet part of the setup
  *
  * Links the gst-element of this wire and tries a couple for conversion elements
  * if necessary.
@@ -351,7 +520,7 @@ bt_wire_deactivate_analyzers (const BtWire * const self)
  * Returns: %TRUE for success
  */
 static gboolean
-bt_wire_link_machines (const BtWire * const self)
+bt_wire_link_machines (const BtWire * const self, const guint n_pending)
 {
   gboolean res = TRUE;
   BtMachine *const src = self->priv->src;
@@ -360,41 +529,44 @@ bt_wire_link_machines (const BtWire * const self)
   GstPad **const src_pads = self->priv->src_pads;
   GstPad **const sink_pads = self->priv->sink_pads;
   GstElement *dst_machine, *src_machine;
-  GstCaps *caps;
-  const GstCaps *dst_caps = NULL;
-  GstPad *pad;
+  GstCaps *dst_caps = NULL;
+  GstPad *pad, *dst_pad;
   gboolean skip_convert = FALSE;
   guint six = PART_COUNT, dix = PART_COUNT;
 
   g_assert (BT_IS_WIRE (self));
 
-  if (!machines[PART_QUEUE]) {
-    /* TODO(ensonic): use the queue on demand.
-     * if(bt_machine_has_activate_spreader(src)
-     *    add the queue.
-     * else
-     *    remove the queue
-     *
-     * - we need to relink all outgoing wires for this src when adding or
-     *   removing a wire
-     * - maybe we can keep the queue elements and whenever we link/unlink a
-     *   wire, we check update the other wires. The update would link/unlink the
-     *   queue. See also the idle-loop section in song.c.
-     */
-    if (!bt_wire_make_internal_element (self, PART_QUEUE, "queue", "queue"))
-      return FALSE;
-    // configure the queue
-    // IDEA(ensonic): if machine on source side is a live-source, should be keep the queue larger?
-    // can max-size-buffers=1 cause stalling when dynamically relinking ?
-    g_object_set (G_OBJECT (machines[PART_QUEUE]), "max-size-buffers", 1,
-        "max-size-bytes", 0, "max-size-time", G_GUINT64_CONSTANT (0),
-        "silent", TRUE, NULL);
-    GST_DEBUG ("created queue element for wire : %p '%s' -> %p '%s'", src,
-        GST_OBJECT_NAME (src), dst, GST_OBJECT_NAME (dst));
+  /* A wire from a machine with a single outgoing wire runs in the thread of
+   * its source. When the source gets a second wire, bt_wire_connect() relinks
+   * this wire and the queue is added then. */
+  if (bt_wire_needs_queue (self, n_pending)) {
+    if (!machines[PART_QUEUE]) {
+      if (!bt_wire_make_internal_element (self, PART_QUEUE, "queue", "queue"))
+        return FALSE;
+      // configure the queue
+      // IDEA(ensonic): if machine on source side is a live-source, should be keep the queue larger?
+      // can max-size-buffers=1 cause stalling when dynamically relinking ?
+      g_object_set (G_OBJECT (machines[PART_QUEUE]), "max-size-buffers", 1,
+          "max-size-bytes", 0, "max-size-time", G_GUINT64_CONSTANT (0),
+          "silent", TRUE, NULL);
+      GST_DEBUG ("created queue element for wire : %p '%s' -> %p '%s'", src,
+          GST_OBJECT_NAME (src), dst, GST_OBJECT_NAME (dst));
+    }
+  } else if (machines[PART_QUEUE]) {
+    GST_INFO_OBJECT (self, "releasing queue");
+    gst_object_replace ((GstObject **) & src_pads[PART_QUEUE], NULL);
+    gst_object_replace ((GstObject **) & sink_pads[PART_QUEUE], NULL);
+    // stop the streaming thread of the queue before dropping it
+    gst_element_set_state (machines[PART_QUEUE], GST_STATE_NULL);
+    gst_bin_remove (GST_BIN (self), machines[PART_QUEUE]);
+    machines[PART_QUEUE] = NULL;
   }
   if (!machines[PART_TEE]) {
     if (!bt_wire_make_internal_element (self, PART_TEE, "tee", "tee"))
       return FALSE;
+    // the tee is the first element in the thread of the wire's destination
+    gst_pad_add_probe (sink_pads[PART_TEE], GST_PAD_PROBE_TYPE_BUFFER,
+        bt_wire_on_perf_start, (gpointer) self, NULL);
     GST_DEBUG ("created tee element for wire : %p '%s' -> %p '%s'", src,
         GST_OBJECT_NAME (src), dst, GST_OBJECT_NAME (dst));
   }
@@ -406,91 +578,34 @@ bt_wire_link_machines (const BtWire * const self)
   }
 
   g_object_get (dst, "machine", &dst_machine, NULL);
-  if ((pad = gst_element_get_static_pad (dst_machine, "sink"))) {
-    // this does not work for unlinked pads
-    // TODO(ensonic): if we link multiple machines to one, we could cache this
-    // it seems to be responsible for ~14% of the loading time
-    // - checking template caps it not enough - as the machine could have
-    //   negotiated to mono
-    // - would it make sense to quickly check template caps to exclude some cases?
-    if ((caps = gst_pad_get_allowed_caps (pad))) {
-      //if((caps=gst_pad_get_caps(pad))) {
-      GstStructure *structure;
-      const GValue *cv;
-      gint channels = 1;
-
-      GST_INFO_OBJECT (self, "caps on sink pad %" GST_PTR_FORMAT, caps);
-
-      if (GST_CAPS_IS_SIMPLE (caps)) {
-        structure = gst_caps_get_structure (caps, 0);
-
-        if ((cv = gst_structure_get_value (structure, "channels"))) {
-          if (G_VALUE_HOLDS_INT (cv)) {
-            channels = g_value_get_int (cv);
-          } else if (GST_VALUE_HOLDS_INT_RANGE (cv)) {
-            channels = gst_value_get_int_range_max (cv);
-          } else {
-            GST_WARNING_OBJECT (self, "type for channels on wire: %s",
-                g_type_name (gst_structure_get_field_type (structure,
-                        "channels")));
-          }
-          GST_INFO ("channels on wire.dst=%d", channels);
-        } else {
-          GST_WARNING_OBJECT (self,
-              "missing channels field in the wires sink machine sink-pad caps");
-        }
-      } else {
-        gint c, i, size = gst_caps_get_size (caps);
-
-        for (i = 0; i < size; i++) {
-          if ((structure = gst_caps_get_structure (caps, i))) {
-            if ((cv = gst_structure_get_value (structure, "channels"))) {
-              if (G_VALUE_HOLDS_INT (cv)) {
-                c = g_value_get_int (cv);
-              } else if (GST_VALUE_HOLDS_INT_RANGE (cv)) {
-                c = gst_value_get_int_range_max (cv);
-              } else {
-                c = 0;
-                GST_WARNING_OBJECT (self, "type for channels on wire: %s",
-                    g_type_name (gst_structure_get_field_type (structure,
-                            "channels")));
-              }
-              if (c > channels)
-                channels = c;
-            } else {
-              GST_WARNING_OBJECT (self,
-                  "missing channels field in the wires sink machine sink-pad caps");
-            }
-          }
+  if ((dst_pad = gst_element_get_static_pad (dst_machine, "sink"))) {
+    const gint channels =
+        bt_wire_get_dst_channels (self, dst_machine, dst_pad);
+
+    if (channels >= 2) {
+      /* insert panorama */
+      GST_DEBUG_OBJECT (self, "adding panorama/balance");
+      if (!machines[PART_PAN]) {
+        if (!bt_wire_make_internal_element (self, PART_PAN, "audiopanorama",
+                "pan")) {
+          gst_object_unref (dst_pad);
+          gst_object_unref (dst_machine);
+          return FALSE;
         }
-        GST_INFO ("channels on wire.dst=%d, (checked %d caps)", channels, size);
+        // simple method
+        g_object_set (G_OBJECT (machines[PART_PAN]), "method", 1, NULL);
       }
-      if (channels >= 2) {
-        /* insert panorama */
-        GST_DEBUG_OBJECT (self, "adding panorama/balance");
-        if (!machines[PART_PAN]) {
-          if (!bt_wire_make_internal_element (self, PART_PAN, "audiopanorama",
-                  "pan"))
-            return FALSE;
-          // simple method
-          g_object_set (G_OBJECT (machines[PART_PAN]), "method", 1, NULL);
-        }
-      } else {
-        GST_DEBUG ("channels on wire.dst=1, no panorama/balance needed");
-        if (machines[PART_PAN]) {
-          GST_WARNING_OBJECT (self, "releasing panorama/balance");
-          gst_bin_remove (GST_BIN (self), machines[PART_PAN]);
-          machines[PART_PAN] = NULL;
-        }
+    } else if (channels == 1) {
+      GST_DEBUG ("channels on wire.dst=1, no panorama/balance needed");
+      if (machines[PART_PAN]) {
+        GST_WARNING_OBJECT (self, "releasing panorama/balance");
+        gst_bin_remove (GST_BIN (self), machines[PART_PAN]);
+        machines[PART_PAN] = NULL;
       }
-      gst_caps_unref (caps);
-    } else {
-      GST_INFO_OBJECT (dst_machine, "empty caps :(");
     }
-    dst_caps = gst_pad_get_pad_template_caps (pad);
+    dst_caps = gst_pad_get_pad_template_caps (dst_pad);
     GST_INFO_OBJECT (self, "template caps on sink pad %" GST_PTR_FORMAT,
         dst_caps);
-    gst_object_unref (pad);
   }
   gst_object_unref (dst_machine);
 
@@ -498,22 +613,42 @@ bt_wire_link_machines (const BtWire * const self)
   // where we shouldn't
   g_object_get (src, "machine", &src_machine, NULL);
   if ((pad = gst_element_get_static_pad (src_machine, "src"))) {
-    const GstCaps *src_caps = gst_pad_get_pad_template_caps (pad);
-    if (!gst_caps_is_any (src_caps)) {
-      skip_convert = gst_caps_can_intersect (bt_default_caps, src_caps);
+    GstCaps *src_caps, *dst_cur_caps;
+
+    // if both sides already agreed on the same format, no need to convert
+    if (dst_pad && (src_caps = gst_pad_get_current_caps (pad))) {
+      if ((dst_cur_caps = gst_pad_get_current_caps (dst_pad))) {
+        skip_convert = gst_caps_is_equal (src_caps, dst_cur_caps);
+        gst_caps_unref (dst_cur_caps);
+      }
+      gst_caps_unref (src_caps);
     }
     if (skip_convert) {
-      if (!gst_caps_is_any (dst_caps)) {
-        skip_convert &= gst_caps_can_intersect (dst_caps, src_caps);
-      } else {
-        skip_convert = FALSE;
+      GST_INFO_OBJECT (self, "skipping converter: formats match");
+    } else {
+      src_caps = gst_pad_get_pad_template_caps (pad);
+      if (!gst_caps_is_any (src_caps)) {
+        skip_convert = gst_caps_can_intersect (bt_default_caps, src_caps);
       }
+      if (skip_convert) {
+        if (dst_caps && !gst_caps_is_any (dst_caps)) {
+          skip_convert &= gst_caps_can_intersect (dst_caps, src_caps);
+        } else {
+          skip_convert = FALSE;
+        }
+      }
+      GST_INFO_OBJECT (self, "skipping converter: %d? src_caps=%"
+          GST_PTR_FORMAT ", dst_caps=%" GST_PTR_FORMAT, skip_convert, src_caps,
+          dst_caps);
+      gst_caps_unref (src_caps);
     }
-    GST_INFO_OBJECT (self, "skipping converter: %d? src_caps=%" GST_PTR_FORMAT
-        ", dst_caps=%" GST_PTR_FORMAT, skip_convert, src_caps, dst_caps);
     gst_object_unref (pad);
   }
   gst_object_unref (src_machine);
+  if (dst_caps)
+    gst_caps_unref (dst_caps);
+  if (dst_pad)
+    gst_object_unref (dst_pad);
 
   GST_DEBUG ("trying to link machines : %p '%s' -> %p '%s'", src,
       GST_OBJECT_NAME (src), dst, GST_OBJECT_NAME (dst));
@@ -533,10 +668,13 @@ bt_wire_link_machines (const BtWire * const self)
       machines[PART_CONVERT] = NULL;
     }
   }
-  res = bt_wire_link_elements (self, src_pads[PART_QUEUE], sink_pads[PART_TEE]);
+  if (machines[PART_QUEUE]) {
+    res =
+        bt_wire_link_elements (self, src_pads[PART_QUEUE], sink_pads[PART_TEE]);
+  }
   res &= bt_wire_link_elements (self, src_pads[PART_TEE], sink_pads[PART_GAIN]);
   if (res) {
-    six = PART_QUEUE;
+    six = machines[PART_QUEUE] ? PART_QUEUE : PART_TEE;
     if (machines[PART_PAN]) {
       GST_DEBUG ("trying to link machines with pan");
       if (skip_convert) {
@@ -612,7 +750,9 @@ bt_wire_link_machines (const BtWire * const self)
     GST_DEBUG_BIN_TO_DOT_FILE_WITH_TS (GST_BIN (self),
         GST_DEBUG_GRAPH_SHOW_ALL, PACKAGE_NAME "-wire");
     GST_INFO ("failed to link the machines: six: %d, dix: %d", six, dix);
-    gst_pad_unlink (src_pads[PART_QUEUE], sink_pads[PART_TEE]);
+    if (machines[PART_QUEUE]) {
+      gst_pad_unlink (src_pads[PART_QUEUE], sink_pads[PART_TEE]);
+    }
     gst_pad_unlink (src_pads[PART_TEE], sink_pads[PART_GAIN]);
     // print out the content of both machines (using GST_DEBUG)
     bt_machine_dbg_print_parts (src);
@@ -639,12 +779,14 @@ bt_wire_unlink_machines (const BtWire * const self)
   g_assert (BT_IS_WIRE (self));
 
   // check if wire has been properly initialized
-  if (self->priv->src && self->priv->dst && machines[PART_QUEUE]
-      && machines[PART_TEE] && machines[PART_GAIN]) {
+  if (self->priv->src && self->priv->dst && machines[PART_TEE]
+      && machines[PART_GAIN]) {
     GST_DEBUG ("unlink machines '%s' -> '%s'",
         GST_OBJECT_NAME (self->priv->src), GST_OBJECT_NAME (self->priv->dst));
 
-    gst_pad_unlink (src_pads[PART_QUEUE], sink_pads[PART_TEE]);
+    if (machines[PART_QUEUE]) {
+      gst_pad_unlink (src_pads[PART_QUEUE], sink_pads[PART_TEE]);
+    }
     gst_pad_unlink (src_pads[PART_TEE], sink_pads[PART_GAIN]);
     if (machines[PART_CONVERT]) {
       if (machines[PART_PAN]) {
@@ -763,10 +905,10 @@ bt_wire_connect (const BtWire * const self)
   g_free (src_name);
   g_free (dst_name);
 
-  // if there is already a wire from src && src has not yet an spreader (in use)
+  // if there is already a wire from src, it needs a queue now
   if ((other_wire =
           (src->src_wires ? (BtWire *) (src->src_wires->data) : NULL))) {
-    if (!bt_machine_has_active_spreader (src)) {
+    if (!other_wire->priv->machines[PART_QUEUE]) {
       GST_DEBUG ("  other wire from src found");
       bt_wire_unlink_machines (other_wire);
       // create spreader (if needed)
@@ -775,7 +917,7 @@ bt_wire_connect (const BtWire * const self)
         return FALSE;
       }
       // correct the link for the other wire
-      if (!bt_wire_link_machines (other_wire)) {
+      if (!bt_wire_link_machines (other_wire, 1)) {
         GST_ERROR
             ("failed to re-link the machines after inserting internal spreader");
         return FALSE;
@@ -794,7 +936,7 @@ bt_wire_connect (const BtWire * const self)
         return FALSE;
       }
       // correct the link for the other wire
-      if (!bt_wire_link_machines (other_wire)) {
+      if (!bt_wire_link_machines (other_wire, 0)) {
         GST_ERROR
             ("failed to re-link the machines after inserting internal adder");
         return FALSE;
@@ -806,7 +948,7 @@ bt_wire_connect (const BtWire * const self)
       G_OBJECT_REF_COUNT_FMT ", dst: %" G_OBJECT_REF_COUNT_FMT,
       G_OBJECT_LOG_REF_COUNT (src), G_OBJECT_LOG_REF_COUNT (dst));
 
-  if (!bt_wire_link_machines (self)) {
+  if (!bt_wire_link_machines (self, 0)) {
     GST_ERROR ("linking machines failed : %p '%s' -> %p '%s'", src,
         GST_OBJECT_NAME (src), dst, GST_OBJECT_NAME (dst));
     return FALSE;
@@ -823,6 +965,22 @@ bt_wire_connect (const BtWire * const self)
 
 //-- signal handlers
 
+static GstPadProbeReturn
+bt_wire_on_perf_start (GstPad * pad, GstPadProbeInfo * info,
+    gpointer user_data)
+{
+  bt_perf_data_start (&BT_WIRE (user_data)->priv->perf);
+  return GST_PAD_PROBE_OK;
+}
+
+static GstPadProbeReturn
+bt_wire_on_perf_stop (GstPad * pad, GstPadProbeInfo * info, gpointer user_data)
+{
+  bt_perf_data_stop (&BT_WIRE (user_data)->priv->perf,
+      GST_BUFFER_DURATION (GST_PAD_PROBE_INFO_BUFFER (info)));
+  return GST_PAD_PROBE_OK;
+}
+
 static void
 on_wire_name_changed (GObject * obj, GParamSpec * arg, gpointer user_data)
 {
@@ -872,7 +1030,29 @@ bt_wire_reconnect (BtWire * const self)
   GST_DEBUG ("relinking machines '%s' -> '%s'",
       GST_OBJECT_NAME (self->priv->src), GST_OBJECT_NAME (self->priv->dst));
   bt_wire_unlink_machines (self);
-  return bt_wire_link_machines (self);
+  return bt_wire_link_machines (self, 0);
+}
+
+/*
+ * bt_wire_update_queue:
+ * @self: the wire
+ *
+ * Drops the queue if the wire does not need it anymore, e.g. because the other
+ * wires from its source machine have been removed.
+ *
+ * Returns: %TRUE for success and %FALSE otherwise
+ */
+gboolean
+bt_wire_update_queue (BtWire * const self)
+{
+  g_return_val_if_fail (BT_IS_WIRE (self), FALSE);
+
+  if (!self->priv->machines[PART_QUEUE] || bt_wire_needs_queue (self, 0))
+    return TRUE;
+
+  GST_INFO_OBJECT (self, "last wire from '%s', running without queue",
+      GST_OBJECT_NAME (self->priv->src));
+  return bt_wire_reconnect (self);
 }
 
 /**
@@ -1344,6 +1524,9 @@ bt_wire_get_property (GObject * const object, const guint property_id,
       g_free (dst_id);
       break;
     }
+    case WIRE_CPU_LOAD:
+      g_value_set_uint (value, bt_perf_data_get_load (&self->priv->perf));
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, property_id, pspec);
       break;
@@ -1477,6 +1660,9 @@ bt_wire_init (BtWire * self)
 
   self->priv->src_pad = gst_ghost_pad_new_no_target ("src", GST_PAD_SRC);
   gst_element_add_pad (GST_ELEMENT (self), self->priv->src_pad);
+  bt_perf_data_init (&self->priv->perf);
+  gst_pad_add_probe (self->priv->src_pad, GST_PAD_PROBE_TYPE_BUFFER,
+      bt_wire_on_perf_stop, (gpointer) self, NULL);
   self->priv->sink_pad = gst_ghost_pad_new_no_target ("sink", GST_PAD_SINK);
   gst_element_add_pad (GST_ELEMENT (self), self->priv->sink_pad);
 
@@ -1566,4 +1752,17 @@ bt_wire_class_init (BtWireClass * const klass)
       g_param_spec_string ("pretty-name", "pretty-name prop",
           "pretty-printed name for display purposes", NULL,
           G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+
+  /**
+   * BtWire:cpu-load:
+   *
+   * The time the wire spent processing the recent buffers in percent of the
+   * buffer durations.
+   *
+   * Since: 0.12
+   */
+  g_object_class_install_property (gobject_class, WIRE_CPU_LOAD,
+      g_param_spec_uint ("cpu-load", "cpu-load prop",
+          "cpu load of the wire in percent of realtime", 0, G_MAXUINT, 0,
+          G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
 }
@@ -72,7 +72,9 @@ struct _GstBtAudioSynth
  * GstBtAudioSynthClass:
  * @parent_class: parent type
  * @process: vmethod for generating a block of audio, return false to indicate
- * that a GAP buffer should be sent
+ * that a GAP buffer should be sent. Only do so once the output is silent and
+ * the tail (e.g. the release of the envelope) is over, downstream processors
+ * will be skipped.
  * @reset: vmethod call on stream discontinuities
  * @negotiate: vmethod for format negotiation
  * @setup: vmethod for initial processign setup
@@ -110,44 +110,42 @@ gstbt_combine_new (void)
 
 //-- private methods
 
+/* the bit-wise combiners work on the 16 bit integer representation */
+#define TO_S16(v) ((gint) CLAMP ((v) * 32767.0f, -32768.0f, 32767.0f))
+#define FROM_S16(v) ((gfloat) (v) / 32767.0f)
+
 static void
-gstbt_combine_mix (GstBtCombine * self, guint ct, gint16 * d1, gint16 * d2)
+gstbt_combine_mix (GstBtCombine * self, guint ct, gfloat * d1, gfloat * d2)
 {
   guint i;
-  glong mix;
 
   for (i = 0; i < ct; i++) {
-    mix = ((glong) d1[i] + (glong) d2[i]) >> 1;
-    d1[i] = (gint16) CLAMP (mix, G_MININT16, G_MAXINT16);
+    d1[i] = (d1[i] + d2[i]) * 0.5f;
   }
 }
 
 static void
-gstbt_combine_mul (GstBtCombine * self, guint ct, gint16 * d1, gint16 * d2)
+gstbt_combine_mul (GstBtCombine * self, guint ct, gfloat * d1, gfloat * d2)
 {
   guint i;
-  glong mix;
 
   for (i = 0; i < ct; i++) {
-    mix = ((glong) d1[i] * (glong) d2[i]) >> 15;
-    d1[i] = (gint16) CLAMP (mix, G_MININT16, G_MAXINT16);
+    d1[i] *= d2[i];
   }
 }
 
 static void
-gstbt_combine_sub (GstBtCombine * self, guint ct, gint16 * d1, gint16 * d2)
+gstbt_combine_sub (GstBtCombine * self, guint ct, gfloat * d1, gfloat * d2)
 {
   guint i;
-  glong mix;
 
   for (i = 0; i < ct; i++) {
-    mix = ((glong) d1[i] - (glong) d2[i]) >> 1;
-    d1[i] = (gint16) CLAMP (mix, G_MININT16, G_MAXINT16);
+    d1[i] = (d1[i] - d2[i]) * 0.5f;
   }
 }
 
 static void
-gstbt_combine_max (GstBtCombine * self, guint ct, gint16 * d1, gint16 * d2)
+gstbt_combine_max (GstBtCombine * self, guint ct, gfloat * d1, gfloat * d2)
 {
   guint i;
 
@@ -157,7 +155,7 @@ gstbt_combine_max (GstBtCombine * self, guint ct, gint16 * d1, gint16 * d2)
 }
 
 static void
-gstbt_combine_min (GstBtCombine * self, guint ct, gint16 * d1, gint16 * d2)
+gstbt_combine_min (GstBtCombine * self, guint ct, gfloat * d1, gfloat * d2)
 {
   guint i;
 
@@ -167,44 +165,44 @@ gstbt_combine_min (GstBtCombine * self, guint ct, gint16 * d1, gint16 * d2)
 }
 
 static void
-gstbt_combine_and (GstBtCombine * self, guint ct, gint16 * d1, gint16 * d2)
+gstbt_combine_and (GstBtCombine * self, guint ct, gfloat * d1, gfloat * d2)
 {
   guint i;
 
   for (i = 0; i < ct; i++) {
-    d1[i] &= d2[i];
+    d1[i] = FROM_S16 (TO_S16 (d1[i]) & TO_S16 (d2[i]));
   }
 }
 
 static void
-gstbt_combine_or (GstBtCombine * self, guint ct, gint16 * d1, gint16 * d2)
+gstbt_combine_or (GstBtCombine * self, guint ct, gfloat * d1, gfloat * d2)
 {
   guint i;
 
   for (i = 0; i < ct; i++) {
-    d1[i] |= d2[i];
+    d1[i] = FROM_S16 (TO_S16 (d1[i]) | TO_S16 (d2[i]));
   }
 }
 
 static void
-gstbt_combine_xor (GstBtCombine * self, guint ct, gint16 * d1, gint16 * d2)
+gstbt_combine_xor (GstBtCombine * self, guint ct, gfloat * d1, gfloat * d2)
 {
   guint i;
 
   for (i = 0; i < ct; i++) {
-    d1[i] ^= d2[i];
+    d1[i] = FROM_S16 (TO_S16 (d1[i]) ^ TO_S16 (d2[i]));
   }
 }
 
 static void
-gstbt_combine_fold (GstBtCombine * self, guint ct, gint16 * d1, gint16 * d2)
+gstbt_combine_fold (GstBtCombine * self, guint ct, gfloat * d1, gfloat * d2)
 {
   guint i;
-  gint16 d2a;
+  gfloat d2a;
 
   for (i = 0; i < ct; i++) {
     // we fold around +/- d2
-    d2a = abs (d2[i]);
+    d2a = fabsf (d2[i]);
     if (d1[i] > 0) {
       d1[i] = (d1[i] > d2a) ? (d2a - (d1[i] - d2a)) : d1[i];
     } else {
@@ -278,8 +276,8 @@ gstbt_combine_trigger (GstBtCombine * self)
  * Process @size samples of audio from @d1 and @d2. Stores the result into @d1.
  */
 void
-gstbt_combine_process (GstBtCombine * self, guint size, gint16 * d1,
-    gint16 * d2)
+gstbt_combine_process (GstBtCombine * self, guint size, gfloat * d1,
+    gfloat * d2)
 {
   gst_object_sync_values ((GstObject *) self, self->offset);
   self->process (self, size, d1, d2);
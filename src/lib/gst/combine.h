@@ -88,7 +88,7 @@ struct _GstBtCombine {
   guint64 offset;
 
   /* < private > */
-  void (*process) (GstBtCombine *, guint, gint16 *, gint16 *);
+  void (*process) (GstBtCombine *, guint, gfloat *, gfloat *);
 };
 
 struct _GstBtCombineClass {
@@ -100,7 +100,7 @@ GType gstbt_combine_get_type(void);
 GstBtCombine *gstbt_combine_new(void);
 
 void gstbt_combine_trigger(GstBtCombine *self);
-void gstbt_combine_process(GstBtCombine *self, guint size, gint16 *d1, gint16 *d2);
+void gstbt_combine_process(GstBtCombine *self, guint size, gfloat *d1, gfloat *d2);
 
 G_END_DECLS
 #endif /* __GSTBT_COMBINE_H__ */
@@ -82,7 +82,7 @@ gstbt_delay_start (GstBtDelay * self, gint samplerate)
 {
   self->samplerate = samplerate;
   self->max_delaytime = (2 + (MAX_DELAYTIME * samplerate) / 100);
-  self->ring_buffer = (gint16 *) g_new0 (gint16, self->max_delaytime);
+  self->ring_buffer = g_new0 (gfloat, self->max_delaytime);
   self->rb_ptr = 0;
   GST_INFO ("max_delaytime %d at %d Hz sampling rate", self->max_delaytime,
       samplerate);
@@ -97,7 +97,7 @@ gstbt_delay_start (GstBtDelay * self, gint samplerate)
 void
 gstbt_delay_flush (GstBtDelay * self)
 {
-  memset (self->ring_buffer, 0, sizeof (gint16) * self->max_delaytime);
+  memset (self->ring_buffer, 0, sizeof (gfloat) * self->max_delaytime);
   self->rb_ptr = 0;
 }
 
@@ -47,7 +47,7 @@ struct _GstBtDelay {
   guint delaytime;
 
   gint samplerate;
-  gint16 *ring_buffer;
+  gfloat *ring_buffer;
   guint max_delaytime;
   guint rb_ptr;
 };
@@ -114,7 +114,7 @@ void gstbt_delay_stop (GstBtDelay *self);
  * Write to @v the ring-buffer and advance the position.
  */
 #define GSTBT_DELAY_WRITE(self,rb_in,v) G_STMT_START { \
-  self->ring_buffer[rb_in++] = (gint16) v;             \
+  self->ring_buffer[rb_in++] = (gfloat) (v);           \
   if (rb_in == self->max_delaytime) rb_in = 0;         \
 } G_STMT_END
 
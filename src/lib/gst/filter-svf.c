@@ -109,7 +109,7 @@ gstbt_filter_svf_new (void)
 //-- private methods
 
 static void
-gstbt_filter_svf_lowpass (GstBtFilterSVF * self, guint ct, gint16 * samples)
+gstbt_filter_svf_lowpass (GstBtFilterSVF * self, guint ct, gfloat * samples)
 {
   guint i;
   gdouble flt_low = self->flt_low;
@@ -123,7 +123,7 @@ gstbt_filter_svf_lowpass (GstBtFilterSVF * self, guint ct, gint16 * samples)
     flt_mid += (flt_high * cutoff);
     flt_low += (flt_mid * cutoff);
 
-    samples[i] = (gint16) CLAMP ((glong) flt_low, G_MININT16, G_MAXINT16);
+    samples[i] = (gfloat) flt_low;
   }
   self->flt_low = flt_low;
   self->flt_mid = flt_mid;
@@ -131,7 +131,7 @@ gstbt_filter_svf_lowpass (GstBtFilterSVF * self, guint ct, gint16 * samples)
 }
 
 static void
-gstbt_filter_svf_hipass (GstBtFilterSVF * self, guint ct, gint16 * samples)
+gstbt_filter_svf_hipass (GstBtFilterSVF * self, guint ct, gfloat * samples)
 {
   guint i;
   gdouble flt_low = self->flt_low;
@@ -145,7 +145,7 @@ gstbt_filter_svf_hipass (GstBtFilterSVF * self, guint ct, gint16 * samples)
     flt_mid += (flt_high * cutoff);
     flt_low += (flt_mid * cutoff);
 
-    samples[i] = (gint16) CLAMP ((glong) flt_high, G_MININT16, G_MAXINT16);
+    samples[i] = (gfloat) flt_high;
   }
   self->flt_low = flt_low;
   self->flt_mid = flt_mid;
@@ -153,7 +153,7 @@ gstbt_filter_svf_hipass (GstBtFilterSVF * self, guint ct, gint16 * samples)
 }
 
 static void
-gstbt_filter_svf_bandpass (GstBtFilterSVF * self, guint ct, gint16 * samples)
+gstbt_filter_svf_bandpass (GstBtFilterSVF * self, guint ct, gfloat * samples)
 {
   guint i;
   gdouble flt_low = self->flt_low;
@@ -167,7 +167,7 @@ gstbt_filter_svf_bandpass (GstBtFilterSVF * self, guint ct, gint16 * samples)
     flt_mid += (flt_high * cutoff);
     flt_low += (flt_mid * cutoff);
 
-    samples[i] = (gint16) CLAMP ((glong) flt_mid, G_MININT16, G_MAXINT16);
+    samples[i] = (gfloat) flt_mid;
   }
   self->flt_low = flt_low;
   self->flt_mid = flt_mid;
@@ -175,7 +175,7 @@ gstbt_filter_svf_bandpass (GstBtFilterSVF * self, guint ct, gint16 * samples)
 }
 
 static void
-gstbt_filter_svf_bandstop (GstBtFilterSVF * self, guint ct, gint16 * samples)
+gstbt_filter_svf_bandstop (GstBtFilterSVF * self, guint ct, gfloat * samples)
 {
   guint i;
   gdouble flt_low = self->flt_low;
@@ -189,8 +189,7 @@ gstbt_filter_svf_bandstop (GstBtFilterSVF * self, guint ct, gint16 * samples)
     flt_mid += (flt_high * cutoff);
     flt_low += (flt_mid * cutoff);
 
-    samples[i] =
-        (gint16) CLAMP ((glong) (flt_low + flt_high), G_MININT16, G_MAXINT16);
+    samples[i] = (gfloat) (flt_low + flt_high);
   }
   self->flt_low = flt_low;
   self->flt_mid = flt_mid;
@@ -250,7 +249,7 @@ gstbt_filter_svf_trigger (GstBtFilterSVF * self)
  * Process @size samples of audio from @data and store them into @data.
  */
 void
-gstbt_filter_svf_process (GstBtFilterSVF * self, guint size, gint16 * data)
+gstbt_filter_svf_process (GstBtFilterSVF * self, guint size, gfloat * data)
 {
   if (self->process) {
     gst_object_sync_values ((GstObject *) self, self->offset);
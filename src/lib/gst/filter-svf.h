@@ -86,7 +86,7 @@ struct _GstBtFilterSVF {
   gdouble flt_res;
 
   /* < private > */
-  void (*process) (GstBtFilterSVF *, guint, gint16 *);
+  void (*process) (GstBtFilterSVF *, guint, gfloat *);
 };
 
 struct _GstBtFilterSVFClass {
@@ -98,7 +98,7 @@ GType gstbt_filter_svf_get_type(void);
 GstBtFilterSVF *gstbt_filter_svf_new(void);
 
 void gstbt_filter_svf_trigger(GstBtFilterSVF *self);
-void gstbt_filter_svf_process(GstBtFilterSVF *self, guint size, gint16 *data);
+void gstbt_filter_svf_process(GstBtFilterSVF *self, guint size, gfloat *data);
 
 G_END_DECLS
 #endif /* __GSTBT_FILTER_SVF_H__ */
@@ -182,7 +182,7 @@ gstbt_osc_synth_new (void)
 } while (0)
 
 static void
-gstbt_osc_synth_create_sine (GstBtOscSynth * self, guint ct, gint16 * samples)
+gstbt_osc_synth_create_sine (GstBtOscSynth * self, guint ct, gfloat * samples)
 {
   guint i = 0, j, c, r = ct;
   guint64 offset = self->offset;
@@ -192,7 +192,7 @@ gstbt_osc_synth_create_sine (GstBtOscSynth * self, guint ct, gint16 * samples)
 
   while (i < ct) {
     gst_object_sync_values ((GstObject *) self, offset + i);
-    amp = self->vol * 32767.0;
+    amp = self->vol;
     step = self->freq * period;
     UPDATE_INNER_LOOP (c, r);
     for (j = 0; j < c; j++, i++) {
@@ -200,14 +200,14 @@ gstbt_osc_synth_create_sine (GstBtOscSynth * self, guint ct, gint16 * samples)
       if (G_UNLIKELY (accumulator >= M_PI_M2))
         accumulator -= M_PI_M2;
 
-      samples[i] = (gint16) (sin (accumulator) * amp);
+      samples[i] = (gfloat) (sin (accumulator) * amp);
     }
   }
   self->accumulator = accumulator;
 }
 
 static void
-gstbt_osc_synth_create_square (GstBtOscSynth * self, guint ct, gint16 * samples)
+gstbt_osc_synth_create_square (GstBtOscSynth * self, guint ct, gfloat * samples)
 {
   guint i = 0, j, c, r = ct;
   guint64 offset = self->offset;
@@ -217,7 +217,7 @@ gstbt_osc_synth_create_square (GstBtOscSynth * self, guint ct, gint16 * samples)
 
   while (i < ct) {
     gst_object_sync_values ((GstObject *) self, offset + i);
-    amp = self->vol * 32767.0;
+    amp = self->vol;
     step = self->freq * period;
     UPDATE_INNER_LOOP (c, r);
     for (j = 0; j < c; j++, i++) {
@@ -225,19 +225,19 @@ gstbt_osc_synth_create_square (GstBtOscSynth * self, guint ct, gint16 * samples)
       if (G_UNLIKELY (accumulator >= M_PI_M2))
         accumulator -= M_PI_M2;
 
-      samples[i] = (gint16) ((accumulator < M_PI) ? amp : -amp);
+      samples[i] = (gfloat) ((accumulator < M_PI) ? amp : -amp);
     }
   }
   self->accumulator = accumulator;
 }
 
 static void
-gstbt_osc_synth_create_saw (GstBtOscSynth * self, guint ct, gint16 * samples)
+gstbt_osc_synth_create_saw (GstBtOscSynth * self, guint ct, gfloat * samples)
 {
   guint i = 0, j, c, r = ct;
   guint64 offset = self->offset;
   gdouble amp, step;
-  gdouble ampf = 32767.0 / M_PI;
+  gdouble ampf = 1.0 / M_PI;
   gdouble accumulator = self->accumulator;
   gdouble period = self->period;
 
@@ -252,9 +252,9 @@ gstbt_osc_synth_create_saw (GstBtOscSynth * self, guint ct, gint16 * samples)
         accumulator -= M_PI_M2;
 
       if (accumulator < M_PI) {
-        samples[i] = (gint16) (accumulator * amp);
+        samples[i] = (gfloat) (accumulator * amp);
       } else {
-        samples[i] = (gint16) ((M_PI_M2 - accumulator) * -amp);
+        samples[i] = (gfloat) ((M_PI_M2 - accumulator) * -amp);
       }
     }
   }
@@ -263,12 +263,12 @@ gstbt_osc_synth_create_saw (GstBtOscSynth * self, guint ct, gint16 * samples)
 
 static void
 gstbt_osc_synth_create_triangle (GstBtOscSynth * self, guint ct,
-    gint16 * samples)
+    gfloat * samples)
 {
   guint i = 0, j, c, r = ct;
   guint64 offset = self->offset;
   gdouble amp, step;
-  gdouble ampf = 65535.0 / M_PI;
+  gdouble ampf = 2.0 / M_PI;
   gdouble accumulator = self->accumulator;
   gdouble period = self->period;
 
@@ -283,11 +283,11 @@ gstbt_osc_synth_create_triangle (GstBtOscSynth * self, guint ct,
         accumulator -= M_PI_M2;
 
       if (accumulator < (M_PI * 0.5)) {
-        samples[i] = (gint16) (accumulator * amp);
+        samples[i] = (gfloat) (accumulator * amp);
       } else if (accumulator < (M_PI * 1.5)) {
-        samples[i] = (gint16) ((accumulator - M_PI) * -amp);
+        samples[i] = (gfloat) ((accumulator - M_PI) * -amp);
       } else {
-        samples[i] = (gint16) ((M_PI_M2 - accumulator) * -amp);
+        samples[i] = (gfloat) ((M_PI_M2 - accumulator) * -amp);
       }
     }
   }
@@ -296,14 +296,14 @@ gstbt_osc_synth_create_triangle (GstBtOscSynth * self, guint ct,
 
 static void
 gstbt_osc_synth_create_silence (GstBtOscSynth * self, guint ct,
-    gint16 * samples)
+    gfloat * samples)
 {
-  memset (samples, 0, ct * sizeof (gint16));
+  memset (samples, 0, ct * sizeof (gfloat));
 }
 
 static void
 gstbt_osc_synth_create_white_noise (GstBtOscSynth * self, guint ct,
-    gint16 * samples)
+    gfloat * samples)
 {
   guint i = 0, j, c, r = ct;
   guint64 offset = self->offset;
@@ -315,7 +315,7 @@ gstbt_osc_synth_create_white_noise (GstBtOscSynth * self, guint ct,
     UPDATE_INNER_LOOP (c, r);
     for (j = 0; j < c; j++, i++) {
       samples[i] =
-          (gint16) (amp * (32768.0 - (65535.0 * rand () / (RAND_MAX + 1.0))));
+          (gfloat) (amp * (1.0 - (2.0 * rand () / (RAND_MAX + 1.0))));
     }
   }
 }
@@ -382,7 +382,7 @@ gstbt_osc_synth_generate_pink_noise_value (GstBtPinkNoise * pink)
 
 static void
 gstbt_osc_synth_create_pink_noise (GstBtOscSynth * self, guint ct,
-    gint16 * samples)
+    gfloat * samples)
 {
   guint i = 0, j, c, r = ct;
   GstBtPinkNoise *pink = &self->pink;
@@ -391,11 +391,11 @@ gstbt_osc_synth_create_pink_noise (GstBtOscSynth * self, guint ct,
 
   while (i < ct) {
     gst_object_sync_values ((GstObject *) self, offset + i);
-    amp = self->vol * 32767.0;
+    amp = self->vol;
     UPDATE_INNER_LOOP (c, r);
     for (j = 0; j < c; j++, i++) {
       samples[i] =
-          (gint16) (gstbt_osc_synth_generate_pink_noise_value (pink) * amp);
+          (gfloat) (gstbt_osc_synth_generate_pink_noise_value (pink) * amp);
     }
   }
 }
@@ -407,7 +407,7 @@ gstbt_osc_synth_create_pink_noise (GstBtOscSynth * self, guint ct,
  */
 static void
 gstbt_osc_synth_create_gaussian_white_noise (GstBtOscSynth * self, guint ct,
-    gint16 * samples)
+    gfloat * samples)
 {
   gint i = 0, j, c, r = ct;
   guint64 offset = self->offset;
@@ -415,22 +415,22 @@ gstbt_osc_synth_create_gaussian_white_noise (GstBtOscSynth * self, guint ct,
 
   while (i < ct) {
     gst_object_sync_values ((GstObject *) self, offset + i);
-    amp = self->vol * 32767.0;
+    amp = self->vol;
     UPDATE_INNER_LOOP (c, r);
     for (j = 0; j < c; j += 2) {
       gdouble mag = sqrt (-2 * log (1.0 - rand () / (RAND_MAX + 1.0)));
       gdouble phs = M_PI_M2 * rand () / (RAND_MAX + 1.0);
 
-      samples[i++] = (gint16) (amp * mag * cos (phs));
+      samples[i++] = (gfloat) (amp * mag * cos (phs));
       if (i < ct)
-        samples[i++] = (gint16) (amp * mag * sin (phs));
+        samples[i++] = (gfloat) (amp * mag * sin (phs));
     }
   }
 }
 
 static void
 gstbt_osc_synth_create_red_noise (GstBtOscSynth * self, guint ct,
-    gint16 * samples)
+    gfloat * samples)
 {
   gint i = 0, j, c, r = ct;
   guint64 offset = self->offset;
@@ -439,7 +439,7 @@ gstbt_osc_synth_create_red_noise (GstBtOscSynth * self, guint ct,
 
   while (i < ct) {
     gst_object_sync_values ((GstObject *) self, offset + i);
-    amp = self->vol * 32767.0;
+    amp = self->vol;
     UPDATE_INNER_LOOP (c, r);
     for (j = 0; j < c; j++, i++) {
       while (TRUE) {
@@ -450,7 +450,7 @@ gstbt_osc_synth_create_red_noise (GstBtOscSynth * self, guint ct,
         else
           break;
       }
-      samples[i] = (gint16) (amp * state * 0.0625f);    /* /16.0 */
+      samples[i] = (gfloat) (amp * state * 0.0625f);    /* /16.0 */
     }
   }
   self->red.state = state;
@@ -458,7 +458,7 @@ gstbt_osc_synth_create_red_noise (GstBtOscSynth * self, guint ct,
 
 static void
 gstbt_osc_synth_create_blue_noise (GstBtOscSynth * self, guint ct,
-    gint16 * samples)
+    gfloat * samples)
 {
   gint i;
   gdouble flip = self->flip;
@@ -473,7 +473,7 @@ gstbt_osc_synth_create_blue_noise (GstBtOscSynth * self, guint ct,
 
 static void
 gstbt_osc_synth_create_violet_noise (GstBtOscSynth * self, guint ct,
-    gint16 * samples)
+    gfloat * samples)
 {
   gint i;
   gdouble flip = self->flip;
@@ -488,7 +488,7 @@ gstbt_osc_synth_create_violet_noise (GstBtOscSynth * self, guint ct,
 
 static void
 gstbt_osc_synth_create_s_and_h (GstBtOscSynth * self, guint ct,
-    gint16 * samples)
+    gfloat * samples)
 {
   guint i = 0, j, c, r = ct;
   guint64 offset = self->offset;
@@ -509,10 +509,10 @@ gstbt_osc_synth_create_s_and_h (GstBtOscSynth * self, guint ct,
         step = self->freq;
         step = CLAMP (step, 1, samplerate);
         count = samplerate / step;
-        smpl = 32768 - (65535.0 * rand () / (RAND_MAX + 1.0));
+        smpl = 1.0 - (2.0 * rand () / (RAND_MAX + 1.0));
         amp = self->vol;
       }
-      samples[i] = (gint16) (amp * smpl);
+      samples[i] = (gfloat) (amp * smpl);
       count--;
     }
   }
@@ -521,7 +521,7 @@ gstbt_osc_synth_create_s_and_h (GstBtOscSynth * self, guint ct,
 }
 
 static void
-gstbt_osc_synth_create_spikes (GstBtOscSynth * self, guint ct, gint16 * samples)
+gstbt_osc_synth_create_spikes (GstBtOscSynth * self, guint ct, gfloat * samples)
 {
   guint i = 0, j, c, r = ct;
   guint64 offset = self->offset;
@@ -540,10 +540,10 @@ gstbt_osc_synth_create_spikes (GstBtOscSynth * self, guint ct, gint16 * samples)
         step = self->freq;
         step = CLAMP (step, 1, samplerate);
         count = samplerate / step;
-        smpl = 32768 - (65535.0 * rand () / (RAND_MAX + 1.0));
-        samples[i] = (gint16) (self->vol * smpl);
+        smpl = 1.0 - (2.0 * rand () / (RAND_MAX + 1.0));
+        samples[i] = (gfloat) (self->vol * smpl);
       } else {
-        samples[i] = (gint16) 0;
+        samples[i] = 0.0f;
       }
       count--;
     }
@@ -553,7 +553,7 @@ gstbt_osc_synth_create_spikes (GstBtOscSynth * self, guint ct, gint16 * samples)
 
 static void
 gstbt_osc_synth_create_s_and_g (GstBtOscSynth * self, guint ct,
-    gint16 * samples)
+    gfloat * samples)
 {
   guint i = 0, j, c, r = ct;
   guint64 offset = self->offset;
@@ -575,11 +575,11 @@ gstbt_osc_synth_create_s_and_g (GstBtOscSynth * self, guint ct,
         step = self->freq;
         step = CLAMP (step, 1, samplerate);
         count = samplerate / step;
-        next = 32768 - (65535.0 * rand () / (RAND_MAX + 1.0));
+        next = 1.0 - (2.0 * rand () / (RAND_MAX + 1.0));
         next = (next - smpl) / (gdouble) count;
         amp = self->vol;
       }
-      samples[i] = (gint16) (amp * smpl);
+      samples[i] = (gfloat) (amp * smpl);
       count--;
       smpl += next;
     }
@@ -689,7 +689,7 @@ gstbt_osc_synth_trigger (GstBtOscSynth * self)
     case GSTBT_OSC_SYNTH_WAVE_S_AND_G:
       self->sh.count = 0;
       self->sh.smpl = 0.0;
-      self->sh.next = 32768 - (65535.0 * rand () / (RAND_MAX + 1.0));
+      self->sh.next = 1.0 - (2.0 * rand () / (RAND_MAX + 1.0));
       break;
     default:
       GST_ERROR ("invalid wave-form: %d", self->wave);
@@ -706,7 +706,7 @@ gstbt_osc_synth_trigger (GstBtOscSynth * self)
  * Generate @size samples of audio and store them into @data.
  */
 void
-gstbt_osc_synth_process (GstBtOscSynth * self, guint size, gint16 * data)
+gstbt_osc_synth_process (GstBtOscSynth * self, guint size, gfloat * data)
 {
   self->process (self, size, data);
   self->offset += size;
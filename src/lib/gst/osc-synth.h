@@ -197,7 +197,7 @@ struct _GstBtOscSynth {
   GstBtSampleAndHold sh;
 
   /* < private > */
-  void (*process) (GstBtOscSynth *, guint, gint16 *);
+  void (*process) (GstBtOscSynth *, guint, gfloat *);
 };
 
 struct _GstBtOscSynthClass {
@@ -208,7 +208,7 @@ GType gstbt_osc_synth_get_type(void);
 
 GstBtOscSynth *gstbt_osc_synth_new(void);
 void gstbt_osc_synth_trigger(GstBtOscSynth *self);
-void gstbt_osc_synth_process(GstBtOscSynth *self, guint size, gint16 *data);
+void gstbt_osc_synth_process(GstBtOscSynth *self, guint size, gfloat *data);
 
 G_END_DECLS
 #endif /* __GSTBT_OSC_SYNTH_H__ */
@@ -75,16 +75,20 @@ gstbt_osc_wave_new (void)
 
 //-- private methods
 
+/* the wave data is kept as 16 bit integers, we render float samples */
+#define S16_TO_FLOAT(v) ((gfloat) (v) * (1.0f / 32768.0f))
+
 static gboolean
 gstbt_osc_wave_create_mono (GstBtOscWave * self, guint64 off, guint ct,
-    gint16 * dst)
+    gfloat * dst)
 {
   g_return_val_if_fail (self->data, FALSE);
 
   const guint ss = sizeof (gint16);
   guint size = self->map_info.size;
+  guint i;
   if (off * ss >= size) {
-    memset (dst, 0, ct * ss);
+    memset (dst, 0, ct * sizeof (gfloat));
     GST_DEBUG ("beyond size");
     return FALSE;
   }
@@ -94,25 +98,29 @@ gstbt_osc_wave_create_mono (GstBtOscWave * self, guint64 off, guint ct,
   if ((off + ct) * ss >= size) {
     guint ct2 = (size / ss) - off;
     // clear end of buffer
-    memset (&dst[ct2], 0, (ct - ct2) * ss);
+    memset (&dst[ct2], 0, (ct - ct2) * sizeof (gfloat));
     ct = ct2;
   }
   // copy from data[off] ... data[off+ct]
-  memcpy (dst, &src[off], ct * ss);
+  src = &src[off];
+  for (i = 0; i < ct; i++) {
+    dst[i] = S16_TO_FLOAT (src[i]);
+  }
 
   return TRUE;
 }
 
 static gboolean
 gstbt_osc_wave_create_stereo (GstBtOscWave * self, guint64 off, guint ct,
-    gint16 * dst)
+    gfloat * dst)
 {
   g_return_val_if_fail (self->data, FALSE);
 
   const guint ss = 2 * sizeof (gint16);
   guint size = self->map_info.size;
+  guint i;
   if (off * ss >= size) {
-    memset (dst, 0, ct * ss);
+    memset (dst, 0, ct * 2 * sizeof (gfloat));
     GST_DEBUG ("beyond size");
     return FALSE;
   }
@@ -122,25 +130,28 @@ gstbt_osc_wave_create_stereo (GstBtOscWave * self, guint64 off, guint ct,
   if ((off + ct) * ss >= size) {
     guint ct2 = (size / ss) - off;
     // clear end of buffer
-    memset (&dst[ct2 * 2], 0, (ct - ct2) * ss);
+    memset (&dst[ct2 * 2], 0, (ct - ct2) * 2 * sizeof (gfloat));
     ct = ct2;
   }
   // copy from data[off] ... data[off+ct]
-  memcpy (dst, &src[off * 2], ct * ss);
+  src = &src[off * 2];
+  for (i = 0; i < ct * 2; i++) {
+    dst[i] = S16_TO_FLOAT (src[i]);
+  }
 
   return TRUE;
 }
 
 static gboolean
 gstbt_osc_wave_create_mono_resampled (GstBtOscWave * self, guint64 off,
-    guint ct, gint16 * dst)
+    guint ct, gfloat * dst)
 {
   g_return_val_if_fail (self->data, FALSE);
 
   const guint ss = sizeof (gint16);
   guint size = self->map_info.size;
   if (off * ss >= size) {
-    memset (dst, 0, ct * ss);
+    memset (dst, 0, ct * sizeof (gfloat));
     GST_DEBUG ("beyond size");
     return FALSE;
   }
@@ -151,7 +162,7 @@ gstbt_osc_wave_create_mono_resampled (GstBtOscWave * self, guint64 off,
 
   for (d = 0; d < ct; d++) {
     s = (off + d) * rate;
-    dst[d] = (s * ss < size) ? src[s] : 0;
+    dst[d] = (s * ss < size) ? S16_TO_FLOAT (src[s]) : 0.0f;
   }
 
   return TRUE;
@@ -159,14 +170,14 @@ gstbt_osc_wave_create_mono_resampled (GstBtOscWave * self, guint64 off,
 
 static gboolean
 gstbt_osc_wave_create_stereo_resampled (GstBtOscWave * self, guint64 off,
-    guint ct, gint16 * dst)
+    guint ct, gfloat * dst)
 {
   g_return_val_if_fail (self->data, FALSE);
 
   const guint ss = 2 * sizeof (gint16);
   guint size = self->map_info.size;
   if (off * ss >= size) {
-    memset (dst, 0, ct * ss);
+    memset (dst, 0, ct * 2 * sizeof (gfloat));
     GST_DEBUG ("beyond size");
     return FALSE;
   }
@@ -178,11 +189,11 @@ gstbt_osc_wave_create_stereo_resampled (GstBtOscWave * self, guint64 off,
   for (d = 0; d < ct; d++) {
     s = (off + d) * rate;
     if (s * ss < size) {
-      dst[d << 1] = src[(s << 1)];
-      dst[(d << 1) + 1] = src[(s << 1) + 1];
+      dst[d << 1] = S16_TO_FLOAT (src[(s << 1)]);
+      dst[(d << 1) + 1] = S16_TO_FLOAT (src[(s << 1) + 1]);
     } else {
-      dst[d << 1] = 0;
-      dst[(d << 1) + 1] = 0;
+      dst[d << 1] = 0.0f;
+      dst[(d << 1) + 1] = 0.0f;
     }
   }
 
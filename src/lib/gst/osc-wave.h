@@ -59,7 +59,7 @@ struct _GstBtOscWave {
   guint64 duration;
 
   /* < private > */
-  gboolean (*process) (GstBtOscWave *, guint64, guint, gint16 *);  
+  gboolean (*process) (GstBtOscWave *, guint64, guint, gfloat *);  
 };
 
 struct _GstBtOscWaveClass {
@@ -63,6 +63,17 @@ extern GQuark gstbt_property_meta_quark_max_val;
 extern GQuark gstbt_property_meta_quark_def_val;
 extern GQuark gstbt_property_meta_quark_no_val;
 
+/**
+ * GSTBT_ELEMENT_METADATA_GAP_AWARE:
+ *
+ * Element metadata key. Effects set it to "true" if they flag their output as
+ * GAP only once it is silent and their tail (e.g. echos) is over. Such effects
+ * are skipped while they are idle and receive GAP input.
+ *
+ * Since: 0.12
+ */
+#define GSTBT_ELEMENT_METADATA_GAP_AWARE "bt::gap-aware"
+
 G_END_DECLS
 
 /**
@@ -138,5 +138,5 @@ gdouble ticktime_err =
 
 // the values are use like this in sources:
 gst_base_src_set_blocksize (GST_BASE_SRC (self),
-    channels * generate_samples_per_buffer * sizeof (gint16));
+    channels * generate_samples_per_buffer * sizeof (gfloat));
 #endif
@@ -56,6 +56,8 @@ struct _BtIcMidiDevicePrivate
   /* io channel */
   GIOChannel *io_channel;
   guint io_source;
+  /* last status byte for running status */
+  guchar prev_cmd;
 
   /* learn-mode members */
   gboolean learn_mode;
@@ -129,7 +131,6 @@ io_handler (GIOChannel * channel, GIOCondition condition, gpointer user_data)
   GError *error = NULL;
   gsize bytes_read;
   guchar midi_event[3], cmd;
-  static guchar prev_cmd = 0;
   guint key;
   gboolean res = TRUE;
 
@@ -146,12 +147,12 @@ io_handler (GIOChannel * channel, GIOCondition condition, gpointer user_data)
 
       GST_LOG ("command: %02x", midi_event[0]);
       cmd = midi_event[0] & MIDI_CMD_MASK;
-      if (cmd < 0x80 && prev_cmd) {
+      if (cmd < 0x80 && self->priv->prev_cmd) {
         have_read = 1;
         midi_event[1] = midi_event[0];
-        midi_event[0] = prev_cmd;
+        midi_event[0] = self->priv->prev_cmd;
         midi_data = &midi_event[2];
-        cmd = prev_cmd & MIDI_CMD_MASK;
+        cmd = self->priv->prev_cmd & MIDI_CMD_MASK;
       }
       // http://www.midi.org/techspecs/midimessages.php
       // http://www.cs.cf.ac.uk/Dave/Multimedia/node158.html
@@ -180,7 +181,7 @@ io_handler (GIOChannel * channel, GIOCondition condition, gpointer user_data)
             }
             // also handle note-off velocity
 #endif
-            prev_cmd = midi_event[0];
+            self->priv->prev_cmd = midi_event[0];
           }
           break;
         case MIDI_NOTE_ON:
@@ -241,7 +242,7 @@ io_handler (GIOChannel * channel, GIOCondition condition, gpointer user_data)
             } else if (G_UNLIKELY (self->priv->learn_mode) && !learn_1st) {
               update_learn_info (self, "note-velocity", key, 7);
             }
-            prev_cmd = midi_event[0];
+            self->priv->prev_cmd = midi_event[0];
           }
           break;
         case MIDI_CONTROL_CHANGE:
@@ -263,7 +264,7 @@ io_handler (GIOChannel * channel, GIOCondition condition, gpointer user_data)
               snprintf (name, sizeof(name), "control-change %u", key);
               update_learn_info (self, name, key, 7);
             }
-            prev_cmd = midi_event[0];
+            self->priv->prev_cmd = midi_event[0];
           }
           break;
         case MIDI_PITCH_WHEEL_CHANGE:
@@ -284,7 +285,7 @@ io_handler (GIOChannel * channel, GIOCondition condition, gpointer user_data)
             } else if (G_UNLIKELY (self->priv->learn_mode)) {
               update_learn_info (self, "pitch-wheel-change", key, 14);
             }
-            prev_cmd = midi_event[0];
+            self->priv->prev_cmd = midi_event[0];
           }
           break;
 #if 0
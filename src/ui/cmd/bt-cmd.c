@@ -38,6 +38,7 @@
 #define BT_CMD_C
 
 #include "bt-cmd.h"
+#include <signal.h>
 #include <string.h>
 #include <stdlib.h>
 #include <glib/gprintf.h>
@@ -65,6 +66,10 @@ main (gint argc, gchar ** argv)
   gboolean res = FALSE;
   gboolean arg_version = FALSE;
   gboolean arg_quiet = FALSE;
+  gint arg_jobs = 0;
+  gboolean arg_stems = FALSE;
+  gchar *arg_format = NULL;
+  BtSinkBinRecordFormat format = BT_SINK_BIN_RECORD_FORMAT_OGG_VORBIS;
   gchar *command = NULL, *input_file_name = NULL, *output_file_name = NULL;
   gint saved_argc = argc;
   BtCmdApplication *app;
@@ -79,6 +84,10 @@ main (gint argc, gchar ** argv)
   textdomain (GETTEXT_PACKAGE);
 #endif /* ENABLE_NLS */
 
+  // when encoding to a stream, let writes fail once the reader goes away,
+  // instead of getting killed
+  signal (SIGPIPE, SIG_IGN);
+
   bt_setup_for_local_install ();
 
   static GOptionEntry options[] = {
@@ -86,11 +95,18 @@ main (gint argc, gchar ** argv)
         N_("Print application version"), NULL},
     {"quiet", 'q', 0, G_OPTION_ARG_NONE, NULL, N_("Be quiet"), NULL},
     {"command", 'c', 0, G_OPTION_ARG_STRING, NULL, N_("Command name"),
-        "{info, play, convert, encode}"},
+        "{info, play, convert, encode, render-batch}"},
     {"input-file", 'i', 0, G_OPTION_ARG_FILENAME, NULL, N_("Input file name"),
         N_("<songfile>")},
     {"output-file", 'o', 0, G_OPTION_ARG_FILENAME, NULL, N_("Output file name"),
         N_("<songfile>")},
+    {"jobs", 'j', 0, G_OPTION_ARG_INT, NULL,
+        N_("Number of songs to render concurrently"), N_("<jobs>")},
+    {"stems", 's', 0, G_OPTION_ARG_NONE, NULL,
+        N_("Also record the output of each source when encoding"), NULL},
+    {"format", 'f', 0, G_OPTION_ARG_STRING, NULL,
+        N_("Audio format to encode to, instead of using the extension"),
+        "{ogg-vorbis, mp3, wav, ogg-flac, raw, mp4-aac, flac, ogg-opus}"},
     {NULL}
   };
   // setting this separately gets us from 76 to 10 instructions
@@ -99,6 +115,9 @@ main (gint argc, gchar ** argv)
   options[2].arg_data = &command;
   options[3].arg_data = &input_file_name;
   options[4].arg_data = &output_file_name;
+  options[5].arg_data = &arg_jobs;
+  options[6].arg_data = &arg_stems;
+  options[7].arg_data = &arg_format;
 
   // init libraries
   ctx = g_option_context_new (NULL);
@@ -132,6 +151,18 @@ main (gint argc, gchar ** argv)
 
   GST_DEBUG_CATEGORY_INIT (GST_CAT_DEFAULT, "bt-cmd", 0,
       "music production environment / command ui");
+  if (arg_format) {
+    GEnumClass *enum_class =
+        g_type_class_ref (BT_TYPE_SINK_BIN_RECORD_FORMAT);
+    GEnumValue *enum_value = g_enum_get_value_by_nick (enum_class, arg_format);
+
+    g_type_class_unref (enum_class);
+    if (!enum_value) {
+      g_printerr ("Unknown format: %s\n", arg_format);
+      goto Done;
+    }
+    format = enum_value->value;
+  }
   GST_INFO ("starting: command=\"%s\" input=\"%s\" output=\"%s\"", command,
       input_file_name, output_file_name);
 
@@ -142,6 +173,7 @@ main (gint argc, gchar ** argv)
   g_setenv ("PULSE_PROP_media.role", "production", TRUE);
 
   app = bt_cmd_application_new (arg_quiet);
+  g_object_set (app, "stems", arg_stems, "format", arg_format, NULL);
 
 
   // set a default command, if a file is given
@@ -165,6 +197,11 @@ main (gint argc, gchar ** argv)
     if (!BT_IS_STRING (input_file_name) || !BT_IS_STRING (output_file_name))
       usage (argc, argv, ctx);
     res = bt_cmd_application_encode (app, input_file_name, output_file_name);
+  } else if (!strcmp (command, "b") || !strcmp (command, "render-batch")) {
+    if (!BT_IS_STRING (input_file_name) || !BT_IS_STRING (output_file_name))
+      usage (argc, argv, ctx);
+    res = bt_cmd_application_render_batch (app, input_file_name,
+        output_file_name, format, (guint) MAX (arg_jobs, 0));
   } else
     usage (argc, argv, ctx);
 
@@ -175,6 +212,7 @@ Done:
   g_free (command);
   g_free (input_file_name);
   g_free (output_file_name);
+  g_free (arg_format);
   g_option_context_free (ctx);
 
   return !res;
@@ -30,6 +30,8 @@
 #define BT_CMD_APPLICATION_C
 
 #include "bt-cmd.h"
+#include <errno.h>
+#include <string.h>
 #include <glib/gprintf.h>
 
 // this needs to be here because of gtk-doc and unit-tests
@@ -41,7 +43,9 @@ GST_DEBUG_CATEGORY (GST_CAT_DEFAULT);
 
 enum
 {
-  CMD_APP_QUIET = 1
+  CMD_APP_QUIET = 1,
+  CMD_APP_STEMS,
+  CMD_APP_FORMAT
 };
 
 struct _BtCmdApplicationPrivate
@@ -52,20 +56,33 @@ struct _BtCmdApplicationPrivate
   /* no output on stdout */
   gboolean quiet;
 
+  /* also record the output of each source machine when encoding */
+  gboolean stems;
+
+  /* nick of the record format or NULL to use the file-name extension */
+  gchar *format;
+
   /* error flag from bus handler */
   gboolean has_error;
 
   /* runtime data */
   const BtSong *song;
   gboolean res;
-
-  /* main loop */
+  /* render without a clock, as fast as the encoders accept data */
+  gboolean offline;
+  /* song duration and wall clock time of the last offline render */
+  GstClockTime song_time;
+  gint64 render_time;
+
+  /* playback status */
+  gboolean wait_for_is_playing_notify;
+  gboolean is_playing;
+
+  /* main loop, runs on the thread-default context of the creating thread */
+  GMainContext *ctx;
   GMainLoop *loop;
 };
 
-static gboolean wait_for_is_playing_notify = FALSE;
-static gboolean is_playing = FALSE;
-
 //-- the class
 
 G_DEFINE_TYPE_WITH_CODE (BtCmdApplication, bt_cmd_application, BT_TYPE_APPLICATION, 
@@ -82,10 +99,19 @@ static void
 on_song_is_playing_notify (const BtSong * song, GParamSpec * arg,
     gpointer user_data)
 {
-  g_object_get ((gpointer) song, "is-playing", &is_playing, NULL);
-  wait_for_is_playing_notify = FALSE;
+  BtCmdApplication *self = BT_CMD_APPLICATION (user_data);
+
+  g_object_get ((gpointer) song, "is-playing", &self->priv->is_playing, NULL);
+  self->priv->wait_for_is_playing_notify = FALSE;
   GST_INFO ("%s playing - invoked per signal : song=%p, user_data=%p",
-      (is_playing ? "started" : "stopped"), song, user_data);
+      (self->priv->is_playing ? "started" : "stopped"), song, user_data);
+}
+
+static gboolean
+on_song_progress_timeout (gpointer user_data)
+{
+  // just wakes up the main loop to update the playback position
+  return G_SOURCE_CONTINUE;
 }
 
 static void
@@ -146,6 +172,8 @@ bt_cmd_application_idle_play_song (const BtCmdApplication * self)
   BtSongInfo *song_info;
   gulong cmsec, csec, cmin, tmsec, tsec, tmin;
   gulong length, pos = 0, last_pos = 0;
+  gint64 start_ts, render_time;
+  GSource *progress;
 
   // DEBUG
   //bt_song_write_to_highlevel_dot_file(song);
@@ -159,24 +187,28 @@ bt_cmd_application_idle_play_song (const BtCmdApplication * self)
   bt_song_info_tick_to_m_s_ms (song_info, length, &tmin, &tsec, &tmsec);
 
   // connection play and stop signals
-  wait_for_is_playing_notify = TRUE;
+  self->priv->wait_for_is_playing_notify = TRUE;
   g_signal_connect ((gpointer) song, "notify::is-playing",
       G_CALLBACK (on_song_is_playing_notify), (gpointer) self);
   if (bt_song_play (song)) {
-    GST_INFO ("playing is starting, is_playing=%d", is_playing);
+    GST_INFO ("playing is starting, is_playing=%d", self->priv->is_playing);
     /* FIXME(ensonic): this is a bad idea, now that we have a main loop
      * - we should start a g_timeout_add() from on_song_is_playing_notify() and quit
      *   the main-loop there on eos / pos>length
      * - the problem with the timeout is that fast machines will overrun the length
      *   quite a bit when rendering
      */
-    while (wait_for_is_playing_notify) {
-      while (g_main_context_pending (NULL))
-        g_main_context_iteration (NULL, FALSE);
-      g_usleep (G_USEC_PER_SEC / 10);
+    // block until the bus message that starts the playback
+    while (self->priv->wait_for_is_playing_notify && !self->priv->has_error) {
+      g_main_context_iteration (self->priv->ctx, TRUE);
     }
-    GST_INFO ("playing has started, is_playing=%d", is_playing);
-    while (is_playing && (pos < length) && !self->priv->has_error) {
+    GST_INFO ("playing has started, is_playing=%d", self->priv->is_playing);
+    start_ts = g_get_monotonic_time ();
+    progress = g_timeout_source_new (100);
+    g_source_set_callback (progress, on_song_progress_timeout, NULL, NULL);
+    g_source_attach (progress, self->priv->ctx);
+    while (self->priv->is_playing && (pos < length)
+        && !self->priv->has_error) {
       if (!bt_song_update_playback_position (song)) {
         break;
       }
@@ -192,20 +224,36 @@ bt_cmd_application_idle_play_song (const BtCmdApplication * self)
         }
         last_pos = pos;
       }
-      while (g_main_context_pending (NULL))
-        g_main_context_iteration (NULL, FALSE);
+      // block until the next bus message or progress update
+      g_main_context_iteration (self->priv->ctx, TRUE);
     }
+    g_source_destroy (progress);
+    g_source_unref (progress);
+    render_time = g_get_monotonic_time () - start_ts;
     bt_song_stop (song);
     GST_INFO ("finished playing: is_playing=%d, pos=%lu < length=%lu",
-        is_playing, pos, length);
+        self->priv->is_playing, pos, length);
     if (!self->priv->quiet)
       puts ("");
+    if (self->priv->offline && render_time > 0) {
+      GstClockTime song_time = bt_song_info_tick_to_time (song_info, pos);
+      gdouble speed = (gdouble) (song_time / GST_USECOND) / render_time;
+
+      self->priv->song_time = song_time;
+      self->priv->render_time = render_time;
+      GST_INFO ("rendered %" GST_TIME_FORMAT " in %" G_GINT64_FORMAT
+          " usec, speed=%.2lf", GST_TIME_ARGS (song_time), render_time, speed);
+      if (!self->priv->quiet) {
+        printf ("rendered in %.3lf s, %.2lfx realtime\n",
+            (gdouble) render_time / G_USEC_PER_SEC, speed);
+      }
+    }
     res = TRUE;
   } else {
     GST_ERROR ("could not play song");
     goto Error;
   }
-  is_playing = FALSE;
+  self->priv->is_playing = FALSE;
 Error:
   self->priv->res = res;
   g_main_loop_quit (self->priv->loop);
@@ -217,14 +265,75 @@ static gboolean
 bt_cmd_application_play_song (const BtCmdApplication * self,
     const BtSong * song)
 {
+  GSource *source = g_idle_source_new ();
+
   self->priv->song = song;
 
-  g_idle_add ((GSourceFunc) bt_cmd_application_idle_play_song, (gpointer) self);
+  g_source_set_callback (source,
+      (GSourceFunc) bt_cmd_application_idle_play_song, (gpointer) self, NULL);
+  g_source_attach (source, self->priv->ctx);
+  g_source_unref (source);
   g_main_loop_run (self->priv->loop);
 
   return self->priv->res;
 }
 
+/*
+ * bt_cmd_application_set_offline:
+ *
+ * Disable clocking on the pipeline, so that the song is rendered as fast as the
+ * machines and encoders can process it. Restore the automatic clock selection
+ * when @offline is %FALSE.
+ */
+static void
+bt_cmd_application_set_offline (const BtCmdApplication * self,
+    gboolean offline)
+{
+  GstPipeline *bin;
+
+  g_object_get ((gpointer) self, "bin", &bin, NULL);
+  if (offline) {
+    gst_pipeline_use_clock (bin, NULL);
+  } else {
+    gst_pipeline_auto_clock (bin);
+  }
+  self->priv->offline = offline;
+  gst_object_unref (bin);
+}
+
+/*
+ * bt_cmd_application_prepare_stems:
+ *
+ * record the output of each connected source machine next to the mix
+ */
+static void
+bt_cmd_application_prepare_stems (const BtCmdApplication * self,
+    BtSetup * setup, BtSinkBinRecordFormat format, const gchar * base_name)
+{
+  GEnumClass *enum_class =
+      g_type_class_peek_static (BT_TYPE_SINK_BIN_RECORD_FORMAT);
+  GEnumValue *enum_value = g_enum_get_value (enum_class, format);
+  GList *node, *list =
+      bt_setup_get_machines_by_type (setup, BT_TYPE_SOURCE_MACHINE);
+  gchar *id, *file_name;
+
+  for (node = list; node; node = g_list_next (node)) {
+    // an unconnected machine is not part of the mix
+    if (!BT_MACHINE (node->data)->src_wires)
+      continue;
+    g_object_get (node->data, "id", &id, NULL);
+    g_strdelimit (id, G_DIR_SEPARATOR_S, '_');
+    file_name = g_strdup_printf ("%s.%s%s", base_name, id,
+        enum_value->value_name);
+    if (!bt_machine_enable_stem (BT_MACHINE (node->data), format, file_name)) {
+      GST_WARNING ("failed to record stem to '%s'", file_name);
+    }
+    g_free (file_name);
+    g_free (id);
+  }
+  g_list_free (list);
+}
+
 /*
  * bt_cmd_application_prepare_encoding:
  *
@@ -238,17 +347,28 @@ bt_cmd_application_prepare_encoding (const BtCmdApplication * self,
   BtSetup *setup;
   BtMachine *machine;
   BtSinkBinRecordFormat format;
-  gchar *lc_file_name, *file_name = NULL;
+  gchar *lc_file_name, *file_name = NULL, *base_name;
   GEnumClass *enum_class;
   GEnumValue *enum_value;
   guint i;
   gboolean matched = FALSE;
+  gboolean is_stream = (bt_sink_bin_get_record_fd (output_file_name) != -1);
 
   g_object_get ((gpointer) song, "setup", &setup, NULL);
 
   lc_file_name = g_ascii_strdown (output_file_name, -1);
 
   enum_class = g_type_class_peek_static (BT_TYPE_SINK_BIN_RECORD_FORMAT);
+  // an explicit format takes precedence over the file-name extension
+  if (self->priv->format) {
+    if ((enum_value =
+            g_enum_get_value_by_nick (enum_class, self->priv->format))) {
+      format = enum_value->value;
+      matched = TRUE;
+    } else {
+      GST_WARNING ("unknown format \"%s\"", self->priv->format);
+    }
+  }
   for (i = enum_class->minimum; (!matched && i <= enum_class->maximum); i++) {
     if ((enum_value = g_enum_get_value (enum_class, i))) {
       if (g_str_has_suffix (lc_file_name, enum_value->value_name)) {
@@ -261,10 +381,26 @@ bt_cmd_application_prepare_encoding (const BtCmdApplication * self,
     GST_WARNING ("unknown file-format extension, using ogg vorbis");
     format = BT_SINK_BIN_RECORD_FORMAT_OGG_VORBIS;
     enum_value = g_enum_get_value (enum_class, format);
-    file_name = g_strdup_printf ("%s%s", output_file_name,
-        enum_value->value_name);
+    // streams have no name that could get an extension
+    if (!is_stream) {
+      file_name = g_strdup_printf ("%s%s", output_file_name,
+          enum_value->value_name);
+    }
+  }
+  if (g_str_has_suffix (lc_file_name, enum_value->value_name)) {
+    base_name = g_strndup (output_file_name,
+        strlen (output_file_name) - strlen (enum_value->value_name));
+  } else {
+    base_name = g_strdup (output_file_name);
   }
   g_free (lc_file_name);
+  if (is_stream && !bt_sink_bin_is_record_format_streamable (format)) {
+    g_fprintf (stderr, "the format \"%s\" can't be streamed, "
+        "please write to a file instead\n", enum_value->value_nick);
+    g_free (base_name);
+    g_object_unref (setup);
+    return FALSE;
+  }
 
   // lookup the audio-sink machine and change mode
   if ((machine = bt_setup_get_machine_by_type (setup, BT_TYPE_SINK_MACHINE))) {
@@ -285,6 +421,14 @@ bt_cmd_application_prepare_encoding (const BtCmdApplication * self,
     /* see comments in edit/render-progress.c */
     g_object_set (convert, "dithering", 2, "noise-shaping", 3, NULL);
 
+    if (self->priv->stems) {
+      if (!is_stream) {
+        bt_cmd_application_prepare_stems (self, setup, format, base_name);
+      } else {
+        GST_WARNING ("can't record stems when streaming");
+      }
+    }
+
     ret = !self->priv->has_error;
 
     g_free (file_name);
@@ -292,10 +436,146 @@ bt_cmd_application_prepare_encoding (const BtCmdApplication * self,
     gst_object_unref (sink_bin);
     g_object_unref (machine);
   }
+  g_free (base_name);
   g_object_unref (setup);
   return ret;
 }
 
+/*
+ * bt_cmd_application_is_song_file:
+ *
+ * check if there is a song-io plugin for the file-name extension
+ */
+static gboolean
+bt_cmd_application_is_song_file (const gchar * file_name)
+{
+  const GList *node;
+  const gchar *ext = strrchr (file_name, '.');
+  guint i;
+
+  if (!ext)
+    return FALSE;
+
+  for (node = bt_song_io_get_module_info_list (); node;
+      node = g_list_next (node)) {
+    BtSongIOModuleInfo *info = (BtSongIOModuleInfo *) node->data;
+
+    for (i = 0; info->formats[i].type; i++) {
+      if (info->formats[i].extension &&
+          !g_ascii_strcasecmp (&ext[1], info->formats[i].extension)) {
+        return TRUE;
+      }
+    }
+  }
+  return FALSE;
+}
+
+/*
+ * bt_cmd_application_get_batch_songs:
+ *
+ * Collect the songs to render. @input_name is either a directory that is
+ * scanned for song files or a text file that lists one song per line.
+ */
+static GList *
+bt_cmd_application_get_batch_songs (const gchar * input_name)
+{
+  GList *songs = NULL;
+
+  if (g_file_test (input_name, G_FILE_TEST_IS_DIR)) {
+    GDir *dir;
+    const gchar *name;
+
+    if (!(dir = g_dir_open (input_name, 0, NULL))) {
+      GST_WARNING ("can't open directory '%s'", input_name);
+      return NULL;
+    }
+    while ((name = g_dir_read_name (dir))) {
+      gchar *path = g_build_filename (input_name, name, NULL);
+
+      if (g_file_test (path, G_FILE_TEST_IS_REGULAR) &&
+          bt_cmd_application_is_song_file (path)) {
+        songs = g_list_prepend (songs, path);
+      } else {
+        g_free (path);
+      }
+    }
+    g_dir_close (dir);
+    songs = g_list_sort (songs, (GCompareFunc) strcmp);
+  } else {
+    gchar *contents, **lines;
+    guint i;
+
+    if (!g_file_get_contents (input_name, &contents, NULL, NULL)) {
+      GST_WARNING ("can't read song list '%s'", input_name);
+      return NULL;
+    }
+    lines = g_strsplit (contents, "\n", -1);
+    for (i = 0; lines[i]; i++) {
+      gchar *line = g_strstrip (lines[i]);
+
+      if (*line && *line != '#') {
+        songs = g_list_append (songs, g_strdup (line));
+      }
+    }
+    g_strfreev (lines);
+    g_free (contents);
+  }
+  return songs;
+}
+
+/*
+ * BtCmdRenderJob:
+ *
+ * one song of a batch render
+ */
+typedef struct
+{
+  gchar *input_file_name;
+  gchar *output_file_name;
+  gboolean res;
+  gint64 total_time;
+  gint64 render_time;
+  GstClockTime song_time;
+} BtCmdRenderJob;
+
+/*
+ * bt_cmd_application_render_job:
+ *
+ * Worker function for the batch renderer. Each job runs with an own
+ * application instance and thus an own pipeline and bus, that is driven from a
+ * main context private to the worker thread.
+ */
+static void
+bt_cmd_application_render_job (BtCmdRenderJob * job, gpointer user_data)
+{
+  GMainContext *ctx = g_main_context_new ();
+  BtCmdApplication *app;
+  gint64 start_ts = g_get_monotonic_time ();
+
+  g_main_context_push_thread_default (ctx);
+
+  GST_INFO ("rendering %s", job->input_file_name);
+  app = bt_cmd_application_new (TRUE);
+  job->res = bt_cmd_application_encode (app, job->input_file_name,
+      job->output_file_name);
+  job->render_time = app->priv->render_time;
+  job->song_time = app->priv->song_time;
+  g_object_unref (app);
+
+  g_main_context_pop_thread_default (ctx);
+  g_main_context_unref (ctx);
+  job->total_time = g_get_monotonic_time () - start_ts;
+  GST_INFO ("rendered %s: %d", job->input_file_name, job->res);
+}
+
+static void
+bt_cmd_application_render_job_free (BtCmdRenderJob * job)
+{
+  g_free (job->input_file_name);
+  g_free (job->output_file_name);
+  g_slice_free (BtCmdRenderJob, job);
+}
+
 //-- constructor methods
 
 /**
@@ -608,7 +888,14 @@ Error:
  *
  * Load the file of the supplied name and encode it as an audio file.
  * The type of the output file is automatically determined from the filename
- * extension.
+ * extension, unless the "format" property is set. The song is rendered offline,
+ * i.e. without syncing to a clock and thus as fast as the machines and the
+ * encoder can process the data.
+ *
+ * Use "-" as the @output_file_name to stream the audio to stdout or "fd:N" to
+ * stream it to the open file descriptor N. The rendering then runs as fast as
+ * the reader consumes the data. Formats that need to seek back when finishing
+ * the file (e.g. mp4) can't be streamed.
  *
  * Returns: %TRUE for success
  */
@@ -619,6 +906,8 @@ bt_cmd_application_encode (const BtCmdApplication * self,
   gboolean res = FALSE;
   BtSong *song = NULL;
   BtSongIO *loader = NULL;
+  gboolean quiet = self->priv->quiet;
+  gint fd;
 
   g_return_val_if_fail (BT_IS_CMD_APPLICATION (self), FALSE);
   g_return_val_if_fail (BT_IS_STRING (input_file_name), FALSE);
@@ -626,6 +915,12 @@ bt_cmd_application_encode (const BtCmdApplication * self,
 
   GST_INFO ("application.play launched");
 
+  if ((fd = bt_sink_bin_get_record_fd (output_file_name)) != -1) {
+    // the progress output would end up in the stream
+    if (fd == 1)
+      self->priv->quiet = TRUE;
+  }
+
   // prepare song and song-io
   song = bt_cmd_application_song_init (self);
   if (!(loader = bt_song_io_from_file (input_file_name, NULL))) {
@@ -637,9 +932,10 @@ bt_cmd_application_encode (const BtCmdApplication * self,
   if (bt_song_io_load (loader, song, NULL)) {
     if (bt_cmd_application_prepare_encoding (self, song, output_file_name)) {
       GST_INFO ("start encoding");
-      if (bt_cmd_application_play_song (self, song)) {
-        res = TRUE;
-      } else {
+      bt_cmd_application_set_offline (self, TRUE);
+      res = bt_cmd_application_play_song (self, song);
+      bt_cmd_application_set_offline (self, FALSE);
+      if (!res) {
         GST_ERROR ("could not play song \"%s\"", input_file_name);
         goto Error;
       }
@@ -652,11 +948,148 @@ bt_cmd_application_encode (const BtCmdApplication * self,
     goto Error;
   }
 Error:
+  self->priv->quiet = quiet;
   g_object_try_unref (song);
   g_object_try_unref (loader);
   return res;
 }
 
+/**
+ * bt_cmd_application_render_batch:
+ * @self: the application instance to run
+ * @input_name: a directory with songs or a text file listing one song per line
+ * @output_dir_name: the directory to write the audio files to
+ * @format: the audio format to encode to
+ * @n_jobs: the number of songs to render concurrently, 0 to use one job per
+ * cpu core
+ *
+ * Render many songs in one process. The songs are rendered offline on a pool of
+ * worker threads. Each song uses its own pipeline, so that songs don't affect
+ * each other. Plugins are only registered once and shared by all workers.
+ * The audio files are named after the songs. If several songs have the same
+ * name, a counter is appended to the later ones, e.g. "song-1.wav".
+ * Unless the application is quiet, a summary with the timing of each song is
+ * printed at the end.
+ *
+ * Returns: %TRUE if all songs have been rendered
+ *
+ * Since: 0.12
+ */
+gboolean
+bt_cmd_application_render_batch (const BtCmdApplication * self,
+    const gchar * input_name, const gchar * output_dir_name,
+    BtSinkBinRecordFormat format, guint n_jobs)
+{
+  gboolean res = TRUE;
+  GList *songs, *node, *jobs = NULL;
+  GHashTable *file_names;
+  GThreadPool *pool;
+  GEnumClass *enum_class;
+  GEnumValue *enum_value;
+  GError *err = NULL;
+  gint64 start_ts;
+  guint n_failed = 0;
+
+  g_return_val_if_fail (BT_IS_CMD_APPLICATION (self), FALSE);
+  g_return_val_if_fail (BT_IS_STRING (input_name), FALSE);
+  g_return_val_if_fail (BT_IS_STRING (output_dir_name), FALSE);
+
+  if (!(songs = bt_cmd_application_get_batch_songs (input_name))) {
+    g_fprintf (stderr, "no songs found in \"%s\"\n", input_name);
+    return FALSE;
+  }
+  if (g_mkdir_with_parents (output_dir_name, 0755) == -1) {
+    g_fprintf (stderr, "cannot create output directory \"%s\": %s\n",
+        output_dir_name, g_strerror (errno));
+    g_list_free_full (songs, g_free);
+    return FALSE;
+  }
+  if (!n_jobs) {
+    n_jobs = g_get_num_processors ();
+  }
+  // register the song-io plugins before the workers look them up
+  bt_song_io_get_module_info_list ();
+
+  enum_class = g_type_class_ref (BT_TYPE_SINK_BIN_RECORD_FORMAT);
+  enum_value = g_enum_get_value (enum_class, format);
+
+  GST_INFO ("rendering %u songs with %u jobs", g_list_length (songs), n_jobs);
+  start_ts = g_get_monotonic_time ();
+  pool = g_thread_pool_new ((GFunc) bt_cmd_application_render_job, NULL,
+      n_jobs, TRUE, &err);
+  if (!pool) {
+    g_fprintf (stderr, "cannot create worker pool: %s\n", err->message);
+    g_error_free (err);
+    g_type_class_unref (enum_class);
+    g_list_free_full (songs, g_free);
+    return FALSE;
+  }
+  file_names = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, NULL);
+  for (node = songs; node; node = g_list_next (node)) {
+    BtCmdRenderJob *job = g_slice_new0 (BtCmdRenderJob);
+    gchar *base_name = g_path_get_basename ((gchar *) node->data);
+    gchar *ext = strrchr (base_name, '.');
+    gchar *file_name;
+    guint i = 0;
+
+    if (ext)
+      *ext = '\0';
+    file_name = g_strconcat (base_name, enum_value->value_name, NULL);
+    // songs from different directories can have the same name
+    while (g_hash_table_contains (file_names, file_name)) {
+      g_free (file_name);
+      file_name = g_strdup_printf ("%s-%u%s", base_name, ++i,
+          enum_value->value_name);
+    }
+    g_hash_table_add (file_names, file_name);
+    job->input_file_name = (gchar *) node->data;
+    job->output_file_name =
+        g_build_filename (output_dir_name, file_name, NULL);
+    g_free (base_name);
+
+    jobs = g_list_append (jobs, job);
+    g_thread_pool_push (pool, job, NULL);
+  }
+  g_hash_table_destroy (file_names);
+  // wait for all jobs to finish
+  g_thread_pool_free (pool, FALSE, TRUE);
+
+  for (node = jobs; node; node = g_list_next (node)) {
+    BtCmdRenderJob *job = (BtCmdRenderJob *) node->data;
+
+    if (!job->res) {
+      n_failed++;
+      res = FALSE;
+    }
+  }
+  if (!self->priv->quiet) {
+    printf ("%-40s %10s %10s %8s\n", "song", "length", "time", "speed");
+    for (node = jobs; node; node = g_list_next (node)) {
+      BtCmdRenderJob *job = (BtCmdRenderJob *) node->data;
+      gchar *base_name = g_path_get_basename (job->input_file_name);
+
+      if (job->res && job->render_time > 0) {
+        printf ("%-40s %10.3lf %10.3lf %7.2lfx\n", base_name,
+            (gdouble) job->song_time / GST_SECOND,
+            (gdouble) job->total_time / G_USEC_PER_SEC,
+            (gdouble) (job->song_time / GST_USECOND) / job->render_time);
+      } else {
+        printf ("%-40s %10s %10.3lf %8s\n", base_name, "-",
+            (gdouble) job->total_time / G_USEC_PER_SEC, "failed");
+      }
+      g_free (base_name);
+    }
+    printf ("rendered %u of %u songs in %.3lf s\n",
+        g_list_length (jobs) - n_failed, g_list_length (jobs),
+        (gdouble) (g_get_monotonic_time () - start_ts) / G_USEC_PER_SEC);
+  }
+
+  g_list_free_full (jobs, (GDestroyNotify) bt_cmd_application_render_job_free);
+  g_list_free (songs);
+  g_type_class_unref (enum_class);
+  return res;
+}
+
 //-- wrapper
 
 //-- class internals
@@ -671,6 +1104,13 @@ bt_cmd_application_set_property (GObject * object, guint property_id,
     case CMD_APP_QUIET:
       self->priv->quiet = g_value_get_boolean (value);
       break;
+    case CMD_APP_STEMS:
+      self->priv->stems = g_value_get_boolean (value);
+      break;
+    case CMD_APP_FORMAT:
+      g_free (self->priv->format);
+      self->priv->format = g_value_dup_string (value);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, property_id, pspec);
       break;
@@ -702,6 +1142,8 @@ bt_cmd_application_finalize (GObject * object)
   //g_main_loop_quit(self->priv->loop);
 #endif
   g_main_loop_unref (self->priv->loop);
+  g_main_context_unref (self->priv->ctx);
+  g_free (self->priv->format);
 
   G_OBJECT_CLASS (bt_cmd_application_parent_class)->finalize (object);
 }
@@ -712,7 +1154,8 @@ bt_cmd_application_init (BtCmdApplication * self)
   GST_DEBUG ("!!!! self=%p", self);
   self->priv = bt_cmd_application_get_instance_private(self);
 
-  self->priv->loop = g_main_loop_new (NULL, FALSE);
+  self->priv->ctx = g_main_context_ref_thread_default ();
+  self->priv->loop = g_main_loop_new (self->priv->ctx, FALSE);
 #if THREADED_MAIN
   //self->priv->loop_thread=g_thread_create((GThreadFunc)g_main_loop_run,self->priv->loop,FALSE,NULL);
 #endif
@@ -734,4 +1177,15 @@ bt_cmd_application_class_init (BtCmdApplicationClass * klass)
           "tell wheter the app should do output or not",
           FALSE, G_PARAM_WRITABLE | G_PARAM_STATIC_STRINGS));
 
+  g_object_class_install_property (gobject_class, CMD_APP_STEMS,
+      g_param_spec_boolean ("stems",
+          "stems prop",
+          "also record the output of each source machine when encoding",
+          FALSE, G_PARAM_WRITABLE | G_PARAM_STATIC_STRINGS));
+
+  g_object_class_install_property (gobject_class, CMD_APP_FORMAT,
+      g_param_spec_string ("format",
+          "format prop",
+          "nick of the record format, overrides the file-name extension",
+          NULL, G_PARAM_WRITABLE | G_PARAM_STATIC_STRINGS));
 }
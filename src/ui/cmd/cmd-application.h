@@ -59,5 +59,6 @@ gboolean bt_cmd_application_play(const BtCmdApplication *self, const gchar *inpu
 gboolean bt_cmd_application_info(const BtCmdApplication *self, const gchar *input_file_name, const gchar *output_file_name);
 gboolean bt_cmd_application_convert(const BtCmdApplication *self, const gchar *input_file_name, const gchar *output_file_name);
 gboolean bt_cmd_application_encode(const BtCmdApplication *self, const gchar *input_file_name, const gchar *output_file_name);
+gboolean bt_cmd_application_render_batch(const BtCmdApplication *self, const gchar *input_name, const gchar *output_dir_name, BtSinkBinRecordFormat format, guint n_jobs);
 
 #endif // BT_CMD_APPLICATION_H
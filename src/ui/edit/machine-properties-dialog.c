@@ -634,8 +634,10 @@ on_button_press_event (GtkWidget * widget, GdkEventButton * event,
     if (event->button == GDK_BUTTON_SECONDARY) {
       GObject *m;
       BtParameterGroup *pg = g_object_get_qdata (w, widget_param_group_quark);
-      gint pi =
-          GPOINTER_TO_INT (g_object_get_qdata (w, widget_param_num_quark));
+      /* not all widgets have the param num set (e.g. the event boxes), but
+       * they are all named after the parameter */
+      glong pi = pg ? bt_parameter_group_get_param_index (pg,
+          property_name) : -1;
       gint ix = (type << 1) | add_copy_paste;
 
       // create context menu
@@ -686,7 +688,7 @@ on_button_press_event (GtkWidget * widget, GdkEventButton * event,
       }
       m = (GObject *) self->priv->param_menu[ix];
       g_object_set_qdata (m, widget_param_group_quark, (gpointer) pg);
-      g_object_set_qdata (m, widget_param_num_quark, GINT_TO_POINTER (pi));
+      g_object_set_qdata (m, widget_param_num_quark, GINT_TO_POINTER ((gint) pi));
 
       g_object_set (m, "selected-object", param_parent,
           "selected-parameter-group", pg, "selected-property-name",
@@ -696,8 +698,17 @@ on_button_press_event (GtkWidget * widget, GdkEventButton * event,
       gtk_menu_attach_to_widget (GTK_MENU (m), widget, NULL);
       res = TRUE;
     } else if (event->button == GDK_BUTTON_PRIMARY) {
-      gst_object_set_control_binding_disabled (param_parent, property_name,
-          TRUE);
+      BtParameterGroup *pg = g_object_get_qdata (w, widget_param_group_quark);
+      glong pi = pg ? bt_parameter_group_get_param_index (pg,
+          property_name) : -1;
+      GstControlBinding *cb;
+
+      /* on_button_release_event() looks the binding up by name too and
+       * re-enables it */
+      if (pi != -1
+          && (cb = bt_parameter_group_get_param_control_binding (pg, pi))) {
+        gst_control_binding_set_disabled (cb, TRUE);
+      }
       // keep res = FALSE to let the original handler run
     }
   }
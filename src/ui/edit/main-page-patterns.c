@@ -3508,6 +3508,8 @@ pattern_clipboard_received_func (GtkClipboard * clipboard,
     g = self->priv->cursor_group;
     p = self->priv->cursor_param;
     pc_group = &self->priv->param_groups[g];
+    // send one change notify per group
+    bt_value_group_begin_batch (pc_group->vg);
     // process each line (= pattern column)
     while (lines[i] && *lines[i] && res) {
       if (*lines[i] != '\n') {
@@ -3521,15 +3523,18 @@ pattern_clipboard_received_func (GtkClipboard * clipboard,
       p++;
       if (p == pc_group->num_columns) {
         // switch to next group or stop
-        if (g < self->priv->number_of_groups) {
+        if (g + 1 < self->priv->number_of_groups) {
+          bt_value_group_end_batch (pc_group->vg);
           g++;
           p = 0;
           pc_group = &self->priv->param_groups[g];
+          bt_value_group_begin_batch (pc_group->vg);
         } else {
           break;
         }
       }
     }
+    bt_value_group_end_batch (pc_group->vg);
     gtk_widget_queue_draw (GTK_WIDGET (self->priv->pattern_table));
   }
   g_strfreev (lines);
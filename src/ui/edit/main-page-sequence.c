@@ -1168,7 +1168,13 @@ on_sequence_label_edited (GtkCellRendererText * cellrenderertext,
 
         if (pos >= old_length) {
           new_length = pos + self->priv->bars;
-          bt_sequence_resize_data_length (self->priv->sequence, new_length);
+          if (!bt_sequence_resize_data_length (self->priv->sequence,
+                  new_length)) {
+            GST_WARNING ("can't extend the sequence to %lu rows", new_length);
+            bt_change_log_end_group (self->priv->change_log);
+            g_free (old_text);
+            return;
+          }
           sequence_calculate_visible_lines (self);
           sequence_update_model_length (self);
 
@@ -3002,12 +3008,19 @@ on_sequence_table_key_press_event (GtkWidget * widget, GdkEventKey * event,
 
           if (row >= length) {
             new_length = row + self->priv->bars;
-            bt_sequence_resize_data_length (self->priv->sequence, new_length);
-            sequence_calculate_visible_lines (self);
-            sequence_update_model_length (self);
+            if (bt_sequence_resize_data_length (self->priv->sequence,
+                    new_length)) {
+              sequence_calculate_visible_lines (self);
+              sequence_update_model_length (self);
+            } else {
+              GST_WARNING ("can't extend the sequence to %lu rows",
+                  new_length);
+              new_length = 0;
+            }
           }
 
-          if ((res = change_pattern (self, new_pattern, row, track - 1))) {
+          if ((row < length || new_length)
+              && (res = change_pattern (self, new_pattern, row, track - 1))) {
             change = TRUE;
             res = TRUE;
           }
@@ -4327,8 +4340,12 @@ sequence_clipboard_received_func (GtkClipboard * clipboard,
     beg = self->priv->cursor_row;
     end = beg + ticks;
 
-    if (end > sequence_length)
-      bt_sequence_resize_data_length (self->priv->sequence, end);
+    if (end > sequence_length
+        && !bt_sequence_resize_data_length (self->priv->sequence, end)) {
+      GST_WARNING ("can't extend the sequence to %d rows", end);
+      g_strfreev (lines);
+      return;
+    }
     
     GST_INFO ("pasting from row %d to %d", beg, end);
 
@@ -614,11 +614,15 @@ on_song_volume_slider_press_event (GtkWidget * widget, GdkEventButton * event,
   if (event->type == GDK_BUTTON_PRESS) {
     if (event->button == GDK_BUTTON_PRIMARY) {
       BtMainToolbar *self = BT_MAIN_TOOLBAR (user_data);
-      GstObject *machine;
+      BtParameterGroup *pg =
+          bt_machine_get_global_param_group (self->priv->master);
+      glong param = bt_parameter_group_get_param_index (pg, "master-volume");
+      GstControlBinding *cb;
 
-      g_object_get (self->priv->master, "machine", &machine, NULL);
-      gst_object_set_control_binding_disabled (machine, "master-volume", TRUE);
-      g_object_unref (machine);
+      if (G_LIKELY (param != -1) &&
+          (cb = bt_parameter_group_get_param_control_binding (pg, param))) {
+        gst_control_binding_set_disabled (cb, TRUE);
+      }
     }
   }
   return FALSE;
@@ -630,18 +634,15 @@ on_song_volume_slider_release_event (GtkWidget * widget, GdkEventButton * event,
 {
   if (event->button == GDK_BUTTON_PRIMARY && event->type == GDK_BUTTON_RELEASE) {
     BtMainToolbar *self = BT_MAIN_TOOLBAR (user_data);
-    GstObject *machine;
+    BtParameterGroup *pg =
+        bt_machine_get_global_param_group (self->priv->master);
+    glong param = bt_parameter_group_get_param_index (pg, "master-volume");
     GstControlBinding *cb;
 
-    g_object_get (self->priv->master, "machine", &machine, NULL);
-    if ((cb = gst_object_get_control_binding (machine, "master-volume"))) {
-      BtParameterGroup *pg =
-          bt_machine_get_global_param_group (self->priv->master);
-      glong param = bt_parameter_group_get_param_index (pg, "master-volume");
-      if (G_LIKELY (param != -1)) {
-        // update the default value at ts=0
-        bt_parameter_group_set_param_default (pg, param);
-      }
+    if (G_LIKELY (param != -1) &&
+        (cb = bt_parameter_group_get_param_control_binding (pg, param))) {
+      // update the default value at ts=0
+      bt_parameter_group_set_param_default (pg, param);
 
       /* TODO(ensonic): it should actualy postpone the enable to the next
        * timestamp.
@@ -652,9 +653,7 @@ on_song_volume_slider_release_event (GtkWidget * widget, GdkEventButton * event,
        * see gst_object_set_control_binding_disabled() on button_press
        */
       gst_control_binding_set_disabled (cb, FALSE);
-      gst_object_unref (cb);
     }
-    g_object_unref (machine);
   }
   return FALSE;
 }
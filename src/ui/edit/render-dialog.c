@@ -102,6 +102,8 @@ bt_render_mode_get_type (void)
           N_("mix to one track")},
       {BT_RENDER_MODE_SINGLE_TRACKS, "BT_RENDER_MODE_SINGLE_TRACKS",
           N_("record one track for each source")},
+      {BT_RENDER_MODE_STEMS, "BT_RENDER_MODE_STEMS",
+          N_("record the mix and each source in one pass")},
       {0, NULL, NULL},
     };
     type = g_enum_register_static ("BtRenderMode", values);
@@ -151,11 +153,12 @@ bt_render_dialog_make_file_name (const BtRenderDialog * self, gint track)
 {
   gchar *file_name =
       g_build_filename (self->priv->folder, self->priv->base_file_name, NULL);
-  gchar track_str[4];
+  gchar track_str[8];
   GEnumClass *enum_class;
   GEnumValue *enum_value;
 
-  if (self->priv->mode == BT_RENDER_MODE_SINGLE_TRACKS) {
+  if ((self->priv->mode == BT_RENDER_MODE_SINGLE_TRACKS) ||
+      ((self->priv->mode == BT_RENDER_MODE_STEMS) && (track >= 0))) {
     g_snprintf (track_str, sizeof(track_str), ".%03u", track);
   } else {
     track_str[0] = '\0';
@@ -249,6 +252,28 @@ bt_render_dialog_record_init (const BtRenderDialog * self)
   if (self->priv->mode == BT_RENDER_MODE_MIXDOWN) {
     self->priv->track = -1;
     self->priv->tracks = 0;
+  } else if (self->priv->mode == BT_RENDER_MODE_STEMS) {
+    GList *node;
+    gint track = 0;
+
+    // record all stems in the same pass as the mix
+    self->priv->track = -1;
+    self->priv->tracks = 0;
+    self->priv->list =
+        bt_setup_get_machines_by_type (setup, BT_TYPE_SOURCE_MACHINE);
+    for (node = self->priv->list; node; node = g_list_next (node)) {
+      gchar *file_name;
+
+      // an unconnected machine is not part of the mix
+      if (!BT_MACHINE (node->data)->src_wires)
+        continue;
+      file_name = bt_render_dialog_make_file_name (self, track++);
+      if (!bt_machine_enable_stem (BT_MACHINE (node->data),
+              self->priv->format, file_name)) {
+        GST_WARNING ("failed to record stem to '%s'", file_name);
+      }
+      g_free (file_name);
+    }
   } else {
     self->priv->list =
         bt_setup_get_machines_by_type (setup, BT_TYPE_SOURCE_MACHINE);
@@ -295,6 +320,9 @@ bt_render_dialog_record_done (const BtRenderDialog * self)
   g_object_unref (setup);
 
   if (self->priv->list) {
+    if (self->priv->mode == BT_RENDER_MODE_STEMS) {
+      g_list_foreach (self->priv->list, (GFunc) bt_machine_disable_stem, NULL);
+    }
     g_list_free (self->priv->list);
     self->priv->list = NULL;
   }
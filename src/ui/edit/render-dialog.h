@@ -57,12 +57,15 @@ struct _BtRenderDialogClass {
  * BtRenderMode:
  * @BT_RENDER_MODE_MIXDOWN: mix to one track
  * @BT_RENDER_MODE_SINGLE_TRACKS: record one track for each source
+ * @BT_RENDER_MODE_STEMS: record the mix and the output of each source in one
+ *   pass
  *
  * Different modes of operation for the #BtSong rendering.
  */
 typedef enum {
   BT_RENDER_MODE_MIXDOWN=0,
   BT_RENDER_MODE_SINGLE_TRACKS,
+  BT_RENDER_MODE_STEMS,
 } BtRenderMode;
 
 
@@ -1339,7 +1339,7 @@ check_plot_get_basename (const gchar * base, const gchar * name)
 }
 
 gint
-check_plot_data_int16 (gint16 * d, guint size, const gchar * base,
+check_plot_data_float (gfloat * d, guint size, const gchar * base,
     const gchar * name)
 {
   gint ret;
@@ -1348,12 +1348,12 @@ check_plot_data_int16 (gint16 * d, guint size, const gchar * base,
   gchar *cmd =
       g_strdup_printf
       ("/bin/sh -c \"echo \\\"set terminal svg size 200,160 fontscale 0.5;set output '%s.svg';"
-      "set yrange [-33000:32999];set grid xtics;set grid ytics;"
+      "set yrange [-1.01:1.01];set grid xtics;set grid ytics;"
       "set key outside below;"
-      "plot '%s.raw' binary format='%%int16' using 0:1 with lines title '%s'\\\" | gnuplot\"",
+      "plot '%s.raw' binary format='%%float32' using 0:1 with lines title '%s'\\\" | gnuplot\"",
       base_name, base_name, name);
 
-  check_write_raw_data (d, size * sizeof (gint16), base_name);
+  check_write_raw_data (d, size * sizeof (gfloat), base_name);
   ret = system (cmd);
 
   g_free (cmd);
@@ -362,7 +362,7 @@ gpointer check_gobject_get_ptr_property(gpointer obj, const gchar *prop);
 
 // plotting helper
 
-gint check_plot_data_int16 (gint16 * d, guint size, const gchar * base, const gchar * name);
+gint check_plot_data_float (gfloat * d, guint size, const gchar * base, const gchar * name);
 gint check_plot_data_double (gdouble * d, guint size, const gchar * base, const gchar * name, const gchar *cfg);
 
 #endif /* BT_CHECK_H */
@@ -16,6 +16,7 @@
  */
 
 #include "m-bt-core.h"
+#include <glib/gstdio.h>
 
 //-- globals
 
@@ -24,6 +25,26 @@ static BtSong *song;
 static BtIcRegistry *registry;
 static BtIcDevice *device;
 
+//-- helpers
+
+#if GST_CHECK_VERSION(1, 18, 0)
+static GstElement *
+get_machine_element_by_factory (BtMachine * machine, const gchar * name)
+{
+  GList *node, *list = bt_machine_get_element_list (machine);
+  GstElement *res = NULL;
+
+  for (node = list; node; node = g_list_next (node)) {
+    GstElementFactory *f = gst_element_get_factory (GST_ELEMENT (node->data));
+    if (f && !strcmp (GST_OBJECT_NAME (f), name)) {
+      res = GST_ELEMENT (node->data);
+    }
+  }
+  g_list_free (list);
+  return res;
+}
+#endif
+
 //-- fixtures
 
 static void
@@ -201,6 +222,61 @@ START_TEST (test_bt_machine_enable_output_gain1)
 }
 END_TEST
 
+/*
+ * record the output of a source machine next to the mix
+ */
+START_TEST (test_bt_machine_enable_stem)
+{
+  BT_TEST_START;
+  GST_INFO ("-- arrange --");
+  BtSong *render_song = bt_song_new (app);
+  BtSongIO *loader =
+      bt_song_io_from_file (check_get_test_song_path ("test-simple1.xml"),
+      NULL);
+  bt_song_io_load (loader, render_song, NULL);
+  ck_g_object_final_unref (loader);
+  BtSetup *setup =
+      BT_SETUP (check_gobject_get_object_property (render_song, "setup"));
+  BtMachine *machine = bt_setup_get_machine_by_id (setup, "sine1");
+  BtMachine *master = bt_setup_get_machine_by_id (setup, "audio_sink");
+  GstElement *sink_bin =
+      GST_ELEMENT (check_gobject_get_object_property (master, "machine"));
+  gchar *mix_name = g_build_filename (g_get_tmp_dir (), "bt-mix.raw", NULL);
+  gchar *stem_name = g_build_filename (g_get_tmp_dir (), "bt-stem.raw", NULL);
+  g_object_set (sink_bin, "mode", BT_SINK_BIN_MODE_RECORD,
+      "record-format", BT_SINK_BIN_RECORD_FORMAT_RAW,
+      "record-file-name", mix_name, NULL);
+
+  GST_INFO ("-- act --");
+  gboolean res = bt_machine_enable_stem (machine,
+      BT_SINK_BIN_RECORD_FORMAT_RAW, stem_name);
+  bt_song_play (render_song);
+  check_run_main_loop_until_eos_or_error (render_song);
+  bt_song_stop (render_song);
+  bt_machine_disable_stem (machine);
+
+  GST_INFO ("-- assert --");
+  ck_assert (res == TRUE);
+  GStatBuf mix_st, stem_st;
+  ck_assert_int_eq (g_stat (mix_name, &mix_st), 0);
+  ck_assert_int_eq (g_stat (stem_name, &stem_st), 0);
+  ck_assert_int_gt (mix_st.st_size, 0);
+  ck_assert_int_eq (stem_st.st_size, mix_st.st_size);
+
+  GST_INFO ("-- cleanup --");
+  g_unlink (mix_name);
+  g_unlink (stem_name);
+  g_free (mix_name);
+  g_free (stem_name);
+  gst_object_unref (sink_bin);
+  g_object_unref (master);
+  g_object_unref (machine);
+  g_object_unref (setup);
+  ck_g_object_final_unref (render_song);
+  BT_TEST_END;
+}
+END_TEST
+
 /* add pattern */
 START_TEST (test_bt_machine_add_pattern)
 {
@@ -549,6 +625,28 @@ START_TEST (test_bt_machine_pretty_name_with_detail)
 }
 END_TEST
 
+START_TEST (test_bt_machine_no_cpu_load_when_idle)
+{
+  BT_TEST_START;
+  GST_INFO ("-- arrange --");
+  BtMachineConstructorParams cparams;
+  cparams.id = "gen";
+  cparams.song = song;
+
+  BtMachine *src =
+      BT_MACHINE (bt_source_machine_new (&cparams, "audiotestsrc", 0L,
+          NULL));
+
+  GST_INFO ("-- act --");
+
+  GST_INFO ("-- assert --");
+  ck_assert_gobject_guint_eq (src, "cpu-load", 0);
+
+  GST_INFO ("-- cleanup --");
+  BT_TEST_END;
+}
+END_TEST
+
 START_TEST (test_bt_machine_set_defaults)
 {
   BT_TEST_START;
@@ -578,6 +676,54 @@ START_TEST (test_bt_machine_set_defaults)
 }
 END_TEST
 
+#if GST_CHECK_VERSION(1, 18, 0)
+START_TEST (test_bt_machine_audiomixer_follows_tempo)
+{
+  BT_TEST_START;
+  GST_INFO ("-- arrange --");
+  gchar *flags[] = { "audiomixer", NULL };
+  gchar *no_flags[] = { NULL };
+  bt_experiments_init (flags);
+  BtSongInfo *song_info =
+      BT_SONG_INFO (check_gobject_get_object_property (song, "song-info"));
+  BtMachine *sink =
+      (BtMachine *) check_gobject_get_object_property (song, "master");
+  BtMachineConstructorParams cparams;
+  cparams.song = song;
+  cparams.id = "gen1";
+  BtMachine *gen1 = BT_MACHINE (bt_source_machine_new (&cparams,
+          "audiotestsrc", 0L, NULL));
+  cparams.id = "gen2";
+  BtMachine *gen2 = BT_MACHINE (bt_source_machine_new (&cparams,
+          "audiotestsrc", 0L, NULL));
+  bt_wire_new (song, gen1, sink, NULL);
+  bt_wire_new (song, gen2, sink, NULL);
+  GstElement *mixer = get_machine_element_by_factory (sink, "audiomixer");
+  fail_unless (mixer != NULL, NULL);
+
+  GST_INFO ("-- act --");
+  g_object_set (song_info, "bpm", 150L, "tpb", 4L, NULL);
+
+  GST_INFO ("-- assert --");
+  GValue duration = G_VALUE_INIT;
+  g_value_init (&duration, GST_TYPE_FRACTION);
+  g_object_get_property (G_OBJECT (mixer), "output-buffer-duration-fraction",
+      &duration);
+  // one buffer per tick: 60 s / (150 * 4)
+  ck_assert_int_eq (gst_util_fraction_compare (
+          gst_value_get_fraction_numerator (&duration),
+          gst_value_get_fraction_denominator (&duration), 60, 600), 0);
+
+  GST_INFO ("-- cleanup --");
+  g_value_unset (&duration);
+  g_object_unref (sink);
+  g_object_unref (song_info);
+  bt_experiments_init (no_flags);
+  BT_TEST_END;
+}
+END_TEST
+#endif
+
 START_TEST (test_bt_machine_bind_parameter_control)
 {
   BT_TEST_START;
@@ -685,6 +831,7 @@ bt_machine_example_case (void)
   tcase_add_test (tc, test_bt_machine_enable_input_level2);
   tcase_add_test (tc, test_bt_machine_enable_input_gain1);
   tcase_add_test (tc, test_bt_machine_enable_output_gain1);
+  tcase_add_test (tc, test_bt_machine_enable_stem);
   tcase_add_test (tc, test_bt_machine_add_pattern);
   tcase_add_test (tc, test_bt_machine_rem_pattern);
   tcase_add_test (tc, test_bt_machine_unique_pattern_name);
@@ -697,7 +844,11 @@ bt_machine_example_case (void)
   tcase_add_test (tc, test_bt_machine_state_not_overridden);
   tcase_add_test (tc, test_bt_machine_pretty_name);
   tcase_add_test (tc, test_bt_machine_pretty_name_with_detail);
+  tcase_add_test (tc, test_bt_machine_no_cpu_load_when_idle);
   tcase_add_test (tc, test_bt_machine_set_defaults);
+#if GST_CHECK_VERSION(1, 18, 0)
+  tcase_add_test (tc, test_bt_machine_audiomixer_follows_tempo);
+#endif
   tcase_add_test (tc, test_bt_machine_bind_parameter_control);
   tcase_add_test (tc, test_bt_machine_unbind_parameter_control);
   tcase_add_test (tc, test_bt_machine_unbind_parameter_controls);
@@ -83,6 +83,27 @@ START_TEST (test_bt_parameter_group_param)
 }
 END_TEST
 
+START_TEST (test_bt_parameter_group_control_binding)
+{
+  BT_TEST_START;
+  GST_INFO ("-- arrange --");
+  BtParameterGroup *pg = get_mono_parameter_group ();
+  GObject *parent = bt_parameter_group_get_param_parent (pg, 1);
+
+  GST_INFO ("-- act --");
+  GstControlBinding *cb = bt_parameter_group_get_param_control_binding (pg, 1);
+
+  GST_INFO ("-- assert --");
+  GstControlBinding *ref_cb =
+      gst_object_get_control_binding ((GstObject *) parent, "g-double");
+  ck_assert (cb == ref_cb);
+
+  GST_INFO ("-- cleanup --");
+  gst_object_unref (ref_cb);
+  BT_TEST_END;
+}
+END_TEST
+
 START_TEST (test_bt_parameter_group_size)
 {
   BT_TEST_START;
@@ -281,6 +302,7 @@ bt_parameter_group_example_case (void)
   TCase *tc = tcase_create ("BtParameterGroupExamples");
 
   tcase_add_test (tc, test_bt_parameter_group_param);
+  tcase_add_test (tc, test_bt_parameter_group_control_binding);
   tcase_add_test (tc, test_bt_parameter_group_size);
   tcase_add_test (tc, test_bt_parameter_group_describe);
   tcase_add_test (tc, test_bt_parameter_group_get_trigger_param);
@@ -400,6 +400,277 @@ START_TEST (test_bt_pattern_control_source_combine_two_tracks)
 }
 END_TEST
 
+START_TEST (test_bt_pattern_control_source_compiled_value_unshadows)
+{
+  BT_TEST_START;
+  GST_INFO ("-- arrange --");
+  BtPattern *pattern1 = bt_pattern_new (song, "pattern1", 8L, machine);
+  BtPattern *pattern2 = bt_pattern_new (song, "pattern2", 8L, machine);
+  g_object_set (sequence, "length", 16L, "compiled", TRUE, NULL);
+  bt_sequence_add_track (sequence, machine, -1);
+  bt_sequence_set_pattern (sequence, 0, 0, (BtCmdPattern *) pattern1);
+  bt_sequence_set_pattern (sequence, 4, 0, (BtCmdPattern *) pattern2);
+  bt_pattern_set_global_event (pattern1, 0, 0, "50");
+  bt_pattern_set_global_event (pattern1, 4, 0, "100");
+  bt_pattern_set_global_event (pattern2, 0, 0, "200");  /* value shadows above */
+  gst_object_sync_values (element, G_GUINT64_CONSTANT (0) * tick_time);
+  gst_object_sync_values (element, G_GUINT64_CONSTANT (4) * tick_time);
+  ck_assert_gobject_guint_eq (element, "g-uint", 200);
+
+  GST_INFO ("-- act --");
+  bt_pattern_set_global_event (pattern2, 0, 0, NULL);
+  gst_object_sync_values (element, G_GUINT64_CONSTANT (0) * tick_time);
+  gst_object_sync_values (element, G_GUINT64_CONSTANT (4) * tick_time);
+
+  GST_INFO ("-- assert --");
+  ck_assert_gobject_guint_eq (element, "g-uint", 50);
+
+  GST_INFO ("-- cleanup --");
+  g_object_unref (pattern1);
+  g_object_unref (pattern2);
+  BT_TEST_END;
+}
+END_TEST
+
+START_TEST (test_bt_pattern_control_source_compiled_combine_two_tracks)
+{
+  BT_TEST_START;
+  GST_INFO ("-- arrange --");
+  BtPattern *pattern = bt_pattern_new (song, "pattern-name", 8L, machine);
+  g_object_set (sequence, "length", 4L, NULL);
+  bt_sequence_add_track (sequence, machine, -1);
+  bt_sequence_add_track (sequence, machine, -1);
+  bt_sequence_set_pattern (sequence, 0, 0, (BtCmdPattern *) pattern);
+  bt_sequence_set_pattern (sequence, 1, 1, (BtCmdPattern *) pattern);
+  bt_pattern_set_global_event (pattern, 0, 0, "50");
+  bt_pattern_set_global_event (pattern, 1, 0, "100");
+  g_object_set (sequence, "compiled", TRUE, NULL);
+  gst_object_sync_values (element, G_GUINT64_CONSTANT (0) * tick_time);
+  gst_object_sync_values (element, G_GUINT64_CONSTANT (1) * tick_time);
+  ck_assert_gobject_guint_eq (element, "g-uint", 50);
+
+  GST_INFO ("-- act --");
+  bt_sequence_set_pattern (sequence, 1, 1, NULL);
+  gst_object_sync_values (element, G_GUINT64_CONSTANT (1) * tick_time);
+
+  GST_INFO ("-- assert --");
+  ck_assert_gobject_guint_eq (element, "g-uint", 100);
+
+  GST_INFO ("-- cleanup --");
+  g_object_unref (pattern);
+  BT_TEST_END;
+}
+END_TEST
+
+START_TEST (test_bt_pattern_control_source_value_array_changes_on_tick)
+{
+  BT_TEST_START;
+  GST_INFO ("-- arrange --");
+  BtPattern *pattern = bt_pattern_new (song, "pattern-name", 8L, machine);
+  g_object_set (sequence, "length", 4L, NULL);
+  bt_sequence_add_track (sequence, machine, -1);
+  bt_sequence_set_pattern (sequence, 0, 0, (BtCmdPattern *) pattern);
+  bt_pattern_set_global_event (pattern, 0, 1, "1.0");
+  bt_pattern_set_global_event (pattern, 1, 1, "3.0");
+  GstControlBinding *cb = gst_object_get_control_binding (element, "g-double");
+  GstClockTime interval = tick_time / 4;
+  gdouble values[6];
+  gst_control_binding_get_value_array (cb, G_GUINT64_CONSTANT (0), interval, 2,
+      values);
+
+  GST_INFO ("-- act --");
+  /* the tick boundary is at the 3rd sample */
+  gboolean res = gst_control_binding_get_value_array (cb,
+      tick_time - 2 * interval, interval, 6, values);
+
+  GST_INFO ("-- assert --");
+  fail_unless (res, NULL);
+  ck_assert_float_eq (values[0], 1.0);
+  ck_assert_float_eq (values[1], 1.0);
+  ck_assert_float_eq (values[2], 3.0);
+  ck_assert_float_eq (values[5], 3.0);
+
+  GST_INFO ("-- cleanup --");
+  gst_object_unref (cb);
+  g_object_unref (pattern);
+  BT_TEST_END;
+}
+END_TEST
+
+START_TEST (test_bt_pattern_control_source_value_array_ramps)
+{
+  BT_TEST_START;
+  GST_INFO ("-- arrange --");
+  BtPattern *pattern = bt_pattern_new (song, "pattern-name", 8L, machine);
+  g_object_set (sequence, "length", 4L, NULL);
+  bt_sequence_add_track (sequence, machine, -1);
+  bt_sequence_set_pattern (sequence, 0, 0, (BtCmdPattern *) pattern);
+  bt_pattern_set_global_event (pattern, 0, 1, "1.0");
+  bt_pattern_set_global_event (pattern, 1, 1, "3.0");
+  GstControlBinding *cb = gst_object_get_control_binding (element, "g-double");
+  GstClockTime interval = tick_time / 4;
+  gdouble values[6];
+  g_object_set (cb, "ramp-time", 2 * interval, NULL);
+  gst_control_binding_get_value_array (cb, G_GUINT64_CONSTANT (0), interval, 2,
+      values);
+
+  GST_INFO ("-- act --");
+  gboolean res = gst_control_binding_get_value_array (cb,
+      tick_time - 2 * interval, interval, 6, values);
+
+  GST_INFO ("-- assert --");
+  fail_unless (res, NULL);
+  ck_assert_float_eq (values[1], 1.0);
+  ck_assert_float_eq (values[2], 1.0);
+  ck_assert_float_eq (values[3], 2.0);
+  ck_assert_float_eq (values[4], 3.0);
+  ck_assert_float_eq (values[5], 3.0);
+
+  GST_INFO ("-- cleanup --");
+  gst_object_unref (cb);
+  g_object_unref (pattern);
+  BT_TEST_END;
+}
+END_TEST
+
+START_TEST (test_bt_pattern_control_source_value_array_jumps_after_seek)
+{
+  BT_TEST_START;
+  GST_INFO ("-- arrange --");
+  BtPattern *pattern = bt_pattern_new (song, "pattern-name", 8L, machine);
+  g_object_set (sequence, "length", 4L, NULL);
+  bt_sequence_add_track (sequence, machine, -1);
+  bt_sequence_set_pattern (sequence, 0, 0, (BtCmdPattern *) pattern);
+  bt_pattern_set_global_event (pattern, 0, 1, "1.0");
+  bt_pattern_set_global_event (pattern, 1, 1, "3.0");
+  GstControlBinding *cb = gst_object_get_control_binding (element, "g-double");
+  GstClockTime interval = tick_time / 4;
+  gdouble values[2];
+  g_object_set (cb, "ramp-time", 2 * interval, NULL);
+  gst_control_binding_get_value_array (cb, G_GUINT64_CONSTANT (0), interval, 1,
+      values);
+
+  GST_INFO ("-- act --");
+  /* skip the samples before the tick, as a seek would */
+  gboolean res = gst_control_binding_get_value_array (cb, tick_time, interval,
+      2, values);
+
+  GST_INFO ("-- assert --");
+  fail_unless (res, NULL);
+  ck_assert_float_eq (values[0], 3.0);
+  ck_assert_float_eq (values[1], 3.0);
+
+  GST_INFO ("-- cleanup --");
+  gst_object_unref (cb);
+  g_object_unref (pattern);
+  BT_TEST_END;
+}
+END_TEST
+
+START_TEST (test_bt_pattern_control_source_value_array_follows_default)
+{
+  BT_TEST_START;
+  GST_INFO ("-- arrange --");
+  BtPattern *pattern = bt_pattern_new (song, "pattern-name", 8L, machine);
+  g_object_set (sequence, "length", 4L, NULL);
+  bt_sequence_add_track (sequence, machine, -1);
+  bt_sequence_set_pattern (sequence, 0, 0, (BtCmdPattern *) pattern);
+  glong ix = bt_parameter_group_get_param_index (pg, "g-double");
+  GstControlBinding *cb = gst_object_get_control_binding (element, "g-double");
+  GstClockTime interval = tick_time / 4;
+  gdouble values[2];
+  g_object_set (element, "g-double", 1.0, NULL);
+  bt_parameter_group_set_param_default (pg, ix);
+  gst_control_binding_get_value_array (cb, interval, interval, 1, values);
+
+  GST_INFO ("-- act --");
+  g_object_set (element, "g-double", 2.0, NULL);
+  bt_parameter_group_set_param_default (pg, ix);
+  gboolean res = gst_control_binding_get_value_array (cb, 2 * interval,
+      interval, 2, values);
+
+  GST_INFO ("-- assert --");
+  fail_unless (res, NULL);
+  ck_assert_float_eq (values[0], 2.0);
+  ck_assert_float_eq (values[1], 2.0);
+
+  GST_INFO ("-- cleanup --");
+  gst_object_unref (cb);
+  g_object_unref (pattern);
+  BT_TEST_END;
+}
+END_TEST
+
+/* at 44.1 kHz the interval is truncated, consecutive buffers are still
+ * contiguous and must hold the value within a tick */
+START_TEST (test_bt_pattern_control_source_value_array_holds_at_44100)
+{
+  BT_TEST_START;
+  GST_INFO ("-- arrange --");
+  BtPattern *pattern = bt_pattern_new (song, "pattern-name", 8L, machine);
+  g_object_set (sequence, "length", 4L, NULL);
+  bt_sequence_add_track (sequence, machine, -1);
+  bt_sequence_set_pattern (sequence, 0, 0, (BtCmdPattern *) pattern);
+  bt_pattern_set_global_event (pattern, 0, 1, "1.0");
+  GstControlBinding *cb = gst_object_get_control_binding (element, "g-double");
+  /* this is how GstVolume computes it */
+  GstClockTime interval = gst_util_uint64_scale_int (1, GST_SECOND, 44100);
+  gdouble values[1024];
+  g_object_set (cb, "ramp-time", 64 * interval, NULL);
+  gst_control_binding_get_value_array (cb, G_GUINT64_CONSTANT (0), interval,
+      1024, values);
+
+  GST_INFO ("-- act --");
+  gboolean res = gst_control_binding_get_value_array (cb,
+      gst_util_uint64_scale_int (1024, GST_SECOND, 44100), interval, 1024,
+      values);
+
+  GST_INFO ("-- assert --");
+  fail_unless (res, NULL);
+  ck_assert_float_eq (values[0], 1.0);
+  ck_assert_float_eq (values[1023], 1.0);
+
+  GST_INFO ("-- cleanup --");
+  gst_object_unref (cb);
+  g_object_unref (pattern);
+  BT_TEST_END;
+}
+END_TEST
+
+/* a seek into the middle of a tick keeps the last value */
+START_TEST (test_bt_pattern_control_source_value_array_holds_after_seek)
+{
+  BT_TEST_START;
+  GST_INFO ("-- arrange --");
+  BtPattern *pattern = bt_pattern_new (song, "pattern-name", 8L, machine);
+  g_object_set (sequence, "length", 4L, NULL);
+  bt_sequence_add_track (sequence, machine, -1);
+  bt_sequence_set_pattern (sequence, 0, 0, (BtCmdPattern *) pattern);
+  bt_pattern_set_global_event (pattern, 0, 1, "1.0");
+  bt_pattern_set_global_event (pattern, 2, 1, "3.0");
+  GstControlBinding *cb = gst_object_get_control_binding (element, "g-double");
+  GstClockTime interval = gst_util_uint64_scale_int (1, GST_SECOND, 44100);
+  gdouble values[2];
+  g_object_set (cb, "ramp-time", 64 * interval, NULL);
+  gst_control_binding_get_value_array (cb, G_GUINT64_CONSTANT (0), interval, 2,
+      values);
+
+  GST_INFO ("-- act --");
+  gboolean res = gst_control_binding_get_value_array (cb,
+      tick_time + tick_time / 2, interval, 2, values);
+
+  GST_INFO ("-- assert --");
+  fail_unless (res, NULL);
+  ck_assert_float_eq (values[0], 1.0);
+  ck_assert_float_eq (values[1], 1.0);
+
+  GST_INFO ("-- cleanup --");
+  gst_object_unref (cb);
+  g_object_unref (pattern);
+  BT_TEST_END;
+}
+END_TEST
+
 TCase *
 bt_pattern_control_source_example_case (void)
 {
@@ -423,6 +694,21 @@ bt_pattern_control_source_example_case (void)
   tcase_add_test (tc, test_bt_pattern_control_source_combine_pattern_unshadows);
   tcase_add_test (tc, test_bt_pattern_control_source_combine_value_unshadows);
   tcase_add_test (tc, test_bt_pattern_control_source_combine_two_tracks);
+  tcase_add_test (tc,
+      test_bt_pattern_control_source_compiled_value_unshadows);
+  tcase_add_test (tc,
+      test_bt_pattern_control_source_compiled_combine_two_tracks);
+  tcase_add_test (tc,
+      test_bt_pattern_control_source_value_array_changes_on_tick);
+  tcase_add_test (tc, test_bt_pattern_control_source_value_array_ramps);
+  tcase_add_test (tc,
+      test_bt_pattern_control_source_value_array_jumps_after_seek);
+  tcase_add_test (tc,
+      test_bt_pattern_control_source_value_array_follows_default);
+  tcase_add_test (tc,
+      test_bt_pattern_control_source_value_array_holds_at_44100);
+  tcase_add_test (tc,
+      test_bt_pattern_control_source_value_array_holds_after_seek);
   tcase_add_checked_fixture (tc, test_setup, test_teardown);
   tcase_add_unchecked_fixture (tc, case_setup, case_teardown);
   return tc;
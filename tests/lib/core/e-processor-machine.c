@@ -49,6 +49,37 @@ case_teardown (void)
 {
 }
 
+//-- helper
+
+static BtMachine *
+make_song_with_effect (const gchar * effect)
+{
+  BtSequence *sequence =
+      (BtSequence *) check_gobject_get_object_property (song, "sequence");
+  BtSongInfo *song_info =
+      BT_SONG_INFO (check_gobject_get_object_property (song, "song-info"));
+  BtMachineConstructorParams cparams;
+  cparams.song = song;
+  cparams.id = "master";
+  BtMachine *sink = BT_MACHINE (bt_sink_machine_new (&cparams, NULL));
+  cparams.id = "gen";
+  BtMachine *gen =
+      BT_MACHINE (bt_source_machine_new (&cparams, "simsyn", 0L, NULL));
+  cparams.id = "fx";
+  BtMachine *fx =
+      BT_MACHINE (bt_processor_machine_new (&cparams, effect, 0L, NULL));
+  bt_wire_new (song, gen, fx, NULL);
+  bt_wire_new (song, fx, sink, NULL);
+
+  /* no notes, simsyn only sends GAP buffers */
+  g_object_set (song_info, "bpm", 250L, "tpb", 16L, NULL);
+  g_object_set (sequence, "length", 32L, NULL);
+
+  g_object_unref (sequence);
+  g_object_unref (song_info);
+  return fx;
+}
+
 
 //-- tests
 
@@ -227,6 +258,46 @@ START_TEST (test_bt_processor_machine_ref)
 }
 END_TEST
 
+START_TEST (test_bt_processor_machine_skips_idle_effect)
+{
+  BT_TEST_START;
+  GST_INFO ("-- arrange --");
+  BtMachine *machine = make_song_with_effect ("audiodelay");
+
+  GST_INFO ("-- act --");
+  bt_song_play (song);
+  check_run_main_loop_until_playing_or_error (song);
+  check_run_main_loop_for_usec (G_USEC_PER_SEC / 5);
+  bt_song_stop (song);
+
+  GST_INFO ("-- assert --");
+  ck_assert_uint_gt (bt_machine_get_skipped_buffers (machine), 0);
+
+  GST_INFO ("-- cleanup --");
+  BT_TEST_END;
+}
+END_TEST
+
+START_TEST (test_bt_processor_machine_runs_other_effects)
+{
+  BT_TEST_START;
+  GST_INFO ("-- arrange --");
+  BtMachine *machine = make_song_with_effect ("volume");
+
+  GST_INFO ("-- act --");
+  bt_song_play (song);
+  check_run_main_loop_until_playing_or_error (song);
+  check_run_main_loop_for_usec (G_USEC_PER_SEC / 5);
+  bt_song_stop (song);
+
+  GST_INFO ("-- assert --");
+  ck_assert_uint_eq (bt_machine_get_skipped_buffers (machine), 0);
+
+  GST_INFO ("-- cleanup --");
+  BT_TEST_END;
+}
+END_TEST
+
 TCase *
 bt_processor_machine_example_case (void)
 {
@@ -239,6 +310,8 @@ bt_processor_machine_example_case (void)
   tcase_add_test (tc, test_bt_processor_machine_pattern_by_index);
   tcase_add_test (tc, test_bt_processor_machine_pattern_by_list);
   tcase_add_test (tc, test_bt_processor_machine_ref);
+  tcase_add_test (tc, test_bt_processor_machine_skips_idle_effect);
+  tcase_add_test (tc, test_bt_processor_machine_runs_other_effects);
   tcase_add_checked_fixture (tc, test_setup, test_teardown);
   tcase_add_unchecked_fixture (tc, case_setup, case_teardown);
   return tc;
@@ -23,6 +23,32 @@ static BtApplication *app;
 static BtSong *song;
 static GstClockTime tick_time;
 
+//-- helpers
+
+/* apply a fixed series of cell, label and row edits to the first rows of the
+ * sequence and return the number of index entries that were looked at */
+static gulong
+count_edit_visits (BtSequence * sequence, BtCmdPattern * pattern)
+{
+  const gulong start = bt_sequence_dbg_get_index_visits ();
+  GstToc *toc;
+  gint i;
+
+  for (i = 0; i < 100; i++) {
+    const gulong time = (i * 7) % 16;
+
+    bt_sequence_set_pattern (sequence, time, 0, (i & 1) ? pattern : NULL);
+    bt_sequence_set_label (sequence, time, (i & 1) ? "cue" : NULL);
+    g_object_get (sequence, "toc", &toc, NULL);
+    gst_toc_unref (toc);
+  }
+  bt_sequence_insert_rows (sequence, 0, 0, 1);
+  bt_sequence_delete_rows (sequence, 0, 0, 1);
+  bt_sequence_insert_rows (sequence, 0, -1, 1);
+  bt_sequence_delete_rows (sequence, 0, -1, 1);
+  return bt_sequence_dbg_get_index_visits () - start;
+}
+
 //-- fixtures
 
 static void
@@ -291,6 +317,81 @@ START_TEST (test_bt_sequence_get_tick_by_pattern)
 }
 END_TEST
 
+START_TEST (test_bt_sequence_get_playing_pattern)
+{
+  BT_TEST_START;
+  GST_INFO ("-- arrange --");
+  BtSequence *sequence =
+      BT_SEQUENCE (check_gobject_get_object_property (song, "sequence"));
+  BtMachineConstructorParams cparams;
+  cparams.song = song;
+  cparams.id = "gen";
+  
+  BtMachine *machine = BT_MACHINE (bt_source_machine_new (&cparams,
+          "buzztrax-test-mono-source", 0, NULL));
+  BtCmdPattern *p1 = (BtCmdPattern *) bt_pattern_new (song, "p1", 4L, machine);
+  BtCmdPattern *p2 = (BtCmdPattern *) bt_pattern_new (song, "p2", 4L, machine);
+  g_object_set (sequence, "length", 8L, NULL);
+  bt_sequence_add_track (sequence, machine, -1);
+  gulong start = 0;
+
+  GST_INFO ("-- act --");
+  bt_sequence_set_pattern (sequence, 1, 0, p1);
+  bt_sequence_set_pattern (sequence, 5, 0, p2);
+
+  GST_INFO ("-- assert --");
+  fail_unless (bt_sequence_get_playing_pattern (sequence, 0, 0, NULL) == NULL);
+  fail_unless (bt_sequence_get_playing_pattern (sequence, 4, 0, &start) == p1);
+  ck_assert_uint_eq (start, 1);
+  fail_unless (bt_sequence_get_playing_pattern (sequence, 7, 0, &start) == p2);
+  ck_assert_uint_eq (start, 5);
+
+  GST_INFO ("-- cleanup --");
+  g_object_try_unref (p1);
+  g_object_try_unref (p2);
+  g_object_try_unref (sequence);
+  BT_TEST_END;
+}
+END_TEST
+
+START_TEST (test_bt_sequence_get_playing_pattern_after_row_edits)
+{
+  BT_TEST_START;
+  GST_INFO ("-- arrange --");
+  BtSequence *sequence =
+      BT_SEQUENCE (check_gobject_get_object_property (song, "sequence"));
+  BtMachineConstructorParams cparams;
+  cparams.song = song;
+  cparams.id = "gen";
+  
+  BtMachine *machine = BT_MACHINE (bt_source_machine_new (&cparams,
+          "buzztrax-test-mono-source", 0, NULL));
+  BtCmdPattern *p1 = (BtCmdPattern *) bt_pattern_new (song, "p1", 4L, machine);
+  BtCmdPattern *p2 = (BtCmdPattern *) bt_pattern_new (song, "p2", 4L, machine);
+  g_object_set (sequence, "length", 16L, NULL);
+  bt_sequence_add_track (sequence, machine, -1);
+  bt_sequence_set_pattern (sequence, 0, 0, p1);
+  bt_sequence_set_pattern (sequence, 4, 0, p2);
+  gulong start = 0;
+
+  GST_INFO ("-- act --");
+  bt_sequence_insert_rows (sequence, 2, 0, 4);
+  bt_sequence_delete_rows (sequence, 1, 0, 1);
+
+  GST_INFO ("-- assert --");
+  fail_unless (bt_sequence_get_playing_pattern (sequence, 6, 0, &start) == p1);
+  ck_assert_uint_eq (start, 0);
+  fail_unless (bt_sequence_get_playing_pattern (sequence, 7, 0, &start) == p2);
+  ck_assert_uint_eq (start, 7);
+
+  GST_INFO ("-- cleanup --");
+  g_object_try_unref (p1);
+  g_object_try_unref (p2);
+  g_object_try_unref (sequence);
+  BT_TEST_END;
+}
+END_TEST
+
 START_TEST (test_bt_sequence_enlarge_length)
 {
   BT_TEST_START;
@@ -391,6 +492,36 @@ START_TEST (test_bt_sequence_shrink_length)
 }
 END_TEST
 
+START_TEST (test_bt_sequence_failed_enlarge_keeps_length)
+{
+  BT_TEST_START;
+  GST_INFO ("-- arrange --");
+  BtSequence *sequence =
+      BT_SEQUENCE (check_gobject_get_object_property (song, "sequence"));
+  BtMachineConstructorParams cparams;
+  cparams.song = song;
+  cparams.id = "gen";
+
+  BtMachine *machine = BT_MACHINE (bt_source_machine_new (&cparams,
+          "buzztrax-test-mono-source", 0, NULL));
+  bt_sequence_add_track (sequence, machine, -1);
+  g_object_set (sequence, "length", 8L, NULL);
+
+  GST_INFO ("-- act --");
+  // the size in bytes overflows, so that the allocation fails
+  gboolean res = bt_sequence_resize_data_length (sequence, G_MAXULONG / 2);
+
+  GST_INFO ("-- assert --");
+  fail_if (res);
+  ck_assert_gobject_gulong_eq (sequence, "len-patterns", 8L);
+  ck_assert_gobject_gulong_eq (sequence, "length", 8L);
+
+  GST_INFO ("-- cleanup --");
+  g_object_try_unref (sequence);
+  BT_TEST_END;
+}
+END_TEST
+
 START_TEST (test_bt_sequence_enlarge_track)
 {
   BT_TEST_START;
@@ -814,6 +945,51 @@ START_TEST (test_bt_sequence_insert_rows_shifts_out)
 }
 END_TEST
 
+START_TEST (test_bt_sequence_insert_rows_keeps_other_tracks)
+{
+  BT_TEST_START;
+  GST_INFO ("-- arrange --");
+  BtSequence *sequence =
+      BT_SEQUENCE (check_gobject_get_object_property (song, "sequence"));
+  g_object_set (sequence, "length", 16L, NULL);
+  BtMachineConstructorParams cparams;
+  cparams.song = song;
+  cparams.id = "gen";
+
+  BtMachine *gen = BT_MACHINE (bt_source_machine_new (&cparams,
+      "audiotestsrc", 0L, NULL));
+  cparams.id = "master";
+  BtMachine *sink = BT_MACHINE (bt_sink_machine_new (&cparams, NULL));
+  bt_wire_new (song, gen, sink, NULL);
+  BtCmdPattern *pattern =
+      (BtCmdPattern *) bt_pattern_new (song, "melo", 8L, gen);
+  bt_sequence_add_track (sequence, gen, -1);
+  bt_sequence_add_track (sequence, gen, -1);
+  bt_sequence_add_track (sequence, gen, -1);
+  bt_sequence_set_pattern (sequence, 4, 0, pattern);
+  bt_sequence_set_pattern (sequence, 4, 1, pattern);
+  bt_sequence_set_pattern (sequence, 4, 2, pattern);
+
+  GST_INFO ("-- act --");
+  bt_sequence_insert_rows (sequence, 2, 1, 4);
+
+  GST_INFO ("-- assert --");
+  ck_assert_gobject_eq_and_unref (bt_sequence_get_pattern (sequence, 4, 0),
+      pattern);
+  ck_assert_gobject_eq_and_unref (bt_sequence_get_pattern (sequence, 8, 1),
+      pattern);
+  fail_unless (bt_sequence_get_pattern (sequence, 4, 1) == NULL);
+  ck_assert_gobject_eq_and_unref (bt_sequence_get_pattern (sequence, 4, 2),
+      pattern);
+  fail_unless (bt_sequence_get_pattern (sequence, 8, 2) == NULL);
+
+  GST_INFO ("-- cleanup --");
+  g_object_unref (pattern);
+  g_object_unref (sequence);
+  BT_TEST_END;
+}
+END_TEST
+
 START_TEST (test_bt_sequence_insert_full_rows)
 {
   BT_TEST_START;
@@ -856,6 +1032,30 @@ START_TEST (test_bt_sequence_insert_full_rows)
 }
 END_TEST
 
+START_TEST (test_bt_sequence_insert_full_rows_keeps_labels)
+{
+  BT_TEST_START;
+  GST_INFO ("-- arrange --");
+  BtSequence *sequence =
+      BT_SEQUENCE (check_gobject_get_object_property (song, "sequence"));
+  g_object_set (sequence, "length", 8L, NULL);
+  bt_sequence_set_label (sequence, 2, "intro");
+  bt_sequence_set_label (sequence, 7, "outro");
+
+  GST_INFO ("-- act --");
+  bt_sequence_insert_full_rows (sequence, 0, 2);
+
+  GST_INFO ("-- assert --");
+  ck_assert_str_eq_and_free (bt_sequence_get_label (sequence, 2), NULL);
+  ck_assert_str_eq_and_free (bt_sequence_get_label (sequence, 4), "intro");
+  ck_assert_str_eq_and_free (bt_sequence_get_label (sequence, 9), "outro");
+
+  GST_INFO ("-- cleanup --");
+  g_object_unref (sequence);
+  BT_TEST_END;
+}
+END_TEST
+
 START_TEST (test_bt_sequence_delete_rows)
 {
   BT_TEST_START;
@@ -936,6 +1136,43 @@ START_TEST (test_bt_sequence_delete_full_rows)
 END_TEST
 
 
+START_TEST (test_bt_sequence_edit_cost_is_flat)
+{
+  BT_TEST_START;
+  GST_INFO ("-- arrange --");
+  BtSequence *sequence =
+      BT_SEQUENCE (check_gobject_get_object_property (song, "sequence"));
+  BtMachineConstructorParams cparams;
+  cparams.song = song;
+  cparams.id = "gen";
+  BtMachine *gen = BT_MACHINE (bt_source_machine_new (&cparams,
+          "audiotestsrc", 0L, NULL));
+  cparams.id = "master";
+  BtMachine *sink = BT_MACHINE (bt_sink_machine_new (&cparams, NULL));
+  bt_wire_new (song, gen, sink, NULL);
+  BtCmdPattern *pattern =
+      (BtCmdPattern *) bt_pattern_new (song, "melo", 8L, gen);
+  g_object_set (sequence, "length", 64L, NULL);
+  bt_sequence_add_track (sequence, gen, -1);
+  const gulong visits_small = count_edit_visits (sequence, pattern);
+
+  GST_INFO ("-- act --");
+  g_object_set (sequence, "length", 256L * 1024L, NULL);
+  const gulong visits_large = count_edit_visits (sequence, pattern);
+
+  GST_INFO ("-- assert --");
+  GST_INFO ("edit cost: %lu visits for 64 rows, %lu visits for 256k rows",
+      visits_small, visits_large);
+  ck_assert_int_gt (visits_small, 0);
+  ck_assert_int_eq (visits_large, visits_small);
+
+  GST_INFO ("-- cleanup --");
+  g_object_unref (pattern);
+  g_object_unref (sequence);
+  BT_TEST_END;
+}
+END_TEST
+
 START_TEST (test_bt_sequence_duration)
 {
   BT_TEST_START;
@@ -1032,10 +1269,13 @@ bt_sequence_example_case (void)
   tcase_add_test (tc, test_bt_sequence_move_track_right);
   tcase_add_test (tc, test_bt_sequence_pattern);
   tcase_add_test (tc, test_bt_sequence_get_tick_by_pattern);
+  tcase_add_test (tc, test_bt_sequence_get_playing_pattern);
+  tcase_add_test (tc, test_bt_sequence_get_playing_pattern_after_row_edits);
   tcase_add_test (tc, test_bt_sequence_enlarge_length);
   tcase_add_test (tc, test_bt_sequence_enlarge_length_check_labels);
   tcase_add_test (tc, test_bt_sequence_enlarge_length_labels);
   tcase_add_test (tc, test_bt_sequence_shrink_length);
+  tcase_add_test (tc, test_bt_sequence_failed_enlarge_keeps_length);
   tcase_add_test (tc, test_bt_sequence_enlarge_track);
   tcase_add_test (tc, test_bt_sequence_enlarge_track_vals);
   tcase_add_test (tc, test_bt_sequence_shrink_track);
@@ -1052,9 +1292,12 @@ bt_sequence_example_case (void)
   tcase_add_test (tc, test_bt_sequence_shortening_length_disables_loop);
   tcase_add_test (tc, test_bt_sequence_insert_rows);
   tcase_add_test (tc, test_bt_sequence_insert_rows_shifts_out);
+  tcase_add_test (tc, test_bt_sequence_insert_rows_keeps_other_tracks);
   tcase_add_test (tc, test_bt_sequence_insert_full_rows);
+  tcase_add_test (tc, test_bt_sequence_insert_full_rows_keeps_labels);
   tcase_add_test (tc, test_bt_sequence_delete_rows);
   tcase_add_test (tc, test_bt_sequence_delete_full_rows);
+  tcase_add_test (tc, test_bt_sequence_edit_cost_is_flat);
   tcase_add_test (tc, test_bt_sequence_duration);
   tcase_add_test (tc, test_bt_sequence_duration_play);
   tcase_add_checked_fixture (tc, test_setup, test_teardown);
@@ -86,6 +86,45 @@ START_TEST (test_bt_settings_get_audiosink1)
 }
 END_TEST
 
+START_TEST (test_bt_settings_no_realtime_by_default)
+{
+  BT_TEST_START;
+  GST_INFO ("-- arrange --");
+  BtSettings *settings = bt_settings_make ();
+
+  GST_INFO ("-- act --");
+
+  GST_INFO ("-- assert --");
+  ck_assert_gobject_str_eq (settings, "realtime-policy", "none");
+  ck_assert_gobject_str_eq (settings, "cpu-affinity", "");
+
+  GST_INFO ("-- cleanup --");
+  g_object_unref (settings);
+  BT_TEST_END;
+}
+END_TEST
+
+START_TEST (test_bt_settings_encoder_defaults)
+{
+  BT_TEST_START;
+  GST_INFO ("-- arrange --");
+  BtSettings *settings = bt_settings_make ();
+  gint quality;
+
+  GST_INFO ("-- act --");
+  g_object_get (settings, "record-quality", &quality, NULL);
+
+  GST_INFO ("-- assert --");
+  ck_assert_int_eq (quality, -1);
+  ck_assert_gobject_guint_eq (settings, "record-bitrate", 0);
+  ck_assert_gobject_guint_eq (settings, "record-threads", 0);
+
+  GST_INFO ("-- cleanup --");
+  g_object_unref (settings);
+  BT_TEST_END;
+}
+END_TEST
+
 START_TEST (test_bt_settings_ic_playback_spec)
 {
   BT_TEST_START;
@@ -114,6 +153,8 @@ bt_settings_example_case (void)
 
   tcase_add_test (tc, test_bt_settings_singleton);
   tcase_add_test (tc, test_bt_settings_get_audiosink1);
+  tcase_add_test (tc, test_bt_settings_no_realtime_by_default);
+  tcase_add_test (tc, test_bt_settings_encoder_defaults);
   tcase_add_test (tc, test_bt_settings_ic_playback_spec);
   tcase_add_checked_fixture (tc, test_setup, test_teardown);
   tcase_add_unchecked_fixture (tc, case_setup, case_teardown);
@@ -176,6 +176,38 @@ START_TEST (test_bt_setup_wire_add_machine_id)
 }
 END_TEST
 
+START_TEST (test_bt_setup_update_batch_defers_linking)
+{
+  BT_TEST_START;
+  GST_INFO ("-- arrange --");
+  BtSetup *setup = BT_SETUP (check_gobject_get_object_property (song, "setup"));
+  BtMachineConstructorParams cparams;
+  cparams.id = "src";
+  cparams.song = song;
+
+  BtMachine *source = BT_MACHINE (bt_source_machine_new (&cparams,
+          "buzztrax-test-mono-source", 0, NULL));
+
+  cparams.id = "sink";
+  BtMachine *sink = BT_MACHINE (bt_sink_machine_new (&cparams, NULL));
+
+  GST_INFO ("-- act --");
+  bt_setup_begin_update (setup);
+  BtWire *wire = bt_wire_new (song, source, sink, NULL);
+  gboolean linked_in_batch = (GST_OBJECT_PARENT (wire) != NULL);
+  bt_setup_commit_update (setup);
+
+  GST_INFO ("-- assert --");
+  fail_if (linked_in_batch);
+  fail_unless (GST_OBJECT_PARENT (wire) != NULL);
+  fail_unless (GST_OBJECT_PARENT (source) != NULL);
+
+  GST_INFO ("-- cleanup --");
+  g_object_unref (setup);
+  BT_TEST_END;
+}
+END_TEST
+
 START_TEST (test_bt_setup_wire_rem_machine_id)
 {
   BT_TEST_START;
@@ -605,6 +637,7 @@ bt_setup_example_case (void)
   tcase_add_test (tc, test_bt_setup_machine_add_updates_list);
   tcase_add_test (tc, test_bt_setup_wire_add_machine_id);
   tcase_add_test (tc, test_bt_setup_wire_rem_machine_id);
+  tcase_add_test (tc, test_bt_setup_update_batch_defers_linking);
   tcase_add_test (tc, test_bt_setup_wire_add_src_list);
   tcase_add_test (tc, test_bt_setup_wire_add_dst_list);
   tcase_add_test (tc, test_bt_setup_machine_type);
@@ -17,6 +17,7 @@
 
 #include "m-bt-core.h"
 #include <glib/gstdio.h>
+#include <gst/pbutils/encoding-target.h>
 
 //-- globals
 
@@ -335,6 +336,69 @@ run_main_loop_until_eos (void)
   g_source_remove (update_id);
 }
 
+static gchar *
+get_format_cache_path (void)
+{
+  return g_build_filename (g_get_user_cache_dir (), PACKAGE,
+      "record-formats.ini", NULL);
+}
+
+static void
+write_format_cache (const gchar * stamp, gboolean wav_works)
+{
+  GKeyFile *cache = g_key_file_new ();
+  gchar *cache_name = get_format_cache_path ();
+  gchar *cache_dir = g_path_get_dirname (cache_name);
+  gchar *cache_data;
+  gsize cache_size;
+
+  g_key_file_set_string (cache, "record-formats", "stamp", stamp);
+  g_key_file_set_boolean (cache, "record-formats", "wav", wav_works);
+  cache_data = g_key_file_to_data (cache, &cache_size, NULL);
+  g_mkdir_with_parents (cache_dir, 0755);
+  fail_unless (g_file_set_contents (cache_name, cache_data, cache_size, NULL));
+
+  g_free (cache_data);
+  g_free (cache_dir);
+  g_free (cache_name);
+  g_key_file_free (cache);
+}
+
+static gchar *
+make_encoding_target (GstEncodingProfile * profile)
+{
+  gchar *target_dir = g_dir_make_tmp ("bt-targets-XXXXXX", NULL);
+  gchar *target_name = g_build_filename (target_dir,
+      GST_ENCODING_CATEGORY_STORAGE_EDITING, "buzztrax.gep", NULL);
+  gchar *category_dir = g_path_get_dirname (target_name);
+  GstEncodingTarget *target = gst_encoding_target_new ("buzztrax",
+      GST_ENCODING_CATEGORY_STORAGE_EDITING, "test target", NULL);
+
+  gst_encoding_target_add_profile (target, profile);
+  g_mkdir_with_parents (category_dir, 0755);
+  fail_unless (gst_encoding_target_save_to_file (target, target_name, NULL));
+
+  g_object_unref (target);
+  g_free (category_dir);
+  g_free (target_name);
+  return target_dir;
+}
+
+static void
+remove_encoding_target (gchar * target_dir)
+{
+  gchar *target_name = g_build_filename (target_dir,
+      GST_ENCODING_CATEGORY_STORAGE_EDITING, "buzztrax.gep", NULL);
+  gchar *category_dir = g_path_get_dirname (target_name);
+
+  g_remove (target_name);
+  g_rmdir (category_dir);
+  g_rmdir (target_dir);
+  g_free (category_dir);
+  g_free (target_name);
+  g_free (target_dir);
+}
+
 //-- tests
 
 START_TEST (test_bt_sink_bin_new)
@@ -526,6 +590,154 @@ START_TEST (test_bt_sink_bin_analyzers)
 }
 END_TEST
 
+/* an external encoding target replaces the built-in profile */
+START_TEST (test_bt_sink_bin_record_external_profile)
+{
+  BT_TEST_START;
+  GST_INFO ("-- arrange --");
+  GstCaps *caps = gst_caps_from_string ("audio/x-wav");
+  GstEncodingContainerProfile *c_profile =
+      gst_encoding_container_profile_new ("ogg-vorbis", NULL, caps, NULL);
+  gst_caps_unref (caps);
+  caps = gst_caps_from_string ("audio/x-raw, format=(string)S16LE");
+  gst_encoding_container_profile_add_profile (c_profile,
+      (GstEncodingProfile *) gst_encoding_audio_profile_new (caps, NULL, NULL,
+          1));
+  gst_caps_unref (caps);
+  // the target is loaded once per process, tests run in their own process
+  gchar *target_dir = make_encoding_target ((GstEncodingProfile *) c_profile);
+  g_setenv ("GST_ENCODING_TARGET_PATH", target_dir, TRUE);
+  make_new_song ( /*silence */ 4);
+  GstElement *sink_bin = get_sink_bin ();
+  gchar *filename = make_tmp_song_path ("record", "_external.wav");
+  g_object_set (sink_bin,
+      "mode", BT_SINK_BIN_MODE_RECORD,
+      "record-format", BT_SINK_BIN_RECORD_FORMAT_OGG_VORBIS,
+      "record-file-name", filename, NULL);
+
+  GST_INFO ("-- act --");
+  bt_song_play (song);
+  run_main_loop_until_eos ();
+  bt_song_stop (song);
+  g_object_set (sink_bin, "mode", BT_SINK_BIN_MODE_PLAY, NULL);
+
+  GST_INFO ("-- assert --");
+  fail_unless (g_file_test (filename, G_FILE_TEST_IS_REGULAR));
+  ck_assert_str_eq_and_free (get_media_type (filename), "audio/x-wav");
+
+  GST_INFO ("-- cleanup --");
+  g_unsetenv ("GST_ENCODING_TARGET_PATH");
+  remove_encoding_target (target_dir);
+  g_remove (filename);
+  g_free (filename);
+  gst_object_unref (sink_bin);
+  BT_TEST_END;
+}
+END_TEST
+
+/* probe results are taken from the cache if the stamp matches */
+START_TEST (test_bt_sink_bin_format_cache_is_used)
+{
+  BT_TEST_START;
+  GST_INFO ("-- arrange --");
+  gchar *stamp = bt_sink_bin_get_format_cache_stamp ();
+  write_format_cache (stamp, FALSE);
+
+  GST_INFO ("-- act --");
+  gboolean supported =
+      bt_sink_bin_is_record_format_supported (BT_SINK_BIN_RECORD_FORMAT_WAV);
+
+  GST_INFO ("-- assert --");
+  fail_if (supported);
+
+  GST_INFO ("-- cleanup --");
+  gchar *cache_name = get_format_cache_path ();
+  g_remove (cache_name);
+  g_free (cache_name);
+  g_free (stamp);
+  BT_TEST_END;
+}
+END_TEST
+
+/* a stale cache is probed again and rewritten */
+START_TEST (test_bt_sink_bin_format_cache_is_refreshed)
+{
+  BT_TEST_START;
+  GST_INFO ("-- arrange --");
+  gchar *stamp = bt_sink_bin_get_format_cache_stamp ();
+  gchar *cache_name = get_format_cache_path ();
+  GKeyFile *cache = g_key_file_new ();
+  write_format_cache ("0.0.0.0/stale", FALSE);
+
+  GST_INFO ("-- act --");
+  gboolean supported =
+      bt_sink_bin_is_record_format_supported (BT_SINK_BIN_RECORD_FORMAT_WAV);
+
+  GST_INFO ("-- assert --");
+  fail_unless (supported);
+  fail_unless (g_key_file_load_from_file (cache, cache_name, G_KEY_FILE_NONE,
+          NULL));
+  ck_assert_str_eq_and_free (g_key_file_get_string (cache, "record-formats",
+          "stamp", NULL), stamp);
+  fail_unless (g_key_file_get_boolean (cache, "record-formats", "wav", NULL));
+
+  GST_INFO ("-- cleanup --");
+  g_key_file_free (cache);
+  g_remove (cache_name);
+  g_free (cache_name);
+  g_free (stamp);
+  BT_TEST_END;
+}
+END_TEST
+
+/* encoders get the quality and bitrate from the settings */
+START_TEST (test_bt_sink_bin_configure_encoder)
+{
+  BT_TEST_START;
+  GST_INFO ("-- arrange --");
+  GstElement *encoder = gst_element_factory_make ("vorbisenc", NULL);
+  if (!encoder)
+    return;
+  g_object_set (settings, "record-quality", 100, "record-bitrate", 128, NULL);
+
+  GST_INFO ("-- act --");
+  bt_sink_bin_configure_encoder (encoder);
+
+  GST_INFO ("-- assert --");
+  gfloat quality;
+  gint bitrate;
+  g_object_get (encoder, "quality", &quality, "bitrate", &bitrate, NULL);
+  ck_assert_float_eq (quality, 1.0);
+  ck_assert_int_eq (bitrate, 128000);
+
+  GST_INFO ("-- cleanup --");
+  g_object_set (settings, "record-quality", -1, "record-bitrate", 0, NULL);
+  gst_object_unref (encoder);
+  BT_TEST_END;
+}
+END_TEST
+
+START_TEST (test_bt_sink_bin_record_format_streamable)
+{
+  BT_TEST_START;
+  GST_INFO ("-- arrange --");
+
+  GST_INFO ("-- act --");
+  gboolean wav =
+      bt_sink_bin_is_record_format_streamable (BT_SINK_BIN_RECORD_FORMAT_WAV);
+  gboolean mp4 =
+      bt_sink_bin_is_record_format_streamable
+      (BT_SINK_BIN_RECORD_FORMAT_MP4_AAC);
+
+  GST_INFO ("-- assert --");
+  fail_unless (wav);
+  fail_if (mp4);
+
+  GST_INFO ("-- cleanup --");
+  BT_TEST_END;
+}
+END_TEST
+
 TCase *
 bt_sink_bin_example_case (void)
 {
@@ -538,6 +750,11 @@ bt_sink_bin_example_case (void)
       BT_SINK_BIN_RECORD_FORMAT_COUNT);
   tcase_add_loop_test (tc, test_bt_sink_bin_master_volume, 1, 3);
   tcase_add_test (tc, test_bt_sink_bin_analyzers);
+  tcase_add_test (tc, test_bt_sink_bin_record_external_profile);
+  tcase_add_test (tc, test_bt_sink_bin_format_cache_is_used);
+  tcase_add_test (tc, test_bt_sink_bin_format_cache_is_refreshed);
+  tcase_add_test (tc, test_bt_sink_bin_configure_encoder);
+  tcase_add_test (tc, test_bt_sink_bin_record_format_streamable);
   tcase_add_checked_fixture (tc, test_setup, test_teardown);
   tcase_add_unchecked_fixture (tc, case_setup, case_teardown);
   return tc;
@@ -16,6 +16,7 @@
  */
 
 #include "m-bt-core.h"
+#include <gst/base/gstbasesink.h>
 
 //-- globals
 
@@ -105,6 +106,74 @@ on_song_is_playing_notify (const BtSong * song, GParamSpec * arg,
   GST_INFO ("got signal");
 }
 
+// helper method to check the running-time continuity at the sink
+typedef struct
+{
+  GstSegment segment;
+  GstClockTime next_running_time;
+  guint segments;
+  guint gaps;
+} BtTestTimestampMonitor;
+
+static GstPadProbeReturn
+on_sink_data (GstPad * pad, GstPadProbeInfo * info, gpointer user_data)
+{
+  BtTestTimestampMonitor *m = (BtTestTimestampMonitor *) user_data;
+
+  if (info->type & GST_PAD_PROBE_TYPE_EVENT_DOWNSTREAM) {
+    GstEvent *event = GST_PAD_PROBE_INFO_EVENT (info);
+
+    if (GST_EVENT_TYPE (event) == GST_EVENT_SEGMENT) {
+      gst_event_copy_segment (event, &m->segment);
+      m->segments++;
+    }
+  } else if (info->type & GST_PAD_PROBE_TYPE_BUFFER) {
+    GstBuffer *buf = GST_PAD_PROBE_INFO_BUFFER (info);
+    GstClockTime rt = gst_segment_to_running_time (&m->segment,
+        GST_FORMAT_TIME, GST_BUFFER_TIMESTAMP (buf));
+
+    // allow for one sample of rounding
+    if (GST_CLOCK_TIME_IS_VALID (m->next_running_time) &&
+        GST_CLOCK_TIME_IS_VALID (rt) &&
+        GST_CLOCK_DIFF (m->next_running_time, rt) > GST_SECOND / 44100) {
+      GST_WARNING ("gap in running time: %" GST_TIME_FORMAT " != %"
+          GST_TIME_FORMAT, GST_TIME_ARGS (rt),
+          GST_TIME_ARGS (m->next_running_time));
+      m->gaps++;
+    }
+    if (GST_CLOCK_TIME_IS_VALID (rt) &&
+        GST_BUFFER_DURATION_IS_VALID (buf)) {
+      m->next_running_time = rt + GST_BUFFER_DURATION (buf);
+    }
+  }
+  return GST_PAD_PROBE_OK;
+}
+
+// helper method to make a part of the pipeline use some cpu time
+static GstPadProbeReturn
+on_busy_data (GstPad * pad, GstPadProbeInfo * info, gpointer user_data)
+{
+  gint64 end = g_get_monotonic_time () + 2000;
+
+  while (g_get_monotonic_time () < end);
+  return GST_PAD_PROBE_OK;
+}
+
+static GstPad *
+get_wire_gain_src_pad (BtWire * wire)
+{
+  GList *node;
+
+  for (node = GST_BIN_CHILDREN (wire); node; node = g_list_next (node)) {
+    GstElementFactory *factory = gst_element_get_factory (node->data);
+
+    if (factory && !strcmp (GST_OBJECT_NAME (factory), "volume")) {
+      return gst_element_get_static_pad (node->data, "src");
+    }
+  }
+  return NULL;
+}
+
 //-- tests
 
 // test if the default constructor works as expected
@@ -653,6 +722,90 @@ START_TEST (test_bt_song_play_loop)
 }
 END_TEST
 
+/* the loop seek must not depend on the main-loop, we keep it blocked for
+ * a few loops and check that the sink gets a new segment for each loop */
+START_TEST (test_bt_song_play_loop_is_seamless)
+{
+  BT_TEST_START;
+  GST_INFO ("-- arrange --");
+  BtSong *song = make_new_song ();
+  BtSequence *sequence =
+      (BtSequence *) check_gobject_get_object_property (song, "sequence");
+  BtMachine *master =
+      (BtMachine *) check_gobject_get_object_property (song, "master");
+  GstElement *sink_bin =
+      (GstElement *) check_gobject_get_object_property (master, "machine");
+  GstPad *pad = gst_element_get_static_pad (sink_bin, "sink");
+  BtTestTimestampMonitor m = { {0,}, GST_CLOCK_TIME_NONE, 0, 0 };
+  gst_segment_init (&m.segment, GST_FORMAT_TIME);
+  gst_pad_add_probe (pad,
+      GST_PAD_PROBE_TYPE_BUFFER | GST_PAD_PROBE_TYPE_EVENT_DOWNSTREAM,
+      on_sink_data, &m, NULL);
+  g_object_set (sequence, "loop", TRUE, NULL);
+  bt_song_play (song);
+  check_run_main_loop_until_playing_or_error (song);
+  const guint segments = m.segments;
+
+  GST_INFO ("-- act --");
+  // the loop is 0.48 s long, don't run the main-loop for 4 loops
+  g_usleep (4 * 480 * 1000);
+  const guint loops = m.segments - segments;
+  bt_song_stop (song);
+
+  GST_INFO ("-- assert --");
+  ck_assert_uint_ge (loops, 2);
+  ck_assert_int_eq (m.gaps, 0);
+
+  GST_INFO ("-- cleanup --");
+  gst_object_unref (pad);
+  gst_object_unref (sink_bin);
+  g_object_unref (master);
+  g_object_unref (sequence);
+  ck_g_object_final_unref (song);
+  BT_TEST_END;
+}
+END_TEST
+
+START_TEST (test_bt_song_play_accounts_cpu_load)
+{
+  BT_TEST_START;
+  GST_INFO ("-- arrange --");
+  BtSong *song = make_new_song ();
+  BtSetup *setup =
+      (BtSetup *) check_gobject_get_object_property (song, "setup");
+  BtMachine *gen = bt_setup_get_machine_by_id (setup, "gen");
+  BtWire *wire = bt_setup_get_wire_by_src_machine (setup, gen);
+  GstElement *element =
+      (GstElement *) check_gobject_get_object_property (gen, "machine");
+  GstPad *gen_pad = gst_element_get_static_pad (element, "src");
+  GstPad *wire_pad = get_wire_gain_src_pad (wire);
+  gst_pad_add_probe (gen_pad, GST_PAD_PROBE_TYPE_BUFFER, on_busy_data, NULL,
+      NULL);
+  gst_pad_add_probe (wire_pad, GST_PAD_PROBE_TYPE_BUFFER, on_busy_data, NULL,
+      NULL);
+
+  GST_INFO ("-- act --");
+  bt_song_play (song);
+  check_run_main_loop_until_playing_or_error (song);
+  check_run_main_loop_for_usec (G_USEC_PER_SEC / 5);
+
+  GST_INFO ("-- assert --");
+  ck_assert_gobject_guint_gt (gen, "cpu-load", 0);
+  ck_assert_gobject_guint_gt (wire, "cpu-load", 0);
+
+  GST_INFO ("-- cleanup --");
+  bt_song_stop (song);
+  gst_object_unref (wire_pad);
+  gst_object_unref (gen_pad);
+  gst_object_unref (element);
+  g_object_unref (wire);
+  g_object_unref (gen);
+  g_object_unref (setup);
+  ck_g_object_final_unref (song);
+  BT_TEST_END;
+}
+END_TEST
+
 START_TEST (test_bt_song_persistence)
 {
   BT_TEST_START;
@@ -707,6 +860,58 @@ START_TEST (test_bt_song_tempo_update_set_context)
 END_TEST
 
 
+// stopping keeps the compiled schedule for the next playback
+START_TEST (test_bt_song_stop_keeps_compiled_sequence)
+{
+  BT_TEST_START;
+  GST_INFO ("-- arrange --");
+  BtSong *song = make_new_song ();
+  BtSequence *sequence =
+      BT_SEQUENCE (check_gobject_get_object_property (song, "sequence"));
+  g_object_set (sequence, "compiled", TRUE, NULL);
+  bt_song_play (song);
+  check_run_main_loop_until_playing_or_error (song);
+
+  GST_INFO ("-- act --");
+  bt_song_stop (song);
+  check_run_main_loop_for_usec (G_USEC_PER_SEC / 10);
+
+  GST_INFO ("-- assert --");
+  ck_assert_gobject_gboolean_eq (sequence, "compiled", TRUE);
+
+  GST_INFO ("-- cleanup --");
+  g_object_unref (sequence);
+  ck_g_object_final_unref (song);
+  BT_TEST_END;
+}
+END_TEST
+
+// changing the machines drops the compiled schedule while stopped
+START_TEST (test_bt_song_setup_change_invalidates_compiled_sequence)
+{
+  BT_TEST_START;
+  GST_INFO ("-- arrange --");
+  BtSong *song = make_new_song ();
+  BtSequence *sequence =
+      BT_SEQUENCE (check_gobject_get_object_property (song, "sequence"));
+  BtMachineConstructorParams cparams;
+  cparams.song = song;
+  cparams.id = "gen2";
+  g_object_set (sequence, "compiled", TRUE, NULL);
+
+  GST_INFO ("-- act --");
+  bt_source_machine_new (&cparams, "buzztrax-test-mono-source", 0L, NULL);
+
+  GST_INFO ("-- assert --");
+  ck_assert_gobject_gboolean_eq (sequence, "compiled", FALSE);
+
+  GST_INFO ("-- cleanup --");
+  g_object_unref (sequence);
+  ck_g_object_final_unref (song);
+  BT_TEST_END;
+}
+END_TEST
+
 
 /* should we have variants, where we remove the machines instead of the wires? */
 TCase *
@@ -731,8 +936,12 @@ bt_song_example_case (void)
   tcase_add_test (tc, test_bt_song_play_pos_after_initial_seek);
   tcase_add_test (tc, test_bt_song_play_again_should_restart);
   tcase_add_test (tc, test_bt_song_play_loop);
+  tcase_add_test (tc, test_bt_song_play_loop_is_seamless);
+  tcase_add_test (tc, test_bt_song_play_accounts_cpu_load);
   tcase_add_test (tc, test_bt_song_persistence);
   tcase_add_test (tc, test_bt_song_tempo_update_set_context);
+  tcase_add_test (tc, test_bt_song_stop_keeps_compiled_sequence);
+  tcase_add_test (tc, test_bt_song_setup_change_invalidates_compiled_sequence);
   tcase_add_checked_fixture (tc, test_setup, test_teardown);
   tcase_add_unchecked_fixture (tc, case_setup, case_teardown);
   return tc;
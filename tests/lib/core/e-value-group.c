@@ -58,6 +58,19 @@ case_teardown (void)
 
 //-- helper
 
+static void
+on_group_changed (BtValueGroup * vg, BtParameterGroup * pg,
+    gboolean intermediate, gpointer user_data)
+{
+  gulong *region = (gulong *) user_data;
+
+  if (!intermediate) {
+    region[0]++;
+    bt_value_group_get_changed_region (vg, &region[1], &region[2], &region[3],
+        &region[4]);
+  }
+}
+
 static BtValueGroup *
 get_mono_value_group (void)
 {
@@ -105,6 +118,57 @@ START_TEST (test_bt_value_group_value)
 }
 END_TEST
 
+START_TEST (test_bt_value_group_event_value)
+{
+  BT_TEST_START;
+  GST_INFO ("-- arrange --");
+  BtValueGroup *vg = get_mono_value_group ();
+  GValue v = G_VALUE_INIT;
+  bt_value_group_set_event (vg, 1, 0, "10");
+
+  GST_INFO ("-- act --");
+  gboolean res0 = bt_value_group_get_event_value (vg, 0, 0, &v);
+  gboolean res1 = bt_value_group_get_event_value (vg, 1, 0, &v);
+
+  GST_INFO ("-- assert --");
+  ck_assert (!res0);
+  ck_assert (res1);
+  ck_assert_uint_eq (g_value_get_uint (&v), 10);
+
+  GST_INFO ("-- cleanup --");
+  g_value_unset (&v);
+  BT_TEST_END;
+}
+END_TEST
+
+START_TEST (test_bt_value_group_batch)
+{
+  BT_TEST_START;
+  GST_INFO ("-- arrange --");
+  BtValueGroup *vg = get_mono_value_group ();
+  gulong region[5] = { 0, };
+  g_signal_connect (vg, "group-changed", G_CALLBACK (on_group_changed),
+      region);
+
+  GST_INFO ("-- act --");
+  bt_value_group_begin_batch (vg);
+  bt_value_group_set_event (vg, 1, 0, "10");
+  bt_value_group_set_event (vg, 3, 0, "20");
+  bt_value_group_end_batch (vg);
+
+  GST_INFO ("-- assert --");
+  ck_assert_uint_eq (region[0], 1);
+  ck_assert_uint_eq (region[1], 1);
+  ck_assert_uint_eq (region[2], 3);
+  ck_assert_uint_eq (region[3], 0);
+  ck_assert_uint_eq (region[4], 0);
+  ck_assert (!bt_value_group_get_changed_region (vg, NULL, NULL, NULL, NULL));
+
+  GST_INFO ("-- cleanup --");
+  BT_TEST_END;
+}
+END_TEST
+
 START_TEST (test_bt_value_group_insert_row)
 {
   BT_TEST_START;
@@ -362,6 +426,88 @@ START_TEST (test_bt_value_group_copy)
 }
 END_TEST
 
+START_TEST (test_bt_value_group_value_after_clear)
+{
+  BT_TEST_START;
+  GST_INFO ("-- arrange --");
+  BtValueGroup *vg = get_mono_value_group ();
+  bt_value_group_set_event (vg, 0, 0, "10");
+  bt_value_group_transform_colums (vg, BT_VALUE_GROUP_OP_CLEAR, 0, 3);
+
+  GST_INFO ("-- act --");
+  bt_value_group_set_event (vg, 1, 0, "20");
+
+  GST_INFO ("-- assert --");
+  ck_assert_str_eq_and_free (bt_value_group_get_event (vg, 0, 0), NULL);
+  ck_assert_str_eq_and_free (bt_value_group_get_event (vg, 1, 0), "20");
+
+  GST_INFO ("-- cleanup --");
+  BT_TEST_END;
+}
+END_TEST
+
+START_TEST (test_bt_value_group_value_after_unset)
+{
+  BT_TEST_START;
+  GST_INFO ("-- arrange --");
+  BtValueGroup *vg = get_mono_value_group ();
+  bt_value_group_set_event (vg, 0, 0, "10");
+  bt_value_group_set_event (vg, 0, 0, NULL);
+
+  GST_INFO ("-- act --");
+  bt_value_group_set_event (vg, 1, 0, "20");
+  bt_value_group_delete_row (vg, 0, 0);
+
+  GST_INFO ("-- assert --");
+  ck_assert_str_eq_and_free (bt_value_group_get_event (vg, 0, 0), "20");
+  ck_assert_str_eq_and_free (bt_value_group_get_event (vg, 1, 0), NULL);
+
+  GST_INFO ("-- cleanup --");
+  BT_TEST_END;
+}
+END_TEST
+
+START_TEST (test_bt_value_group_event_data_follows_cell)
+{
+  BT_TEST_START;
+  GST_INFO ("-- arrange --");
+  BtValueGroup *vg = get_mono_value_group ();
+  bt_value_group_set_event (vg, 0, 0, "10");
+  bt_value_group_set_event (vg, 1, 0, "20");
+  GValue *v0 = bt_value_group_get_event_data (vg, 0, 0);
+  GValue *v1 = bt_value_group_get_event_data (vg, 1, 0);
+
+  GST_INFO ("-- act --");
+  bt_value_group_set_event (vg, 0, 0, "30");
+
+  GST_INFO ("-- assert --");
+  ck_assert_uint_eq (g_value_get_uint (v0), 30);
+  ck_assert_uint_eq (g_value_get_uint (v1), 20);
+
+  GST_INFO ("-- cleanup --");
+  BT_TEST_END;
+}
+END_TEST
+
+START_TEST (test_bt_value_group_serialize_empty)
+{
+  BT_TEST_START;
+  GST_INFO ("-- arrange --");
+  BtValueGroup *vg = get_mono_value_group ();
+  GString *data = g_string_new (NULL);
+
+  GST_INFO ("-- act --");
+  bt_value_group_serialize_column (vg, 0, 1, 0, data);
+
+  GST_INFO ("-- assert --");
+  ck_assert_str_eq (data->str, "guint, , \n");
+
+  GST_INFO ("-- cleanup --");
+  g_string_free (data, TRUE);
+  BT_TEST_END;
+}
+END_TEST
+
 TCase *
 bt_value_group_example_case (void)
 {
@@ -369,6 +515,8 @@ bt_value_group_example_case (void)
 
   tcase_add_test (tc, test_bt_value_group_default_empty);
   tcase_add_test (tc, test_bt_value_group_value);
+  tcase_add_test (tc, test_bt_value_group_event_value);
+  tcase_add_test (tc, test_bt_value_group_batch);
   tcase_add_test (tc, test_bt_value_group_insert_row);
   tcase_add_test (tc, test_bt_value_group_delete_row);
   tcase_add_test (tc, test_bt_value_group_clear_column);
@@ -381,6 +529,10 @@ bt_value_group_example_case (void)
   tcase_add_test (tc, test_bt_value_group_transpose_fine_up_column);
   tcase_add_test (tc, test_bt_value_group_transpose_fine_down_column);
   tcase_add_test (tc, test_bt_value_group_copy);
+  tcase_add_test (tc, test_bt_value_group_value_after_clear);
+  tcase_add_test (tc, test_bt_value_group_value_after_unset);
+  tcase_add_test (tc, test_bt_value_group_event_data_follows_cell);
+  tcase_add_test (tc, test_bt_value_group_serialize_empty);
   tcase_add_checked_fixture (tc, test_setup, test_teardown);
   tcase_add_unchecked_fixture (tc, case_setup, case_teardown);
   return tc;
@@ -22,6 +22,24 @@
 static BtApplication *app;
 static BtSong *song;
 
+//-- helpers
+
+static gboolean
+wire_has_queue (BtWire * wire)
+{
+  GList *node, *list = bt_wire_get_element_list (wire);
+  gboolean res = FALSE;
+
+  for (node = list; node; node = g_list_next (node)) {
+    GstElementFactory *f = gst_element_get_factory (GST_ELEMENT (node->data));
+    if (!strcmp (GST_OBJECT_NAME (f), "queue")) {
+      res = TRUE;
+    }
+  }
+  g_list_free (list);
+  return res;
+}
+
 //-- fixtures
 
 static void
@@ -185,6 +203,127 @@ START_TEST (test_bt_wire_persistence)
 }
 END_TEST
 
+START_TEST (test_bt_wire_queue_on_demand)
+{
+  BT_TEST_START;
+  GST_INFO ("-- arrange --");
+  BtMachineConstructorParams cparams;
+  cparams.song = song;
+  cparams.id = "gen";
+  BtMachine *gen =
+      BT_MACHINE (bt_source_machine_new (&cparams, "audiotestsrc", 0L,
+          NULL));
+  cparams.id = "volume";
+  BtMachine *proc = BT_MACHINE (bt_processor_machine_new (&cparams,
+          "volume", 0L, NULL));
+  cparams.id = "master";
+  BtMachine *sink = BT_MACHINE (bt_sink_machine_new (&cparams, NULL));
+  BtWire *wire1 = bt_wire_new (song, gen, sink, NULL);
+  ck_assert (!wire_has_queue (wire1));
+
+  GST_INFO ("-- act --");
+  BtWire *wire2 = bt_wire_new (song, gen, proc, NULL);
+
+  GST_INFO ("-- assert --");
+  ck_assert (wire_has_queue (wire1));
+  ck_assert (wire_has_queue (wire2));
+
+  GST_INFO ("-- cleanup --");
+  BT_TEST_END;
+}
+END_TEST
+
+START_TEST (test_bt_wire_queue_removed_with_sibling)
+{
+  BT_TEST_START;
+  GST_INFO ("-- arrange --");
+  BtSetup *setup =
+      (BtSetup *) check_gobject_get_object_property (song, "setup");
+  BtMachineConstructorParams cparams;
+  cparams.song = song;
+  cparams.id = "gen";
+  BtMachine *gen =
+      BT_MACHINE (bt_source_machine_new (&cparams, "audiotestsrc", 0L,
+          NULL));
+  cparams.id = "volume";
+  BtMachine *proc = BT_MACHINE (bt_processor_machine_new (&cparams,
+          "volume", 0L, NULL));
+  cparams.id = "master";
+  BtMachine *sink = BT_MACHINE (bt_sink_machine_new (&cparams, NULL));
+  BtWire *wire1 = bt_wire_new (song, gen, sink, NULL);
+  BtWire *wire2 = bt_wire_new (song, gen, proc, NULL);
+  ck_assert (wire_has_queue (wire1));
+
+  GST_INFO ("-- act --");
+  bt_setup_remove_wire (setup, wire2);
+
+  GST_INFO ("-- assert --");
+  ck_assert (!wire_has_queue (wire1));
+
+  GST_INFO ("-- cleanup --");
+  g_object_unref (setup);
+  BT_TEST_END;
+}
+END_TEST
+
+START_TEST (test_bt_wire_parallel_adds_queues)
+{
+  BT_TEST_START;
+  GST_INFO ("-- arrange --");
+  BtMachineConstructorParams cparams;
+  cparams.song = song;
+  cparams.id = "gen";
+  BtMachine *gen =
+      BT_MACHINE (bt_source_machine_new (&cparams, "audiotestsrc", 0L,
+          NULL));
+  cparams.id = "volume";
+  BtMachine *proc = BT_MACHINE (bt_processor_machine_new (&cparams,
+          "volume", 0L, NULL));
+  cparams.id = "master";
+  BtMachine *sink = BT_MACHINE (bt_sink_machine_new (&cparams, NULL));
+  BtWire *wire1 = bt_wire_new (song, gen, proc, NULL);
+  BtWire *wire2 = bt_wire_new (song, proc, sink, NULL);
+
+  GST_INFO ("-- act --");
+  g_object_set (song, "parallel", TRUE, NULL);
+
+  GST_INFO ("-- assert --");
+  ck_assert (wire_has_queue (wire1));
+  ck_assert (wire_has_queue (wire2));
+
+  GST_INFO ("-- cleanup --");
+  BT_TEST_END;
+}
+END_TEST
+
+START_TEST (test_bt_wire_parallel_off_removes_queues)
+{
+  BT_TEST_START;
+  GST_INFO ("-- arrange --");
+  BtMachineConstructorParams cparams;
+  cparams.song = song;
+  cparams.id = "gen";
+  BtMachine *gen =
+      BT_MACHINE (bt_source_machine_new (&cparams, "audiotestsrc", 0L,
+          NULL));
+  cparams.id = "master";
+  BtMachine *sink = BT_MACHINE (bt_sink_machine_new (&cparams, NULL));
+  g_object_set (song, "parallel", TRUE, NULL);
+  BtWire *wire = bt_wire_new (song, gen, sink, NULL);
+  ck_assert (wire_has_queue (wire));
+
+  GST_INFO ("-- act --");
+  g_object_set (song, "parallel", FALSE, NULL);
+
+  GST_INFO ("-- assert --");
+  ck_assert (!wire_has_queue (wire));
+
+  GST_INFO ("-- cleanup --");
+  BT_TEST_END;
+}
+END_TEST
+
+
 
 TCase *
 bt_wire_example_case (void)
@@ -196,6 +335,10 @@ bt_wire_example_case (void)
   tcase_add_test (tc, test_bt_wire_pretty_name);
   tcase_add_test (tc, test_bt_wire_pretty_name_gets_updated);
   tcase_add_test (tc, test_bt_wire_persistence);
+  tcase_add_test (tc, test_bt_wire_queue_on_demand);
+  tcase_add_test (tc, test_bt_wire_queue_removed_with_sibling);
+  tcase_add_test (tc, test_bt_wire_parallel_adds_queues);
+  tcase_add_test (tc, test_bt_wire_parallel_off_removes_queues);
   tcase_add_checked_fixture (tc, test_setup, test_teardown);
   tcase_add_unchecked_fixture (tc, case_setup, case_teardown);
   return tc;
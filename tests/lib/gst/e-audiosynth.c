@@ -245,8 +245,8 @@ START_TEST (test_audio_context_configures_buffer_size)
 
   GST_INFO ("-- assert --");
   BufferFields *bf = get_buffer_info (e, 0);
-  // sizeof(gint16) * (int)(0.5 + (44100 * (60.0 / 8)) / (120 * 4))
-  ck_assert_uint_eq (bf->size, 1378);
+  // sizeof(gfloat) * (int)(0.5 + (44100 * (60.0 / 8)) / (120 * 4))
+  ck_assert_uint_eq (bf->size, 2756);
 
   GST_INFO ("-- cleanup --");
   gst_element_set_state (p, GST_STATE_NULL);
@@ -61,7 +61,7 @@ END_TEST
 START_TEST (test_combine_modes)
 {
   BT_TEST_START;
-  gint16 data1[WAVE_SIZE], data2[WAVE_SIZE];
+  gfloat data1[WAVE_SIZE], data2[WAVE_SIZE];
 
   GST_INFO ("-- arrange --");
   GstBtCombine *mix = gstbt_combine_new ();
@@ -81,7 +81,7 @@ START_TEST (test_combine_modes)
   GST_INFO ("-- plot --");
   GEnumClass *enum_class = g_type_class_peek_static (GSTBT_TYPE_COMBINE_TYPE);
   GEnumValue *enum_value = g_enum_get_value (enum_class, _i);
-  check_plot_data_int16 (data1, WAVE_SIZE, "combine", enum_value->value_name);
+  check_plot_data_float (data1, WAVE_SIZE, "combine", enum_value->value_name);
 
   GST_INFO ("-- cleanup --");
   gst_object_unref (osc1);
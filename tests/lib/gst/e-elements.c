@@ -48,6 +48,16 @@ get_message_type (GstBus * bus)
   return message_type;
 }
 
+static void
+count_gap_buffers (GstElement * sink, GstBuffer * buffer, GstPad * pad,
+    gpointer user_data)
+{
+  guint *gap_buffers = (guint *) user_data;
+
+  if (GST_BUFFER_FLAG_IS_SET (buffer, GST_BUFFER_FLAG_GAP))
+    (*gap_buffers)++;
+}
+
 //-- tests
 
 static gchar *bt_dec_pipelines[] = {
@@ -166,6 +176,39 @@ START_TEST (test_launch_elements)
 }
 END_TEST
 
+START_TEST (test_effect_keeps_silence)
+{
+  BT_TEST_START;
+  GST_INFO ("-- arrange --");
+  GstElement *pipeline = gst_parse_launch ("audiotestsrc num-buffers=10 "
+      "wave=silence ! audiodelay ! fakesink name=sink sync=false "
+      "signal-handoffs=true", NULL);
+  GstElement *sink = gst_bin_get_by_name (GST_BIN (pipeline), "sink");
+  GstBus *bus = gst_element_get_bus (pipeline);
+  guint gap_buffers = 0;
+  g_signal_connect (sink, "handoff", G_CALLBACK (count_gap_buffers),
+      &gap_buffers);
+
+  GST_INFO ("-- act --");
+  gst_element_set_state (pipeline, GST_STATE_PLAYING);
+  GstMessage *message = gst_bus_timed_pop_filtered (bus, GST_SECOND,
+      GST_MESSAGE_EOS | GST_MESSAGE_ERROR);
+
+  GST_INFO ("-- assert --");
+  ck_assert (message != NULL);
+  ck_assert_int_eq (GST_MESSAGE_TYPE (message), GST_MESSAGE_EOS);
+  ck_assert_uint_eq (gap_buffers, 10);
+
+  GST_INFO ("-- cleanup --");
+  gst_message_unref (message);
+  gst_object_unref (bus);
+  gst_element_set_state (pipeline, GST_STATE_NULL);
+  gst_object_unref (sink);
+  gst_object_unref (pipeline);
+  BT_TEST_END;
+}
+END_TEST
+
 // TODO(ensonic): test with level that all synths produce data
 // TODO(ensonic): if the synth supports presets, test all presets
 
@@ -178,6 +221,7 @@ gst_buzztrax_elements_example_case (void)
       G_N_ELEMENTS (bt_dec_pipelines) * G_N_ELEMENTS (bt_dec_files));
   tcase_add_loop_test (tc, test_launch_elements, 0,
       G_N_ELEMENTS (launch_pipelines));
+  tcase_add_test (tc, test_effect_keeps_silence);
   tcase_add_unchecked_fixture (tc, case_setup, case_teardown);
   return tc;
 }
@@ -71,7 +71,7 @@ START_TEST (test_filter)
   GstFFTF64Complex ffres[WAVE_SIZE];
   const guint nfft = 2 * WAVE_SIZE - 2;
   const gdouble nfft2 = (gdouble) nfft * (gdouble) nfft;
-  gint16 data[nfft];
+  gfloat data[nfft];
   gdouble fdata[nfft];
   gint j;
   gchar name[40];
@@ -91,17 +91,14 @@ START_TEST (test_filter)
   g_object_set (filter, "filter", filter_mode, "cut-off", 0.5, "resonance",
       resonance, NULL);
   // unit impulse (delta function)
-  memset (data, 0, nfft * sizeof (gint16));
-  data[0] = G_MAXINT16;
+  memset (data, 0, nfft * sizeof (gfloat));
+  data[0] = 1.0;
 
   GST_INFO ("-- act --");
   gstbt_filter_svf_process (filter, nfft, data);
   // test filter response using fft on filtered data
   for (j = 0; j < nfft; j++) {
-    fdata[j] =
-        (data[j] >
-        0) ? ((gdouble) data[j] / (gdouble) G_MAXINT16) : ((gdouble) data[j] /
-        (gdouble) - G_MININT16);
+    fdata[j] = (gdouble) data[j];
   }
   fft = gst_fft_f64_new (nfft, FALSE);
   // when using actual window function we get mangled curves
@@ -62,7 +62,7 @@ START_TEST (test_waves_not_silent)
 {
   BT_TEST_START;
   GstBtOscSynth *osc;
-  gint16 data[WAVE_SIZE];
+  gfloat data[WAVE_SIZE];
 
   GST_INFO ("-- arrange --");
   osc = gstbt_osc_synth_new ();
@@ -77,7 +77,7 @@ START_TEST (test_waves_not_silent)
   GST_INFO ("-- plot --");
   GEnumClass *enum_class = g_type_class_peek_static (GSTBT_TYPE_OSC_SYNTH_WAVE);
   GEnumValue *enum_value = g_enum_get_value (enum_class, _i);
-  check_plot_data_int16 (data, WAVE_SIZE, "osc-synth", enum_value->value_name);
+  check_plot_data_float (data, WAVE_SIZE, "osc-synth", enum_value->value_name);
 
   GST_INFO ("-- assert --");
   if (_i != GSTBT_OSC_SYNTH_WAVE_SILENCE) {
@@ -161,7 +161,7 @@ START_TEST (test_osc_wave_create_mono)
 {
   BT_TEST_START;
   GstBtOscWave *osc;
-  gint16 data[WAVE_SIZE];
+  gfloat data[WAVE_SIZE];
   gpointer wave_callbacks[] = { NULL, get_mono_wave_buffer };
 
   GST_INFO ("-- arrange --");
@@ -172,10 +172,10 @@ START_TEST (test_osc_wave_create_mono)
   osc->process (osc, 0, WAVE_SIZE, data);
 
   GST_INFO ("-- assert --");
-  ck_assert_int_eq (data[0], G_MININT16);
-  ck_assert_int_eq (data[1], -1);
-  ck_assert_int_eq (data[2], 1);
-  ck_assert_int_eq (data[3], G_MAXINT16);
+  ck_assert_float_eq (data[0], -1.0f);
+  ck_assert_float_eq (data[1], -1.0f / 32768.0f);
+  ck_assert_float_eq (data[2], 1.0f / 32768.0f);
+  ck_assert_float_eq (data[3], 32767.0f / 32768.0f);
 
   GST_INFO ("-- cleanup --");
   ck_gst_object_final_unref (osc);
@@ -187,7 +187,7 @@ START_TEST (test_osc_wave_create_stereo)
 {
   BT_TEST_START;
   GstBtOscWave *osc;
-  gint16 data[WAVE_SIZE];
+  gfloat data[WAVE_SIZE];
   gpointer wave_callbacks[] = { NULL, get_stereo_wave_buffer };
 
   GST_INFO ("-- arrange --");
@@ -198,10 +198,10 @@ START_TEST (test_osc_wave_create_stereo)
   osc->process (osc, 0, WAVE_SIZE / 2, data);
 
   GST_INFO ("-- assert --");
-  ck_assert_int_eq (data[0], G_MININT16);
-  ck_assert_int_eq (data[1], -1);
-  ck_assert_int_eq (data[2], 1);
-  ck_assert_int_eq (data[3], G_MAXINT16);
+  ck_assert_float_eq (data[0], -1.0f);
+  ck_assert_float_eq (data[1], -1.0f / 32768.0f);
+  ck_assert_float_eq (data[2], 1.0f / 32768.0f);
+  ck_assert_float_eq (data[3], 32767.0f / 32768.0f);
 
   GST_INFO ("-- cleanup --");
   ck_gst_object_final_unref (osc);
@@ -213,7 +213,7 @@ START_TEST (test_osc_wave_create_mono_beyond_size)
 {
   BT_TEST_START;
   GstBtOscWave *osc;
-  gint16 data[WAVE_SIZE];
+  gfloat data[WAVE_SIZE];
   gpointer wave_callbacks[] = { NULL, get_mono_wave_buffer };
   gint i;
 
@@ -226,7 +226,7 @@ START_TEST (test_osc_wave_create_mono_beyond_size)
 
   GST_INFO ("-- assert --");
   for (i = 0; i < WAVE_SIZE; i++)
-    ck_assert_int_eq (data[i], 0);
+    ck_assert_float_eq (data[i], 0.0f);
 
   GST_INFO ("-- cleanup --");
   ck_gst_object_final_unref (osc);
@@ -238,7 +238,7 @@ START_TEST (test_osc_wave_create_stereo_beyond_size)
 {
   BT_TEST_START;
   GstBtOscWave *osc;
-  gint16 data[WAVE_SIZE];
+  gfloat data[WAVE_SIZE];
   gpointer wave_callbacks[] = { NULL, get_stereo_wave_buffer };
   gint i;
 
@@ -251,7 +251,7 @@ START_TEST (test_osc_wave_create_stereo_beyond_size)
 
   GST_INFO ("-- assert --");
   for (i = 0; i < WAVE_SIZE; i++)
-    ck_assert_int_eq (data[i], 0);
+    ck_assert_float_eq (data[i], 0.0f);
 
   GST_INFO ("-- cleanup --");
   ck_gst_object_final_unref (osc);
@@ -16,6 +16,8 @@
  */
 
 #include <glib/gstdio.h>
+#include <string.h>
+#include <unistd.h>
 
 #include "m-bt-cmd.h"
 
@@ -177,6 +179,191 @@ START_TEST (test_bt_cmd_application_info_for_incomplete_file)
 }
 END_TEST
 
+START_TEST (test_bt_cmd_application_render_batch)
+{
+  BT_TEST_START;
+  GST_INFO ("-- arrange --");
+  BtCmdApplication *app = bt_cmd_application_new (TRUE);
+  gchar *out_dir = g_dir_make_tmp ("bt-render-batch-XXXXXX", NULL);
+  gchar *list_file_name = g_build_filename (out_dir, "songs.txt", NULL);
+  gchar *contents = g_strdup_printf ("%s\n",
+      check_get_test_song_path ("test-simple1.xml"));
+  gchar *contents2 = g_strdup_printf ("%s%s\n", contents,
+      check_get_test_song_path ("test-simple2.xml"));
+  g_file_set_contents (list_file_name, contents2, -1, NULL);
+  gchar *out1 = g_build_filename (out_dir, "test-simple1.raw", NULL);
+  gchar *out2 = g_build_filename (out_dir, "test-simple2.raw", NULL);
+
+  GST_INFO ("-- act --");
+  gboolean ret = bt_cmd_application_render_batch (app, list_file_name,
+      out_dir, BT_SINK_BIN_RECORD_FORMAT_RAW, 2);
+
+  GST_INFO ("-- assert --");
+  ck_assert (ret == TRUE);
+  ck_assert (g_file_test (out1, G_FILE_TEST_IS_REGULAR));
+  ck_assert (g_file_test (out2, G_FILE_TEST_IS_REGULAR));
+
+  GST_INFO ("-- cleanup --");
+  g_unlink (out1);
+  g_unlink (out2);
+  g_unlink (list_file_name);
+  g_rmdir (out_dir);
+  g_free (out1);
+  g_free (out2);
+  g_free (contents);
+  g_free (contents2);
+  g_free (list_file_name);
+  g_free (out_dir);
+  ck_g_object_final_unref (app);
+  BT_TEST_END;
+}
+END_TEST
+
+START_TEST (test_bt_cmd_application_render_batch_same_names)
+{
+  BT_TEST_START;
+  GST_INFO ("-- arrange --");
+  BtCmdApplication *app = bt_cmd_application_new (TRUE);
+  gchar *out_dir = g_dir_make_tmp ("bt-render-batch-XXXXXX", NULL);
+  gchar *list_file_name = g_build_filename (out_dir, "songs.txt", NULL);
+  gchar *contents = g_strdup_printf ("%s\n%s\n",
+      check_get_test_song_path ("test-simple1.xml"),
+      check_get_test_song_path ("test-simple1.xml"));
+  g_file_set_contents (list_file_name, contents, -1, NULL);
+  gchar *out1 = g_build_filename (out_dir, "test-simple1.raw", NULL);
+  gchar *out2 = g_build_filename (out_dir, "test-simple1-1.raw", NULL);
+
+  GST_INFO ("-- act --");
+  gboolean ret = bt_cmd_application_render_batch (app, list_file_name,
+      out_dir, BT_SINK_BIN_RECORD_FORMAT_RAW, 2);
+
+  GST_INFO ("-- assert --");
+  ck_assert (ret == TRUE);
+  ck_assert (g_file_test (out1, G_FILE_TEST_IS_REGULAR));
+  ck_assert (g_file_test (out2, G_FILE_TEST_IS_REGULAR));
+
+  GST_INFO ("-- cleanup --");
+  g_unlink (out1);
+  g_unlink (out2);
+  g_unlink (list_file_name);
+  g_rmdir (out_dir);
+  g_free (out1);
+  g_free (out2);
+  g_free (contents);
+  g_free (list_file_name);
+  g_free (out_dir);
+  ck_g_object_final_unref (app);
+  BT_TEST_END;
+}
+END_TEST
+
+START_TEST (test_bt_cmd_application_encode_to_fd)
+{
+  BT_TEST_START;
+  GST_INFO ("-- arrange --");
+  BtCmdApplication *app = bt_cmd_application_new (TRUE);
+  gchar *out_file_name;
+  gint fd = g_file_open_tmp ("bt-encode-XXXXXX.raw", &out_file_name, NULL);
+  ck_assert_int_ge (fd, 0);
+  gchar *target = g_strdup_printf ("fd:%d", fd);
+  GStatBuf st;
+  g_object_set (app, "format", "raw", NULL);
+
+  GST_INFO ("-- act --");
+  gboolean ret = bt_cmd_application_encode (app,
+      check_get_test_song_path ("test-simple1.xml"), target);
+
+  GST_INFO ("-- assert --");
+  ck_assert (ret == TRUE);
+  ck_assert_int_eq (g_stat (out_file_name, &st), 0);
+  ck_assert_int_gt (st.st_size, 0);
+
+  GST_INFO ("-- cleanup --");
+  close (fd);
+  g_unlink (out_file_name);
+  g_free (out_file_name);
+  g_free (target);
+  ck_g_object_final_unref (app);
+  BT_TEST_END;
+}
+END_TEST
+
+START_TEST (test_bt_cmd_application_encode_to_fd_needs_streamable_format)
+{
+  BT_TEST_START;
+  GST_INFO ("-- arrange --");
+  BtCmdApplication *app = bt_cmd_application_new (TRUE);
+  gchar *out_file_name;
+  gint fd = g_file_open_tmp ("bt-encode-XXXXXX.m4a", &out_file_name, NULL);
+  ck_assert_int_ge (fd, 0);
+  gchar *target = g_strdup_printf ("fd:%d", fd);
+  g_object_set (app, "format", "mp4-aac", NULL);
+
+  GST_INFO ("-- act --");
+  gboolean ret = bt_cmd_application_encode (app,
+      check_get_test_song_path ("test-simple1.xml"), target);
+
+  GST_INFO ("-- assert --");
+  ck_assert (ret == FALSE);
+
+  GST_INFO ("-- cleanup --");
+  close (fd);
+  g_unlink (out_file_name);
+  g_free (out_file_name);
+  g_free (target);
+  ck_g_object_final_unref (app);
+  BT_TEST_END;
+}
+END_TEST
+
+/* test-simple1 is 16 ticks at 100 bpm and 8 tpb, that is 1.2 s */
+START_TEST (test_bt_cmd_application_encode_is_faster_than_realtime)
+{
+  BT_TEST_START;
+  GST_INFO ("-- arrange --");
+  BtCmdApplication *app = bt_cmd_application_new (FALSE);
+  gchar *out_file_name, *log_file_name, *log, *report;
+  gint out_fd = g_file_open_tmp ("bt-encode-XXXXXX.raw", &out_file_name, NULL);
+  gint log_fd = g_file_open_tmp ("bt-encode-XXXXXX.log", &log_file_name, NULL);
+  gint stdout_fd = dup (1);
+  gdouble secs = 0.0, speed = 0.0;
+  close (out_fd);
+  g_object_set (app, "format", "raw", NULL);
+  // capture the progress and the speed report
+  fflush (stdout);
+  dup2 (log_fd, 1);
+
+  GST_INFO ("-- act --");
+  gint64 start = g_get_monotonic_time ();
+  gboolean ret = bt_cmd_application_encode (app,
+      check_get_test_song_path ("test-simple1.xml"), out_file_name);
+  gint64 duration = g_get_monotonic_time () - start;
+  fflush (stdout);
+  dup2 (stdout_fd, 1);
+
+  GST_INFO ("-- assert --");
+  ck_assert (ret == TRUE);
+  ck_assert_int_lt (duration, (gint64) (1.2 * G_USEC_PER_SEC));
+  ck_assert (g_file_get_contents (log_file_name, &log, NULL, NULL));
+  ck_assert ((report = strstr (log, "rendered in ")) != NULL);
+  ck_assert_int_eq (sscanf (report, "rendered in %lf s, %lfx realtime", &secs,
+          &speed), 2);
+  ck_assert (secs > 0.0);
+  ck_assert (speed > 1.0);
+
+  GST_INFO ("-- cleanup --");
+  close (stdout_fd);
+  close (log_fd);
+  g_unlink (out_file_name);
+  g_unlink (log_file_name);
+  g_free (out_file_name);
+  g_free (log_file_name);
+  g_free (log);
+  ck_g_object_final_unref (app);
+  BT_TEST_END;
+}
+END_TEST
+
 TCase *
 bt_cmd_application_example_case (void)
 {
@@ -188,6 +375,12 @@ bt_cmd_application_example_case (void)
   tcase_add_test (tc, test_bt_cmd_application_play_incomplete_file);
   tcase_add_test (tc, test_bt_cmd_application_info);
   tcase_add_test (tc, test_bt_cmd_application_info_for_incomplete_file);
+  tcase_add_test (tc, test_bt_cmd_application_render_batch);
+  tcase_add_test (tc, test_bt_cmd_application_render_batch_same_names);
+  tcase_add_test (tc, test_bt_cmd_application_encode_to_fd);
+  tcase_add_test (tc,
+      test_bt_cmd_application_encode_to_fd_needs_streamable_format);
+  tcase_add_test (tc, test_bt_cmd_application_encode_is_faster_than_realtime);
   tcase_add_checked_fixture (tc, test_setup, test_teardown);
   tcase_add_unchecked_fixture (tc, case_setup, case_teardown);
   return tc;